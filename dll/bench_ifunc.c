@@ -0,0 +1,97 @@
+/*
+ * Cost of selecting libsum variant (see dynlib.c):
+ *   ifunc     libsum, resolved once by loader, called through PLT
+ *   pointer   &libsum kept in a variable (resolved function)
+ *   dispatch  libsum_dispatch, checks CPU on every call
+ * for short arrays (where a check per call shows) and long
+ * ones (where it does not).
+ *
+ * build (see build.sh):
+ * $ gcc -O2 -I../syntax -o bench_ifunc bench_ifunc.c
+ *       ../syntax/bench.c dynlib.so
+ * DYNLIB_SUM=scalar|avx2|avx512 selects variant of libsum.
+ */
+
+#include "bench.h"
+#include <stdio.h>
+/* for: fprintf */
+#include <stdlib.h>
+/* for: malloc, free */
+
+/* dynlib.so uses global of executable */
+int global = 100;
+extern int libsum( int const* array, size_t count );
+extern int libsum_dispatch( int const* array, size_t count );
+extern char const* libsum_variant( void );
+
+#define CALLS 1000
+
+struct sum_case {
+    int* array;
+    size_t count;
+};
+
+static void run_ifunc( void* ctx ) {
+    struct sum_case* c = ctx;
+    int i, v = 0;
+
+    for( i = 0; i < CALLS; i++ )
+        v += libsum( c->array, c->count );
+    bench_consume( (uint64_t)v );
+}
+
+static void run_pointer( void* ctx ) {
+    struct sum_case* c = ctx;
+    /* volatile: compiler must not turn it back into call of libsum */
+    int (* volatile sum)( int const*, size_t ) = libsum;
+    int (*fn)( int const*, size_t ) = sum;
+    int i, v = 0;
+
+    for( i = 0; i < CALLS; i++ )
+        v += fn( c->array, c->count );
+    bench_consume( (uint64_t)v );
+}
+
+static void run_dispatch( void* ctx ) {
+    struct sum_case* c = ctx;
+    int i, v = 0;
+
+    for( i = 0; i < CALLS; i++ )
+        v += libsum_dispatch( c->array, c->count );
+    bench_consume( (uint64_t)v );
+}
+
+int main( void ) {
+    static size_t const counts[] = { 16, 256, 65536 };
+    char name[64];
+    struct sum_case c;
+    size_t i, k;
+
+    c.array = malloc( 65536 * sizeof(int) );
+    if (c.array == NULL) {
+        fprintf( stderr, "Not enough memory\n" );
+        return 1;
+    }
+    for( i = 0; i < 65536; i++ )
+        c.array[i] = (int)(i % 201) - 100;
+    for( k = 0; k < sizeof counts / sizeof counts[0]; k++ )
+        if (libsum( c.array, counts[k] ) != libsum_dispatch( c.array, counts[k] )) {
+            fprintf( stderr, "libsum and libsum_dispatch differ\n" );
+            return 1;
+        }
+    fprintf( stderr, "libsum variant: %s\n", libsum_variant() );
+
+    bench_init( "ifunc" );
+    for( k = 0; k < sizeof counts / sizeof counts[0]; k++ ) {
+        c.count = counts[k];
+        snprintf( name, sizeof name, "sum%zu/ifunc", c.count );
+        bench_run( name, run_ifunc, &c, CALLS, c.count * sizeof(int) );
+        snprintf( name, sizeof name, "sum%zu/pointer", c.count );
+        bench_run( name, run_pointer, &c, CALLS, c.count * sizeof(int) );
+        snprintf( name, sizeof name, "sum%zu/dispatch", c.count );
+        bench_run( name, run_dispatch, &c, CALLS, c.count * sizeof(int) );
+    }
+
+    free( c.array );
+    return bench_finish();
+}
@@ -0,0 +1,178 @@
+/*
+ * Cost of a call by way of linking:
+ *   direct          function of the executable
+ *   plt             libnext of dynlib.so, through the PLT
+ *   plugin_cached   plugin_next through table pointer kept
+ *                   between calls (plugin.h)
+ *   plugin_get      table loaded (atomically) for every call
+ *   dlsym           symbol looked up for every call (what
+ *                   the table saves)
+ * then reload: time plugin_reload takes (dlopen of a copy,
+ * resolving, publishing), and the longest gap a caller thread
+ * sees between two calls while another thread reloads.
+ *
+ * build (see build.sh):
+ * $ gcc -O2 -I../syntax -o bench_plugin bench_plugin.c plugin.c
+ *       ../syntax/bench.c dynlib.so -ldl -pthread
+ * run from directory with plugin.so and plugin_v2.so.
+ */
+
+#define _GNU_SOURCE
+
+#include "bench.h"
+#include "plugin.h"
+#include <dlfcn.h>
+/* for: dlsym */
+#include <stdio.h>
+/* for: snprintf, fprintf */
+#include <stdlib.h>
+/* for: getenv, strtoul */
+#include <stdbool.h>
+/* for: false, true */
+#include <threads.h>
+/* for: thrd_create, thrd_join */
+
+/* dynlib.so uses global of executable */
+int global = 100;
+extern int libnext( int value );
+
+#define CALLS 100000
+
+/* noipa: compiler must not inline or see through it */
+__attribute__((noipa)) static int host_next( int value ) {
+    return value + 1;
+}
+
+static void run_direct( void* ctx ) {
+    int i, v = 0;
+
+    (void)ctx;
+    for( i = 0; i < CALLS; i++ )
+        v = host_next( v );
+    bench_consume( (uint64_t)v );
+}
+
+static void run_plt( void* ctx ) {
+    int i, v = 0;
+
+    (void)ctx;
+    for( i = 0; i < CALLS; i++ )
+        v = libnext( v );
+    bench_consume( (uint64_t)v );
+}
+
+static void run_plugin_cached( void* ctx ) {
+    struct plugin_table const* table = plugin_get( ctx );
+    int i, v = 0;
+
+    for( i = 0; i < CALLS; i++ )
+        v = table->plugin_next( v );
+    bench_consume( (uint64_t)v );
+}
+
+static void run_plugin_get( void* ctx ) {
+    int i, v = 0;
+
+    for( i = 0; i < CALLS; i++ )
+        v = plugin_get( ctx )->plugin_next( v );
+    bench_consume( (uint64_t)v );
+}
+
+static void run_dlsym( void* ctx ) {
+    void* handle = plugin_get( ctx )->handle;
+    int i, v = 0;
+
+    for( i = 0; i < CALLS / 100; i++ ) {
+        int (*next)( int );
+        void* symbol = dlsym( handle, "plugin_next" );
+
+        *(void**)&next = symbol;
+        v = next( v );
+    }
+    bench_consume( (uint64_t)v );
+}
+
+struct caller {
+    struct plugin* plugin;
+    atomic_bool stop;
+    uint64_t longest;   /* ns between two calls */
+    uint64_t calls;
+};
+
+static int call_until_stopped( void* arg ) {
+    struct caller* c = arg;
+    uint64_t last = bench_now_ns(), now;
+    int v = 0;
+
+    c->longest = 0;
+    c->calls = 0;
+    while (!atomic_load( &c->stop )) {
+        v = plugin_get( c->plugin )->plugin_next( v );
+        now = bench_now_ns();
+        if (now - last > c->longest)
+            c->longest = now - last;
+        last = now;
+        c->calls++;
+    }
+    bench_consume( (uint64_t)v );
+    return 0;
+}
+
+/* longest gap between calls of a thread, while reloads are done */
+static uint64_t caller_gap( struct plugin* plugin, int reloads, uint64_t* reload_ns ) {
+    struct caller c;
+    thrd_t id;
+    uint64_t start, spent = 0;
+    int i;
+
+    c.plugin = plugin;
+    atomic_init( &c.stop, false );
+    if (thrd_create( &id, call_until_stopped, &c ) != thrd_success)
+        return 0;
+    for( i = 0; i < 20; i++ ) {
+        thrd_yield();
+        if (i < reloads) {
+            start = bench_now_ns();
+            plugin_reload( plugin );
+            spent += bench_now_ns() - start;
+        }
+    }
+    atomic_store( &c.stop, true );
+    thrd_join( id, NULL );
+    plugin_collect( plugin );
+    if (reload_ns != NULL)
+        *reload_ns = reloads > 0 ? spent / (uint64_t)reloads : 0;
+    return c.longest;
+}
+
+int main( int argc, char** argv ) {
+    char const* dir = argc > 1 ? argv[1] : ".";
+    char path[4096];
+    struct plugin plugin;
+    uint64_t reload_ns;
+
+    snprintf( path, sizeof path, "%s/plugin.so", dir );
+    if (plugin_open( &plugin, path ) != 0) {
+        fprintf( stderr, "%s\n", plugin.error );
+        return 1;
+    }
+
+    bench_init( "plugin" );
+    bench_run( "call/direct", run_direct, NULL, CALLS, 0 );
+    bench_run( "call/plt", run_plt, NULL, CALLS, 0 );
+    bench_run( "call/plugin_cached", run_plugin_cached, &plugin, CALLS, 0 );
+    bench_run( "call/plugin_get", run_plugin_get, &plugin, CALLS, 0 );
+    bench_run( "call/dlsym", run_dlsym, &plugin, CALLS / 100, 0 );
+
+    /* caller thread may run on another CPU than the reloading one */
+    bench_unpin();
+    bench_metric( "reload/caller_gap_without_reload", "us",
+                  (double)caller_gap( &plugin, 0, NULL ) / 1e3 );
+    bench_metric( "reload/caller_gap_with_reload", "us",
+                  (double)caller_gap( &plugin, 10, &reload_ns ) / 1e3 );
+    bench_pin();
+    bench_metric( "reload/plugin_reload", "us", (double)reload_ns / 1e3 );
+
+    plugin_close( &plugin );
+    return bench_finish();
+}
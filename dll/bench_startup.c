@@ -0,0 +1,120 @@
+/*
+ * Startup time of executables given as NAME=PATH arguments
+ * (built by startup.sh): every one is run STARTUP_RUNS times
+ * (default 101), it gets clock taken just before exec as
+ * argv[1] and prints nanoseconds from it to main, and to
+ * return of first call into a library. Medians are reported
+ * in microseconds.
+ *
+ * build with:
+ * $ gcc -O2 -I../syntax -o bench_startup bench_startup.c ../syntax/bench.c
+ */
+
+#define _GNU_SOURCE
+
+#include "bench.h"
+#include <stdio.h>
+/* for: snprintf, fprintf, sscanf */
+#include <stdlib.h>
+/* for: getenv, strtoul, malloc, free, qsort */
+#include <string.h>
+/* for: strchr */
+#include <unistd.h>
+/* for: fork, execv, pipe, dup2, read, close */
+#include <sys/wait.h>
+/* for: waitpid */
+
+static int compare( void const* a, void const* b ) {
+    double x = *(double const*)a, y = *(double const*)b;
+
+    return (x > y) - (x < y);
+}
+
+static double median( double* values, size_t count ) {
+    qsort( values, count, sizeof *values, compare );
+    return values[count / 2];
+}
+
+/* one run, times in ns, -1 on failure */
+static int run( char const* path, double* to_main, double* to_call ) {
+    char output[128];
+    ssize_t got, used = 0;
+    long long main_ns, call_ns;
+    int ends[2], status;
+    pid_t child;
+
+    if (pipe( ends ) != 0)
+        return -1;
+    child = fork();
+    if (child < 0) {
+        close( ends[0] );
+        close( ends[1] );
+        return -1;
+    }
+    if (child == 0) {
+        char start[32];
+        char* args[3];
+
+        dup2( ends[1], 1 );
+        close( ends[0] );
+        close( ends[1] );
+        args[0] = (char*)path;
+        args[1] = start;
+        args[2] = NULL;
+        snprintf( start, sizeof start, "%llu", (unsigned long long)bench_now_ns() );
+        execv( path, args );
+        _exit( 127 );
+    }
+    close( ends[1] );
+    while ((got = read( ends[0], output + used, sizeof output - 1 - (size_t)used )) > 0)
+        used += got;
+    close( ends[0] );
+    output[used] = '\0';
+    waitpid( child, &status, 0 );
+    if (!WIFEXITED( status ) || WEXITSTATUS( status ) != 0
+            || sscanf( output, "%lld %lld", &main_ns, &call_ns ) != 2)
+        return -1;
+    *to_main = (double)main_ns;
+    *to_call = (double)call_ns;
+    return 0;
+}
+
+int main( int argc, char** argv ) {
+    char const* r = getenv( "STARTUP_RUNS" );
+    size_t runs = r != NULL ? (size_t)strtoul( r, NULL, 10 ) : 101;
+    double* to_main = malloc( runs * sizeof(double) );
+    double* to_call = malloc( runs * sizeof(double) );
+    char name[256];
+    int a;
+    size_t i;
+
+    if (to_main == NULL || to_call == NULL || runs == 0) {
+        fprintf( stderr, "Not enough memory\n" );
+        return 1;
+    }
+    bench_init( "startup" );
+    for( a = 1; a < argc; a++ ) {
+        char* path = strchr( argv[a], '=' );
+
+        if (path == NULL) {
+            fprintf( stderr, "argument is not NAME=PATH: %s\n", argv[a] );
+            return 1;
+        }
+        *path++ = '\0';
+        /* warm page cache */
+        for( i = 0; i < 3; i++ )
+            run( path, &to_main[0], &to_call[0] );
+        for( i = 0; i < runs; i++ )
+            if (run( path, &to_main[i], &to_call[i] ) != 0) {
+                fprintf( stderr, "%s failed\n", path );
+                return 1;
+            }
+        snprintf( name, sizeof name, "%s/exec_to_main", argv[a] );
+        bench_metric( name, "us", median( to_main, runs ) / 1e3 );
+        snprintf( name, sizeof name, "%s/exec_to_first_call", argv[a] );
+        bench_metric( name, "us", median( to_call, runs ) / 1e3 );
+    }
+    free( to_main );
+    free( to_call );
+    return bench_finish();
+}
@@ -0,0 +1,18 @@
+#define EXPORT __attribute__((visibility("default")))
+int lib0_f0( int x ) { return x + 1; }
+int lib0_f1( int x ) { return lib0_f0( x ) + 1; }
+int lib0_f2( int x ) { return lib0_f1( x ) + 1; }
+int lib0_f3( int x ) { return lib0_f2( x ) + 1; }
+int lib0_f4( int x ) { return lib0_f3( x ) + 1; }
+int lib0_f5( int x ) { return lib0_f4( x ) + 1; }
+int lib0_f6( int x ) { return lib0_f5( x ) + 1; }
+int lib0_f7( int x ) { return lib0_f6( x ) + 1; }
+int lib0_f8( int x ) { return lib0_f7( x ) + 1; }
+int lib0_f9( int x ) { return lib0_f8( x ) + 1; }
+int lib0_f10( int x ) { return lib0_f9( x ) + 1; }
+int lib0_f11( int x ) { return lib0_f10( x ) + 1; }
+int lib0_f12( int x ) { return lib0_f11( x ) + 1; }
+int lib0_f13( int x ) { return lib0_f12( x ) + 1; }
+int lib0_f14( int x ) { return lib0_f13( x ) + 1; }
+int lib0_f15( int x ) { return lib0_f14( x ) + 1; }
+EXPORT int lib0_entry( int x ) { return lib0_f15( x ); }
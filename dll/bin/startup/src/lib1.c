@@ -0,0 +1,18 @@
+#define EXPORT __attribute__((visibility("default")))
+int lib1_f0( int x ) { return x + 1; }
+int lib1_f1( int x ) { return lib1_f0( x ) + 1; }
+int lib1_f2( int x ) { return lib1_f1( x ) + 1; }
+int lib1_f3( int x ) { return lib1_f2( x ) + 1; }
+int lib1_f4( int x ) { return lib1_f3( x ) + 1; }
+int lib1_f5( int x ) { return lib1_f4( x ) + 1; }
+int lib1_f6( int x ) { return lib1_f5( x ) + 1; }
+int lib1_f7( int x ) { return lib1_f6( x ) + 1; }
+int lib1_f8( int x ) { return lib1_f7( x ) + 1; }
+int lib1_f9( int x ) { return lib1_f8( x ) + 1; }
+int lib1_f10( int x ) { return lib1_f9( x ) + 1; }
+int lib1_f11( int x ) { return lib1_f10( x ) + 1; }
+int lib1_f12( int x ) { return lib1_f11( x ) + 1; }
+int lib1_f13( int x ) { return lib1_f12( x ) + 1; }
+int lib1_f14( int x ) { return lib1_f13( x ) + 1; }
+int lib1_f15( int x ) { return lib1_f14( x ) + 1; }
+EXPORT int lib1_entry( int x ) { return lib1_f15( x ); }
@@ -0,0 +1,258 @@
+#define EXPORT __attribute__((visibility("default")))
+int lib10_f0( int x ) { return x + 1; }
+int lib10_f1( int x ) { return lib10_f0( x ) + 1; }
+int lib10_f2( int x ) { return lib10_f1( x ) + 1; }
+int lib10_f3( int x ) { return lib10_f2( x ) + 1; }
+int lib10_f4( int x ) { return lib10_f3( x ) + 1; }
+int lib10_f5( int x ) { return lib10_f4( x ) + 1; }
+int lib10_f6( int x ) { return lib10_f5( x ) + 1; }
+int lib10_f7( int x ) { return lib10_f6( x ) + 1; }
+int lib10_f8( int x ) { return lib10_f7( x ) + 1; }
+int lib10_f9( int x ) { return lib10_f8( x ) + 1; }
+int lib10_f10( int x ) { return lib10_f9( x ) + 1; }
+int lib10_f11( int x ) { return lib10_f10( x ) + 1; }
+int lib10_f12( int x ) { return lib10_f11( x ) + 1; }
+int lib10_f13( int x ) { return lib10_f12( x ) + 1; }
+int lib10_f14( int x ) { return lib10_f13( x ) + 1; }
+int lib10_f15( int x ) { return lib10_f14( x ) + 1; }
+int lib10_f16( int x ) { return lib10_f15( x ) + 1; }
+int lib10_f17( int x ) { return lib10_f16( x ) + 1; }
+int lib10_f18( int x ) { return lib10_f17( x ) + 1; }
+int lib10_f19( int x ) { return lib10_f18( x ) + 1; }
+int lib10_f20( int x ) { return lib10_f19( x ) + 1; }
+int lib10_f21( int x ) { return lib10_f20( x ) + 1; }
+int lib10_f22( int x ) { return lib10_f21( x ) + 1; }
+int lib10_f23( int x ) { return lib10_f22( x ) + 1; }
+int lib10_f24( int x ) { return lib10_f23( x ) + 1; }
+int lib10_f25( int x ) { return lib10_f24( x ) + 1; }
+int lib10_f26( int x ) { return lib10_f25( x ) + 1; }
+int lib10_f27( int x ) { return lib10_f26( x ) + 1; }
+int lib10_f28( int x ) { return lib10_f27( x ) + 1; }
+int lib10_f29( int x ) { return lib10_f28( x ) + 1; }
+int lib10_f30( int x ) { return lib10_f29( x ) + 1; }
+int lib10_f31( int x ) { return lib10_f30( x ) + 1; }
+int lib10_f32( int x ) { return lib10_f31( x ) + 1; }
+int lib10_f33( int x ) { return lib10_f32( x ) + 1; }
+int lib10_f34( int x ) { return lib10_f33( x ) + 1; }
+int lib10_f35( int x ) { return lib10_f34( x ) + 1; }
+int lib10_f36( int x ) { return lib10_f35( x ) + 1; }
+int lib10_f37( int x ) { return lib10_f36( x ) + 1; }
+int lib10_f38( int x ) { return lib10_f37( x ) + 1; }
+int lib10_f39( int x ) { return lib10_f38( x ) + 1; }
+int lib10_f40( int x ) { return lib10_f39( x ) + 1; }
+int lib10_f41( int x ) { return lib10_f40( x ) + 1; }
+int lib10_f42( int x ) { return lib10_f41( x ) + 1; }
+int lib10_f43( int x ) { return lib10_f42( x ) + 1; }
+int lib10_f44( int x ) { return lib10_f43( x ) + 1; }
+int lib10_f45( int x ) { return lib10_f44( x ) + 1; }
+int lib10_f46( int x ) { return lib10_f45( x ) + 1; }
+int lib10_f47( int x ) { return lib10_f46( x ) + 1; }
+int lib10_f48( int x ) { return lib10_f47( x ) + 1; }
+int lib10_f49( int x ) { return lib10_f48( x ) + 1; }
+int lib10_f50( int x ) { return lib10_f49( x ) + 1; }
+int lib10_f51( int x ) { return lib10_f50( x ) + 1; }
+int lib10_f52( int x ) { return lib10_f51( x ) + 1; }
+int lib10_f53( int x ) { return lib10_f52( x ) + 1; }
+int lib10_f54( int x ) { return lib10_f53( x ) + 1; }
+int lib10_f55( int x ) { return lib10_f54( x ) + 1; }
+int lib10_f56( int x ) { return lib10_f55( x ) + 1; }
+int lib10_f57( int x ) { return lib10_f56( x ) + 1; }
+int lib10_f58( int x ) { return lib10_f57( x ) + 1; }
+int lib10_f59( int x ) { return lib10_f58( x ) + 1; }
+int lib10_f60( int x ) { return lib10_f59( x ) + 1; }
+int lib10_f61( int x ) { return lib10_f60( x ) + 1; }
+int lib10_f62( int x ) { return lib10_f61( x ) + 1; }
+int lib10_f63( int x ) { return lib10_f62( x ) + 1; }
+int lib10_f64( int x ) { return lib10_f63( x ) + 1; }
+int lib10_f65( int x ) { return lib10_f64( x ) + 1; }
+int lib10_f66( int x ) { return lib10_f65( x ) + 1; }
+int lib10_f67( int x ) { return lib10_f66( x ) + 1; }
+int lib10_f68( int x ) { return lib10_f67( x ) + 1; }
+int lib10_f69( int x ) { return lib10_f68( x ) + 1; }
+int lib10_f70( int x ) { return lib10_f69( x ) + 1; }
+int lib10_f71( int x ) { return lib10_f70( x ) + 1; }
+int lib10_f72( int x ) { return lib10_f71( x ) + 1; }
+int lib10_f73( int x ) { return lib10_f72( x ) + 1; }
+int lib10_f74( int x ) { return lib10_f73( x ) + 1; }
+int lib10_f75( int x ) { return lib10_f74( x ) + 1; }
+int lib10_f76( int x ) { return lib10_f75( x ) + 1; }
+int lib10_f77( int x ) { return lib10_f76( x ) + 1; }
+int lib10_f78( int x ) { return lib10_f77( x ) + 1; }
+int lib10_f79( int x ) { return lib10_f78( x ) + 1; }
+int lib10_f80( int x ) { return lib10_f79( x ) + 1; }
+int lib10_f81( int x ) { return lib10_f80( x ) + 1; }
+int lib10_f82( int x ) { return lib10_f81( x ) + 1; }
+int lib10_f83( int x ) { return lib10_f82( x ) + 1; }
+int lib10_f84( int x ) { return lib10_f83( x ) + 1; }
+int lib10_f85( int x ) { return lib10_f84( x ) + 1; }
+int lib10_f86( int x ) { return lib10_f85( x ) + 1; }
+int lib10_f87( int x ) { return lib10_f86( x ) + 1; }
+int lib10_f88( int x ) { return lib10_f87( x ) + 1; }
+int lib10_f89( int x ) { return lib10_f88( x ) + 1; }
+int lib10_f90( int x ) { return lib10_f89( x ) + 1; }
+int lib10_f91( int x ) { return lib10_f90( x ) + 1; }
+int lib10_f92( int x ) { return lib10_f91( x ) + 1; }
+int lib10_f93( int x ) { return lib10_f92( x ) + 1; }
+int lib10_f94( int x ) { return lib10_f93( x ) + 1; }
+int lib10_f95( int x ) { return lib10_f94( x ) + 1; }
+int lib10_f96( int x ) { return lib10_f95( x ) + 1; }
+int lib10_f97( int x ) { return lib10_f96( x ) + 1; }
+int lib10_f98( int x ) { return lib10_f97( x ) + 1; }
+int lib10_f99( int x ) { return lib10_f98( x ) + 1; }
+int lib10_f100( int x ) { return lib10_f99( x ) + 1; }
+int lib10_f101( int x ) { return lib10_f100( x ) + 1; }
+int lib10_f102( int x ) { return lib10_f101( x ) + 1; }
+int lib10_f103( int x ) { return lib10_f102( x ) + 1; }
+int lib10_f104( int x ) { return lib10_f103( x ) + 1; }
+int lib10_f105( int x ) { return lib10_f104( x ) + 1; }
+int lib10_f106( int x ) { return lib10_f105( x ) + 1; }
+int lib10_f107( int x ) { return lib10_f106( x ) + 1; }
+int lib10_f108( int x ) { return lib10_f107( x ) + 1; }
+int lib10_f109( int x ) { return lib10_f108( x ) + 1; }
+int lib10_f110( int x ) { return lib10_f109( x ) + 1; }
+int lib10_f111( int x ) { return lib10_f110( x ) + 1; }
+int lib10_f112( int x ) { return lib10_f111( x ) + 1; }
+int lib10_f113( int x ) { return lib10_f112( x ) + 1; }
+int lib10_f114( int x ) { return lib10_f113( x ) + 1; }
+int lib10_f115( int x ) { return lib10_f114( x ) + 1; }
+int lib10_f116( int x ) { return lib10_f115( x ) + 1; }
+int lib10_f117( int x ) { return lib10_f116( x ) + 1; }
+int lib10_f118( int x ) { return lib10_f117( x ) + 1; }
+int lib10_f119( int x ) { return lib10_f118( x ) + 1; }
+int lib10_f120( int x ) { return lib10_f119( x ) + 1; }
+int lib10_f121( int x ) { return lib10_f120( x ) + 1; }
+int lib10_f122( int x ) { return lib10_f121( x ) + 1; }
+int lib10_f123( int x ) { return lib10_f122( x ) + 1; }
+int lib10_f124( int x ) { return lib10_f123( x ) + 1; }
+int lib10_f125( int x ) { return lib10_f124( x ) + 1; }
+int lib10_f126( int x ) { return lib10_f125( x ) + 1; }
+int lib10_f127( int x ) { return lib10_f126( x ) + 1; }
+int lib10_f128( int x ) { return lib10_f127( x ) + 1; }
+int lib10_f129( int x ) { return lib10_f128( x ) + 1; }
+int lib10_f130( int x ) { return lib10_f129( x ) + 1; }
+int lib10_f131( int x ) { return lib10_f130( x ) + 1; }
+int lib10_f132( int x ) { return lib10_f131( x ) + 1; }
+int lib10_f133( int x ) { return lib10_f132( x ) + 1; }
+int lib10_f134( int x ) { return lib10_f133( x ) + 1; }
+int lib10_f135( int x ) { return lib10_f134( x ) + 1; }
+int lib10_f136( int x ) { return lib10_f135( x ) + 1; }
+int lib10_f137( int x ) { return lib10_f136( x ) + 1; }
+int lib10_f138( int x ) { return lib10_f137( x ) + 1; }
+int lib10_f139( int x ) { return lib10_f138( x ) + 1; }
+int lib10_f140( int x ) { return lib10_f139( x ) + 1; }
+int lib10_f141( int x ) { return lib10_f140( x ) + 1; }
+int lib10_f142( int x ) { return lib10_f141( x ) + 1; }
+int lib10_f143( int x ) { return lib10_f142( x ) + 1; }
+int lib10_f144( int x ) { return lib10_f143( x ) + 1; }
+int lib10_f145( int x ) { return lib10_f144( x ) + 1; }
+int lib10_f146( int x ) { return lib10_f145( x ) + 1; }
+int lib10_f147( int x ) { return lib10_f146( x ) + 1; }
+int lib10_f148( int x ) { return lib10_f147( x ) + 1; }
+int lib10_f149( int x ) { return lib10_f148( x ) + 1; }
+int lib10_f150( int x ) { return lib10_f149( x ) + 1; }
+int lib10_f151( int x ) { return lib10_f150( x ) + 1; }
+int lib10_f152( int x ) { return lib10_f151( x ) + 1; }
+int lib10_f153( int x ) { return lib10_f152( x ) + 1; }
+int lib10_f154( int x ) { return lib10_f153( x ) + 1; }
+int lib10_f155( int x ) { return lib10_f154( x ) + 1; }
+int lib10_f156( int x ) { return lib10_f155( x ) + 1; }
+int lib10_f157( int x ) { return lib10_f156( x ) + 1; }
+int lib10_f158( int x ) { return lib10_f157( x ) + 1; }
+int lib10_f159( int x ) { return lib10_f158( x ) + 1; }
+int lib10_f160( int x ) { return lib10_f159( x ) + 1; }
+int lib10_f161( int x ) { return lib10_f160( x ) + 1; }
+int lib10_f162( int x ) { return lib10_f161( x ) + 1; }
+int lib10_f163( int x ) { return lib10_f162( x ) + 1; }
+int lib10_f164( int x ) { return lib10_f163( x ) + 1; }
+int lib10_f165( int x ) { return lib10_f164( x ) + 1; }
+int lib10_f166( int x ) { return lib10_f165( x ) + 1; }
+int lib10_f167( int x ) { return lib10_f166( x ) + 1; }
+int lib10_f168( int x ) { return lib10_f167( x ) + 1; }
+int lib10_f169( int x ) { return lib10_f168( x ) + 1; }
+int lib10_f170( int x ) { return lib10_f169( x ) + 1; }
+int lib10_f171( int x ) { return lib10_f170( x ) + 1; }
+int lib10_f172( int x ) { return lib10_f171( x ) + 1; }
+int lib10_f173( int x ) { return lib10_f172( x ) + 1; }
+int lib10_f174( int x ) { return lib10_f173( x ) + 1; }
+int lib10_f175( int x ) { return lib10_f174( x ) + 1; }
+int lib10_f176( int x ) { return lib10_f175( x ) + 1; }
+int lib10_f177( int x ) { return lib10_f176( x ) + 1; }
+int lib10_f178( int x ) { return lib10_f177( x ) + 1; }
+int lib10_f179( int x ) { return lib10_f178( x ) + 1; }
+int lib10_f180( int x ) { return lib10_f179( x ) + 1; }
+int lib10_f181( int x ) { return lib10_f180( x ) + 1; }
+int lib10_f182( int x ) { return lib10_f181( x ) + 1; }
+int lib10_f183( int x ) { return lib10_f182( x ) + 1; }
+int lib10_f184( int x ) { return lib10_f183( x ) + 1; }
+int lib10_f185( int x ) { return lib10_f184( x ) + 1; }
+int lib10_f186( int x ) { return lib10_f185( x ) + 1; }
+int lib10_f187( int x ) { return lib10_f186( x ) + 1; }
+int lib10_f188( int x ) { return lib10_f187( x ) + 1; }
+int lib10_f189( int x ) { return lib10_f188( x ) + 1; }
+int lib10_f190( int x ) { return lib10_f189( x ) + 1; }
+int lib10_f191( int x ) { return lib10_f190( x ) + 1; }
+int lib10_f192( int x ) { return lib10_f191( x ) + 1; }
+int lib10_f193( int x ) { return lib10_f192( x ) + 1; }
+int lib10_f194( int x ) { return lib10_f193( x ) + 1; }
+int lib10_f195( int x ) { return lib10_f194( x ) + 1; }
+int lib10_f196( int x ) { return lib10_f195( x ) + 1; }
+int lib10_f197( int x ) { return lib10_f196( x ) + 1; }
+int lib10_f198( int x ) { return lib10_f197( x ) + 1; }
+int lib10_f199( int x ) { return lib10_f198( x ) + 1; }
+int lib10_f200( int x ) { return lib10_f199( x ) + 1; }
+int lib10_f201( int x ) { return lib10_f200( x ) + 1; }
+int lib10_f202( int x ) { return lib10_f201( x ) + 1; }
+int lib10_f203( int x ) { return lib10_f202( x ) + 1; }
+int lib10_f204( int x ) { return lib10_f203( x ) + 1; }
+int lib10_f205( int x ) { return lib10_f204( x ) + 1; }
+int lib10_f206( int x ) { return lib10_f205( x ) + 1; }
+int lib10_f207( int x ) { return lib10_f206( x ) + 1; }
+int lib10_f208( int x ) { return lib10_f207( x ) + 1; }
+int lib10_f209( int x ) { return lib10_f208( x ) + 1; }
+int lib10_f210( int x ) { return lib10_f209( x ) + 1; }
+int lib10_f211( int x ) { return lib10_f210( x ) + 1; }
+int lib10_f212( int x ) { return lib10_f211( x ) + 1; }
+int lib10_f213( int x ) { return lib10_f212( x ) + 1; }
+int lib10_f214( int x ) { return lib10_f213( x ) + 1; }
+int lib10_f215( int x ) { return lib10_f214( x ) + 1; }
+int lib10_f216( int x ) { return lib10_f215( x ) + 1; }
+int lib10_f217( int x ) { return lib10_f216( x ) + 1; }
+int lib10_f218( int x ) { return lib10_f217( x ) + 1; }
+int lib10_f219( int x ) { return lib10_f218( x ) + 1; }
+int lib10_f220( int x ) { return lib10_f219( x ) + 1; }
+int lib10_f221( int x ) { return lib10_f220( x ) + 1; }
+int lib10_f222( int x ) { return lib10_f221( x ) + 1; }
+int lib10_f223( int x ) { return lib10_f222( x ) + 1; }
+int lib10_f224( int x ) { return lib10_f223( x ) + 1; }
+int lib10_f225( int x ) { return lib10_f224( x ) + 1; }
+int lib10_f226( int x ) { return lib10_f225( x ) + 1; }
+int lib10_f227( int x ) { return lib10_f226( x ) + 1; }
+int lib10_f228( int x ) { return lib10_f227( x ) + 1; }
+int lib10_f229( int x ) { return lib10_f228( x ) + 1; }
+int lib10_f230( int x ) { return lib10_f229( x ) + 1; }
+int lib10_f231( int x ) { return lib10_f230( x ) + 1; }
+int lib10_f232( int x ) { return lib10_f231( x ) + 1; }
+int lib10_f233( int x ) { return lib10_f232( x ) + 1; }
+int lib10_f234( int x ) { return lib10_f233( x ) + 1; }
+int lib10_f235( int x ) { return lib10_f234( x ) + 1; }
+int lib10_f236( int x ) { return lib10_f235( x ) + 1; }
+int lib10_f237( int x ) { return lib10_f236( x ) + 1; }
+int lib10_f238( int x ) { return lib10_f237( x ) + 1; }
+int lib10_f239( int x ) { return lib10_f238( x ) + 1; }
+int lib10_f240( int x ) { return lib10_f239( x ) + 1; }
+int lib10_f241( int x ) { return lib10_f240( x ) + 1; }
+int lib10_f242( int x ) { return lib10_f241( x ) + 1; }
+int lib10_f243( int x ) { return lib10_f242( x ) + 1; }
+int lib10_f244( int x ) { return lib10_f243( x ) + 1; }
+int lib10_f245( int x ) { return lib10_f244( x ) + 1; }
+int lib10_f246( int x ) { return lib10_f245( x ) + 1; }
+int lib10_f247( int x ) { return lib10_f246( x ) + 1; }
+int lib10_f248( int x ) { return lib10_f247( x ) + 1; }
+int lib10_f249( int x ) { return lib10_f248( x ) + 1; }
+int lib10_f250( int x ) { return lib10_f249( x ) + 1; }
+int lib10_f251( int x ) { return lib10_f250( x ) + 1; }
+int lib10_f252( int x ) { return lib10_f251( x ) + 1; }
+int lib10_f253( int x ) { return lib10_f252( x ) + 1; }
+int lib10_f254( int x ) { return lib10_f253( x ) + 1; }
+int lib10_f255( int x ) { return lib10_f254( x ) + 1; }
+EXPORT int lib10_entry( int x ) { return lib10_f255( x ); }
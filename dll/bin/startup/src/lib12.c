@@ -0,0 +1,258 @@
+#define EXPORT __attribute__((visibility("default")))
+int lib12_f0( int x ) { return x + 1; }
+int lib12_f1( int x ) { return lib12_f0( x ) + 1; }
+int lib12_f2( int x ) { return lib12_f1( x ) + 1; }
+int lib12_f3( int x ) { return lib12_f2( x ) + 1; }
+int lib12_f4( int x ) { return lib12_f3( x ) + 1; }
+int lib12_f5( int x ) { return lib12_f4( x ) + 1; }
+int lib12_f6( int x ) { return lib12_f5( x ) + 1; }
+int lib12_f7( int x ) { return lib12_f6( x ) + 1; }
+int lib12_f8( int x ) { return lib12_f7( x ) + 1; }
+int lib12_f9( int x ) { return lib12_f8( x ) + 1; }
+int lib12_f10( int x ) { return lib12_f9( x ) + 1; }
+int lib12_f11( int x ) { return lib12_f10( x ) + 1; }
+int lib12_f12( int x ) { return lib12_f11( x ) + 1; }
+int lib12_f13( int x ) { return lib12_f12( x ) + 1; }
+int lib12_f14( int x ) { return lib12_f13( x ) + 1; }
+int lib12_f15( int x ) { return lib12_f14( x ) + 1; }
+int lib12_f16( int x ) { return lib12_f15( x ) + 1; }
+int lib12_f17( int x ) { return lib12_f16( x ) + 1; }
+int lib12_f18( int x ) { return lib12_f17( x ) + 1; }
+int lib12_f19( int x ) { return lib12_f18( x ) + 1; }
+int lib12_f20( int x ) { return lib12_f19( x ) + 1; }
+int lib12_f21( int x ) { return lib12_f20( x ) + 1; }
+int lib12_f22( int x ) { return lib12_f21( x ) + 1; }
+int lib12_f23( int x ) { return lib12_f22( x ) + 1; }
+int lib12_f24( int x ) { return lib12_f23( x ) + 1; }
+int lib12_f25( int x ) { return lib12_f24( x ) + 1; }
+int lib12_f26( int x ) { return lib12_f25( x ) + 1; }
+int lib12_f27( int x ) { return lib12_f26( x ) + 1; }
+int lib12_f28( int x ) { return lib12_f27( x ) + 1; }
+int lib12_f29( int x ) { return lib12_f28( x ) + 1; }
+int lib12_f30( int x ) { return lib12_f29( x ) + 1; }
+int lib12_f31( int x ) { return lib12_f30( x ) + 1; }
+int lib12_f32( int x ) { return lib12_f31( x ) + 1; }
+int lib12_f33( int x ) { return lib12_f32( x ) + 1; }
+int lib12_f34( int x ) { return lib12_f33( x ) + 1; }
+int lib12_f35( int x ) { return lib12_f34( x ) + 1; }
+int lib12_f36( int x ) { return lib12_f35( x ) + 1; }
+int lib12_f37( int x ) { return lib12_f36( x ) + 1; }
+int lib12_f38( int x ) { return lib12_f37( x ) + 1; }
+int lib12_f39( int x ) { return lib12_f38( x ) + 1; }
+int lib12_f40( int x ) { return lib12_f39( x ) + 1; }
+int lib12_f41( int x ) { return lib12_f40( x ) + 1; }
+int lib12_f42( int x ) { return lib12_f41( x ) + 1; }
+int lib12_f43( int x ) { return lib12_f42( x ) + 1; }
+int lib12_f44( int x ) { return lib12_f43( x ) + 1; }
+int lib12_f45( int x ) { return lib12_f44( x ) + 1; }
+int lib12_f46( int x ) { return lib12_f45( x ) + 1; }
+int lib12_f47( int x ) { return lib12_f46( x ) + 1; }
+int lib12_f48( int x ) { return lib12_f47( x ) + 1; }
+int lib12_f49( int x ) { return lib12_f48( x ) + 1; }
+int lib12_f50( int x ) { return lib12_f49( x ) + 1; }
+int lib12_f51( int x ) { return lib12_f50( x ) + 1; }
+int lib12_f52( int x ) { return lib12_f51( x ) + 1; }
+int lib12_f53( int x ) { return lib12_f52( x ) + 1; }
+int lib12_f54( int x ) { return lib12_f53( x ) + 1; }
+int lib12_f55( int x ) { return lib12_f54( x ) + 1; }
+int lib12_f56( int x ) { return lib12_f55( x ) + 1; }
+int lib12_f57( int x ) { return lib12_f56( x ) + 1; }
+int lib12_f58( int x ) { return lib12_f57( x ) + 1; }
+int lib12_f59( int x ) { return lib12_f58( x ) + 1; }
+int lib12_f60( int x ) { return lib12_f59( x ) + 1; }
+int lib12_f61( int x ) { return lib12_f60( x ) + 1; }
+int lib12_f62( int x ) { return lib12_f61( x ) + 1; }
+int lib12_f63( int x ) { return lib12_f62( x ) + 1; }
+int lib12_f64( int x ) { return lib12_f63( x ) + 1; }
+int lib12_f65( int x ) { return lib12_f64( x ) + 1; }
+int lib12_f66( int x ) { return lib12_f65( x ) + 1; }
+int lib12_f67( int x ) { return lib12_f66( x ) + 1; }
+int lib12_f68( int x ) { return lib12_f67( x ) + 1; }
+int lib12_f69( int x ) { return lib12_f68( x ) + 1; }
+int lib12_f70( int x ) { return lib12_f69( x ) + 1; }
+int lib12_f71( int x ) { return lib12_f70( x ) + 1; }
+int lib12_f72( int x ) { return lib12_f71( x ) + 1; }
+int lib12_f73( int x ) { return lib12_f72( x ) + 1; }
+int lib12_f74( int x ) { return lib12_f73( x ) + 1; }
+int lib12_f75( int x ) { return lib12_f74( x ) + 1; }
+int lib12_f76( int x ) { return lib12_f75( x ) + 1; }
+int lib12_f77( int x ) { return lib12_f76( x ) + 1; }
+int lib12_f78( int x ) { return lib12_f77( x ) + 1; }
+int lib12_f79( int x ) { return lib12_f78( x ) + 1; }
+int lib12_f80( int x ) { return lib12_f79( x ) + 1; }
+int lib12_f81( int x ) { return lib12_f80( x ) + 1; }
+int lib12_f82( int x ) { return lib12_f81( x ) + 1; }
+int lib12_f83( int x ) { return lib12_f82( x ) + 1; }
+int lib12_f84( int x ) { return lib12_f83( x ) + 1; }
+int lib12_f85( int x ) { return lib12_f84( x ) + 1; }
+int lib12_f86( int x ) { return lib12_f85( x ) + 1; }
+int lib12_f87( int x ) { return lib12_f86( x ) + 1; }
+int lib12_f88( int x ) { return lib12_f87( x ) + 1; }
+int lib12_f89( int x ) { return lib12_f88( x ) + 1; }
+int lib12_f90( int x ) { return lib12_f89( x ) + 1; }
+int lib12_f91( int x ) { return lib12_f90( x ) + 1; }
+int lib12_f92( int x ) { return lib12_f91( x ) + 1; }
+int lib12_f93( int x ) { return lib12_f92( x ) + 1; }
+int lib12_f94( int x ) { return lib12_f93( x ) + 1; }
+int lib12_f95( int x ) { return lib12_f94( x ) + 1; }
+int lib12_f96( int x ) { return lib12_f95( x ) + 1; }
+int lib12_f97( int x ) { return lib12_f96( x ) + 1; }
+int lib12_f98( int x ) { return lib12_f97( x ) + 1; }
+int lib12_f99( int x ) { return lib12_f98( x ) + 1; }
+int lib12_f100( int x ) { return lib12_f99( x ) + 1; }
+int lib12_f101( int x ) { return lib12_f100( x ) + 1; }
+int lib12_f102( int x ) { return lib12_f101( x ) + 1; }
+int lib12_f103( int x ) { return lib12_f102( x ) + 1; }
+int lib12_f104( int x ) { return lib12_f103( x ) + 1; }
+int lib12_f105( int x ) { return lib12_f104( x ) + 1; }
+int lib12_f106( int x ) { return lib12_f105( x ) + 1; }
+int lib12_f107( int x ) { return lib12_f106( x ) + 1; }
+int lib12_f108( int x ) { return lib12_f107( x ) + 1; }
+int lib12_f109( int x ) { return lib12_f108( x ) + 1; }
+int lib12_f110( int x ) { return lib12_f109( x ) + 1; }
+int lib12_f111( int x ) { return lib12_f110( x ) + 1; }
+int lib12_f112( int x ) { return lib12_f111( x ) + 1; }
+int lib12_f113( int x ) { return lib12_f112( x ) + 1; }
+int lib12_f114( int x ) { return lib12_f113( x ) + 1; }
+int lib12_f115( int x ) { return lib12_f114( x ) + 1; }
+int lib12_f116( int x ) { return lib12_f115( x ) + 1; }
+int lib12_f117( int x ) { return lib12_f116( x ) + 1; }
+int lib12_f118( int x ) { return lib12_f117( x ) + 1; }
+int lib12_f119( int x ) { return lib12_f118( x ) + 1; }
+int lib12_f120( int x ) { return lib12_f119( x ) + 1; }
+int lib12_f121( int x ) { return lib12_f120( x ) + 1; }
+int lib12_f122( int x ) { return lib12_f121( x ) + 1; }
+int lib12_f123( int x ) { return lib12_f122( x ) + 1; }
+int lib12_f124( int x ) { return lib12_f123( x ) + 1; }
+int lib12_f125( int x ) { return lib12_f124( x ) + 1; }
+int lib12_f126( int x ) { return lib12_f125( x ) + 1; }
+int lib12_f127( int x ) { return lib12_f126( x ) + 1; }
+int lib12_f128( int x ) { return lib12_f127( x ) + 1; }
+int lib12_f129( int x ) { return lib12_f128( x ) + 1; }
+int lib12_f130( int x ) { return lib12_f129( x ) + 1; }
+int lib12_f131( int x ) { return lib12_f130( x ) + 1; }
+int lib12_f132( int x ) { return lib12_f131( x ) + 1; }
+int lib12_f133( int x ) { return lib12_f132( x ) + 1; }
+int lib12_f134( int x ) { return lib12_f133( x ) + 1; }
+int lib12_f135( int x ) { return lib12_f134( x ) + 1; }
+int lib12_f136( int x ) { return lib12_f135( x ) + 1; }
+int lib12_f137( int x ) { return lib12_f136( x ) + 1; }
+int lib12_f138( int x ) { return lib12_f137( x ) + 1; }
+int lib12_f139( int x ) { return lib12_f138( x ) + 1; }
+int lib12_f140( int x ) { return lib12_f139( x ) + 1; }
+int lib12_f141( int x ) { return lib12_f140( x ) + 1; }
+int lib12_f142( int x ) { return lib12_f141( x ) + 1; }
+int lib12_f143( int x ) { return lib12_f142( x ) + 1; }
+int lib12_f144( int x ) { return lib12_f143( x ) + 1; }
+int lib12_f145( int x ) { return lib12_f144( x ) + 1; }
+int lib12_f146( int x ) { return lib12_f145( x ) + 1; }
+int lib12_f147( int x ) { return lib12_f146( x ) + 1; }
+int lib12_f148( int x ) { return lib12_f147( x ) + 1; }
+int lib12_f149( int x ) { return lib12_f148( x ) + 1; }
+int lib12_f150( int x ) { return lib12_f149( x ) + 1; }
+int lib12_f151( int x ) { return lib12_f150( x ) + 1; }
+int lib12_f152( int x ) { return lib12_f151( x ) + 1; }
+int lib12_f153( int x ) { return lib12_f152( x ) + 1; }
+int lib12_f154( int x ) { return lib12_f153( x ) + 1; }
+int lib12_f155( int x ) { return lib12_f154( x ) + 1; }
+int lib12_f156( int x ) { return lib12_f155( x ) + 1; }
+int lib12_f157( int x ) { return lib12_f156( x ) + 1; }
+int lib12_f158( int x ) { return lib12_f157( x ) + 1; }
+int lib12_f159( int x ) { return lib12_f158( x ) + 1; }
+int lib12_f160( int x ) { return lib12_f159( x ) + 1; }
+int lib12_f161( int x ) { return lib12_f160( x ) + 1; }
+int lib12_f162( int x ) { return lib12_f161( x ) + 1; }
+int lib12_f163( int x ) { return lib12_f162( x ) + 1; }
+int lib12_f164( int x ) { return lib12_f163( x ) + 1; }
+int lib12_f165( int x ) { return lib12_f164( x ) + 1; }
+int lib12_f166( int x ) { return lib12_f165( x ) + 1; }
+int lib12_f167( int x ) { return lib12_f166( x ) + 1; }
+int lib12_f168( int x ) { return lib12_f167( x ) + 1; }
+int lib12_f169( int x ) { return lib12_f168( x ) + 1; }
+int lib12_f170( int x ) { return lib12_f169( x ) + 1; }
+int lib12_f171( int x ) { return lib12_f170( x ) + 1; }
+int lib12_f172( int x ) { return lib12_f171( x ) + 1; }
+int lib12_f173( int x ) { return lib12_f172( x ) + 1; }
+int lib12_f174( int x ) { return lib12_f173( x ) + 1; }
+int lib12_f175( int x ) { return lib12_f174( x ) + 1; }
+int lib12_f176( int x ) { return lib12_f175( x ) + 1; }
+int lib12_f177( int x ) { return lib12_f176( x ) + 1; }
+int lib12_f178( int x ) { return lib12_f177( x ) + 1; }
+int lib12_f179( int x ) { return lib12_f178( x ) + 1; }
+int lib12_f180( int x ) { return lib12_f179( x ) + 1; }
+int lib12_f181( int x ) { return lib12_f180( x ) + 1; }
+int lib12_f182( int x ) { return lib12_f181( x ) + 1; }
+int lib12_f183( int x ) { return lib12_f182( x ) + 1; }
+int lib12_f184( int x ) { return lib12_f183( x ) + 1; }
+int lib12_f185( int x ) { return lib12_f184( x ) + 1; }
+int lib12_f186( int x ) { return lib12_f185( x ) + 1; }
+int lib12_f187( int x ) { return lib12_f186( x ) + 1; }
+int lib12_f188( int x ) { return lib12_f187( x ) + 1; }
+int lib12_f189( int x ) { return lib12_f188( x ) + 1; }
+int lib12_f190( int x ) { return lib12_f189( x ) + 1; }
+int lib12_f191( int x ) { return lib12_f190( x ) + 1; }
+int lib12_f192( int x ) { return lib12_f191( x ) + 1; }
+int lib12_f193( int x ) { return lib12_f192( x ) + 1; }
+int lib12_f194( int x ) { return lib12_f193( x ) + 1; }
+int lib12_f195( int x ) { return lib12_f194( x ) + 1; }
+int lib12_f196( int x ) { return lib12_f195( x ) + 1; }
+int lib12_f197( int x ) { return lib12_f196( x ) + 1; }
+int lib12_f198( int x ) { return lib12_f197( x ) + 1; }
+int lib12_f199( int x ) { return lib12_f198( x ) + 1; }
+int lib12_f200( int x ) { return lib12_f199( x ) + 1; }
+int lib12_f201( int x ) { return lib12_f200( x ) + 1; }
+int lib12_f202( int x ) { return lib12_f201( x ) + 1; }
+int lib12_f203( int x ) { return lib12_f202( x ) + 1; }
+int lib12_f204( int x ) { return lib12_f203( x ) + 1; }
+int lib12_f205( int x ) { return lib12_f204( x ) + 1; }
+int lib12_f206( int x ) { return lib12_f205( x ) + 1; }
+int lib12_f207( int x ) { return lib12_f206( x ) + 1; }
+int lib12_f208( int x ) { return lib12_f207( x ) + 1; }
+int lib12_f209( int x ) { return lib12_f208( x ) + 1; }
+int lib12_f210( int x ) { return lib12_f209( x ) + 1; }
+int lib12_f211( int x ) { return lib12_f210( x ) + 1; }
+int lib12_f212( int x ) { return lib12_f211( x ) + 1; }
+int lib12_f213( int x ) { return lib12_f212( x ) + 1; }
+int lib12_f214( int x ) { return lib12_f213( x ) + 1; }
+int lib12_f215( int x ) { return lib12_f214( x ) + 1; }
+int lib12_f216( int x ) { return lib12_f215( x ) + 1; }
+int lib12_f217( int x ) { return lib12_f216( x ) + 1; }
+int lib12_f218( int x ) { return lib12_f217( x ) + 1; }
+int lib12_f219( int x ) { return lib12_f218( x ) + 1; }
+int lib12_f220( int x ) { return lib12_f219( x ) + 1; }
+int lib12_f221( int x ) { return lib12_f220( x ) + 1; }
+int lib12_f222( int x ) { return lib12_f221( x ) + 1; }
+int lib12_f223( int x ) { return lib12_f222( x ) + 1; }
+int lib12_f224( int x ) { return lib12_f223( x ) + 1; }
+int lib12_f225( int x ) { return lib12_f224( x ) + 1; }
+int lib12_f226( int x ) { return lib12_f225( x ) + 1; }
+int lib12_f227( int x ) { return lib12_f226( x ) + 1; }
+int lib12_f228( int x ) { return lib12_f227( x ) + 1; }
+int lib12_f229( int x ) { return lib12_f228( x ) + 1; }
+int lib12_f230( int x ) { return lib12_f229( x ) + 1; }
+int lib12_f231( int x ) { return lib12_f230( x ) + 1; }
+int lib12_f232( int x ) { return lib12_f231( x ) + 1; }
+int lib12_f233( int x ) { return lib12_f232( x ) + 1; }
+int lib12_f234( int x ) { return lib12_f233( x ) + 1; }
+int lib12_f235( int x ) { return lib12_f234( x ) + 1; }
+int lib12_f236( int x ) { return lib12_f235( x ) + 1; }
+int lib12_f237( int x ) { return lib12_f236( x ) + 1; }
+int lib12_f238( int x ) { return lib12_f237( x ) + 1; }
+int lib12_f239( int x ) { return lib12_f238( x ) + 1; }
+int lib12_f240( int x ) { return lib12_f239( x ) + 1; }
+int lib12_f241( int x ) { return lib12_f240( x ) + 1; }
+int lib12_f242( int x ) { return lib12_f241( x ) + 1; }
+int lib12_f243( int x ) { return lib12_f242( x ) + 1; }
+int lib12_f244( int x ) { return lib12_f243( x ) + 1; }
+int lib12_f245( int x ) { return lib12_f244( x ) + 1; }
+int lib12_f246( int x ) { return lib12_f245( x ) + 1; }
+int lib12_f247( int x ) { return lib12_f246( x ) + 1; }
+int lib12_f248( int x ) { return lib12_f247( x ) + 1; }
+int lib12_f249( int x ) { return lib12_f248( x ) + 1; }
+int lib12_f250( int x ) { return lib12_f249( x ) + 1; }
+int lib12_f251( int x ) { return lib12_f250( x ) + 1; }
+int lib12_f252( int x ) { return lib12_f251( x ) + 1; }
+int lib12_f253( int x ) { return lib12_f252( x ) + 1; }
+int lib12_f254( int x ) { return lib12_f253( x ) + 1; }
+int lib12_f255( int x ) { return lib12_f254( x ) + 1; }
+EXPORT int lib12_entry( int x ) { return lib12_f255( x ); }
@@ -0,0 +1,258 @@
+#define EXPORT __attribute__((visibility("default")))
+int lib14_f0( int x ) { return x + 1; }
+int lib14_f1( int x ) { return lib14_f0( x ) + 1; }
+int lib14_f2( int x ) { return lib14_f1( x ) + 1; }
+int lib14_f3( int x ) { return lib14_f2( x ) + 1; }
+int lib14_f4( int x ) { return lib14_f3( x ) + 1; }
+int lib14_f5( int x ) { return lib14_f4( x ) + 1; }
+int lib14_f6( int x ) { return lib14_f5( x ) + 1; }
+int lib14_f7( int x ) { return lib14_f6( x ) + 1; }
+int lib14_f8( int x ) { return lib14_f7( x ) + 1; }
+int lib14_f9( int x ) { return lib14_f8( x ) + 1; }
+int lib14_f10( int x ) { return lib14_f9( x ) + 1; }
+int lib14_f11( int x ) { return lib14_f10( x ) + 1; }
+int lib14_f12( int x ) { return lib14_f11( x ) + 1; }
+int lib14_f13( int x ) { return lib14_f12( x ) + 1; }
+int lib14_f14( int x ) { return lib14_f13( x ) + 1; }
+int lib14_f15( int x ) { return lib14_f14( x ) + 1; }
+int lib14_f16( int x ) { return lib14_f15( x ) + 1; }
+int lib14_f17( int x ) { return lib14_f16( x ) + 1; }
+int lib14_f18( int x ) { return lib14_f17( x ) + 1; }
+int lib14_f19( int x ) { return lib14_f18( x ) + 1; }
+int lib14_f20( int x ) { return lib14_f19( x ) + 1; }
+int lib14_f21( int x ) { return lib14_f20( x ) + 1; }
+int lib14_f22( int x ) { return lib14_f21( x ) + 1; }
+int lib14_f23( int x ) { return lib14_f22( x ) + 1; }
+int lib14_f24( int x ) { return lib14_f23( x ) + 1; }
+int lib14_f25( int x ) { return lib14_f24( x ) + 1; }
+int lib14_f26( int x ) { return lib14_f25( x ) + 1; }
+int lib14_f27( int x ) { return lib14_f26( x ) + 1; }
+int lib14_f28( int x ) { return lib14_f27( x ) + 1; }
+int lib14_f29( int x ) { return lib14_f28( x ) + 1; }
+int lib14_f30( int x ) { return lib14_f29( x ) + 1; }
+int lib14_f31( int x ) { return lib14_f30( x ) + 1; }
+int lib14_f32( int x ) { return lib14_f31( x ) + 1; }
+int lib14_f33( int x ) { return lib14_f32( x ) + 1; }
+int lib14_f34( int x ) { return lib14_f33( x ) + 1; }
+int lib14_f35( int x ) { return lib14_f34( x ) + 1; }
+int lib14_f36( int x ) { return lib14_f35( x ) + 1; }
+int lib14_f37( int x ) { return lib14_f36( x ) + 1; }
+int lib14_f38( int x ) { return lib14_f37( x ) + 1; }
+int lib14_f39( int x ) { return lib14_f38( x ) + 1; }
+int lib14_f40( int x ) { return lib14_f39( x ) + 1; }
+int lib14_f41( int x ) { return lib14_f40( x ) + 1; }
+int lib14_f42( int x ) { return lib14_f41( x ) + 1; }
+int lib14_f43( int x ) { return lib14_f42( x ) + 1; }
+int lib14_f44( int x ) { return lib14_f43( x ) + 1; }
+int lib14_f45( int x ) { return lib14_f44( x ) + 1; }
+int lib14_f46( int x ) { return lib14_f45( x ) + 1; }
+int lib14_f47( int x ) { return lib14_f46( x ) + 1; }
+int lib14_f48( int x ) { return lib14_f47( x ) + 1; }
+int lib14_f49( int x ) { return lib14_f48( x ) + 1; }
+int lib14_f50( int x ) { return lib14_f49( x ) + 1; }
+int lib14_f51( int x ) { return lib14_f50( x ) + 1; }
+int lib14_f52( int x ) { return lib14_f51( x ) + 1; }
+int lib14_f53( int x ) { return lib14_f52( x ) + 1; }
+int lib14_f54( int x ) { return lib14_f53( x ) + 1; }
+int lib14_f55( int x ) { return lib14_f54( x ) + 1; }
+int lib14_f56( int x ) { return lib14_f55( x ) + 1; }
+int lib14_f57( int x ) { return lib14_f56( x ) + 1; }
+int lib14_f58( int x ) { return lib14_f57( x ) + 1; }
+int lib14_f59( int x ) { return lib14_f58( x ) + 1; }
+int lib14_f60( int x ) { return lib14_f59( x ) + 1; }
+int lib14_f61( int x ) { return lib14_f60( x ) + 1; }
+int lib14_f62( int x ) { return lib14_f61( x ) + 1; }
+int lib14_f63( int x ) { return lib14_f62( x ) + 1; }
+int lib14_f64( int x ) { return lib14_f63( x ) + 1; }
+int lib14_f65( int x ) { return lib14_f64( x ) + 1; }
+int lib14_f66( int x ) { return lib14_f65( x ) + 1; }
+int lib14_f67( int x ) { return lib14_f66( x ) + 1; }
+int lib14_f68( int x ) { return lib14_f67( x ) + 1; }
+int lib14_f69( int x ) { return lib14_f68( x ) + 1; }
+int lib14_f70( int x ) { return lib14_f69( x ) + 1; }
+int lib14_f71( int x ) { return lib14_f70( x ) + 1; }
+int lib14_f72( int x ) { return lib14_f71( x ) + 1; }
+int lib14_f73( int x ) { return lib14_f72( x ) + 1; }
+int lib14_f74( int x ) { return lib14_f73( x ) + 1; }
+int lib14_f75( int x ) { return lib14_f74( x ) + 1; }
+int lib14_f76( int x ) { return lib14_f75( x ) + 1; }
+int lib14_f77( int x ) { return lib14_f76( x ) + 1; }
+int lib14_f78( int x ) { return lib14_f77( x ) + 1; }
+int lib14_f79( int x ) { return lib14_f78( x ) + 1; }
+int lib14_f80( int x ) { return lib14_f79( x ) + 1; }
+int lib14_f81( int x ) { return lib14_f80( x ) + 1; }
+int lib14_f82( int x ) { return lib14_f81( x ) + 1; }
+int lib14_f83( int x ) { return lib14_f82( x ) + 1; }
+int lib14_f84( int x ) { return lib14_f83( x ) + 1; }
+int lib14_f85( int x ) { return lib14_f84( x ) + 1; }
+int lib14_f86( int x ) { return lib14_f85( x ) + 1; }
+int lib14_f87( int x ) { return lib14_f86( x ) + 1; }
+int lib14_f88( int x ) { return lib14_f87( x ) + 1; }
+int lib14_f89( int x ) { return lib14_f88( x ) + 1; }
+int lib14_f90( int x ) { return lib14_f89( x ) + 1; }
+int lib14_f91( int x ) { return lib14_f90( x ) + 1; }
+int lib14_f92( int x ) { return lib14_f91( x ) + 1; }
+int lib14_f93( int x ) { return lib14_f92( x ) + 1; }
+int lib14_f94( int x ) { return lib14_f93( x ) + 1; }
+int lib14_f95( int x ) { return lib14_f94( x ) + 1; }
+int lib14_f96( int x ) { return lib14_f95( x ) + 1; }
+int lib14_f97( int x ) { return lib14_f96( x ) + 1; }
+int lib14_f98( int x ) { return lib14_f97( x ) + 1; }
+int lib14_f99( int x ) { return lib14_f98( x ) + 1; }
+int lib14_f100( int x ) { return lib14_f99( x ) + 1; }
+int lib14_f101( int x ) { return lib14_f100( x ) + 1; }
+int lib14_f102( int x ) { return lib14_f101( x ) + 1; }
+int lib14_f103( int x ) { return lib14_f102( x ) + 1; }
+int lib14_f104( int x ) { return lib14_f103( x ) + 1; }
+int lib14_f105( int x ) { return lib14_f104( x ) + 1; }
+int lib14_f106( int x ) { return lib14_f105( x ) + 1; }
+int lib14_f107( int x ) { return lib14_f106( x ) + 1; }
+int lib14_f108( int x ) { return lib14_f107( x ) + 1; }
+int lib14_f109( int x ) { return lib14_f108( x ) + 1; }
+int lib14_f110( int x ) { return lib14_f109( x ) + 1; }
+int lib14_f111( int x ) { return lib14_f110( x ) + 1; }
+int lib14_f112( int x ) { return lib14_f111( x ) + 1; }
+int lib14_f113( int x ) { return lib14_f112( x ) + 1; }
+int lib14_f114( int x ) { return lib14_f113( x ) + 1; }
+int lib14_f115( int x ) { return lib14_f114( x ) + 1; }
+int lib14_f116( int x ) { return lib14_f115( x ) + 1; }
+int lib14_f117( int x ) { return lib14_f116( x ) + 1; }
+int lib14_f118( int x ) { return lib14_f117( x ) + 1; }
+int lib14_f119( int x ) { return lib14_f118( x ) + 1; }
+int lib14_f120( int x ) { return lib14_f119( x ) + 1; }
+int lib14_f121( int x ) { return lib14_f120( x ) + 1; }
+int lib14_f122( int x ) { return lib14_f121( x ) + 1; }
+int lib14_f123( int x ) { return lib14_f122( x ) + 1; }
+int lib14_f124( int x ) { return lib14_f123( x ) + 1; }
+int lib14_f125( int x ) { return lib14_f124( x ) + 1; }
+int lib14_f126( int x ) { return lib14_f125( x ) + 1; }
+int lib14_f127( int x ) { return lib14_f126( x ) + 1; }
+int lib14_f128( int x ) { return lib14_f127( x ) + 1; }
+int lib14_f129( int x ) { return lib14_f128( x ) + 1; }
+int lib14_f130( int x ) { return lib14_f129( x ) + 1; }
+int lib14_f131( int x ) { return lib14_f130( x ) + 1; }
+int lib14_f132( int x ) { return lib14_f131( x ) + 1; }
+int lib14_f133( int x ) { return lib14_f132( x ) + 1; }
+int lib14_f134( int x ) { return lib14_f133( x ) + 1; }
+int lib14_f135( int x ) { return lib14_f134( x ) + 1; }
+int lib14_f136( int x ) { return lib14_f135( x ) + 1; }
+int lib14_f137( int x ) { return lib14_f136( x ) + 1; }
+int lib14_f138( int x ) { return lib14_f137( x ) + 1; }
+int lib14_f139( int x ) { return lib14_f138( x ) + 1; }
+int lib14_f140( int x ) { return lib14_f139( x ) + 1; }
+int lib14_f141( int x ) { return lib14_f140( x ) + 1; }
+int lib14_f142( int x ) { return lib14_f141( x ) + 1; }
+int lib14_f143( int x ) { return lib14_f142( x ) + 1; }
+int lib14_f144( int x ) { return lib14_f143( x ) + 1; }
+int lib14_f145( int x ) { return lib14_f144( x ) + 1; }
+int lib14_f146( int x ) { return lib14_f145( x ) + 1; }
+int lib14_f147( int x ) { return lib14_f146( x ) + 1; }
+int lib14_f148( int x ) { return lib14_f147( x ) + 1; }
+int lib14_f149( int x ) { return lib14_f148( x ) + 1; }
+int lib14_f150( int x ) { return lib14_f149( x ) + 1; }
+int lib14_f151( int x ) { return lib14_f150( x ) + 1; }
+int lib14_f152( int x ) { return lib14_f151( x ) + 1; }
+int lib14_f153( int x ) { return lib14_f152( x ) + 1; }
+int lib14_f154( int x ) { return lib14_f153( x ) + 1; }
+int lib14_f155( int x ) { return lib14_f154( x ) + 1; }
+int lib14_f156( int x ) { return lib14_f155( x ) + 1; }
+int lib14_f157( int x ) { return lib14_f156( x ) + 1; }
+int lib14_f158( int x ) { return lib14_f157( x ) + 1; }
+int lib14_f159( int x ) { return lib14_f158( x ) + 1; }
+int lib14_f160( int x ) { return lib14_f159( x ) + 1; }
+int lib14_f161( int x ) { return lib14_f160( x ) + 1; }
+int lib14_f162( int x ) { return lib14_f161( x ) + 1; }
+int lib14_f163( int x ) { return lib14_f162( x ) + 1; }
+int lib14_f164( int x ) { return lib14_f163( x ) + 1; }
+int lib14_f165( int x ) { return lib14_f164( x ) + 1; }
+int lib14_f166( int x ) { return lib14_f165( x ) + 1; }
+int lib14_f167( int x ) { return lib14_f166( x ) + 1; }
+int lib14_f168( int x ) { return lib14_f167( x ) + 1; }
+int lib14_f169( int x ) { return lib14_f168( x ) + 1; }
+int lib14_f170( int x ) { return lib14_f169( x ) + 1; }
+int lib14_f171( int x ) { return lib14_f170( x ) + 1; }
+int lib14_f172( int x ) { return lib14_f171( x ) + 1; }
+int lib14_f173( int x ) { return lib14_f172( x ) + 1; }
+int lib14_f174( int x ) { return lib14_f173( x ) + 1; }
+int lib14_f175( int x ) { return lib14_f174( x ) + 1; }
+int lib14_f176( int x ) { return lib14_f175( x ) + 1; }
+int lib14_f177( int x ) { return lib14_f176( x ) + 1; }
+int lib14_f178( int x ) { return lib14_f177( x ) + 1; }
+int lib14_f179( int x ) { return lib14_f178( x ) + 1; }
+int lib14_f180( int x ) { return lib14_f179( x ) + 1; }
+int lib14_f181( int x ) { return lib14_f180( x ) + 1; }
+int lib14_f182( int x ) { return lib14_f181( x ) + 1; }
+int lib14_f183( int x ) { return lib14_f182( x ) + 1; }
+int lib14_f184( int x ) { return lib14_f183( x ) + 1; }
+int lib14_f185( int x ) { return lib14_f184( x ) + 1; }
+int lib14_f186( int x ) { return lib14_f185( x ) + 1; }
+int lib14_f187( int x ) { return lib14_f186( x ) + 1; }
+int lib14_f188( int x ) { return lib14_f187( x ) + 1; }
+int lib14_f189( int x ) { return lib14_f188( x ) + 1; }
+int lib14_f190( int x ) { return lib14_f189( x ) + 1; }
+int lib14_f191( int x ) { return lib14_f190( x ) + 1; }
+int lib14_f192( int x ) { return lib14_f191( x ) + 1; }
+int lib14_f193( int x ) { return lib14_f192( x ) + 1; }
+int lib14_f194( int x ) { return lib14_f193( x ) + 1; }
+int lib14_f195( int x ) { return lib14_f194( x ) + 1; }
+int lib14_f196( int x ) { return lib14_f195( x ) + 1; }
+int lib14_f197( int x ) { return lib14_f196( x ) + 1; }
+int lib14_f198( int x ) { return lib14_f197( x ) + 1; }
+int lib14_f199( int x ) { return lib14_f198( x ) + 1; }
+int lib14_f200( int x ) { return lib14_f199( x ) + 1; }
+int lib14_f201( int x ) { return lib14_f200( x ) + 1; }
+int lib14_f202( int x ) { return lib14_f201( x ) + 1; }
+int lib14_f203( int x ) { return lib14_f202( x ) + 1; }
+int lib14_f204( int x ) { return lib14_f203( x ) + 1; }
+int lib14_f205( int x ) { return lib14_f204( x ) + 1; }
+int lib14_f206( int x ) { return lib14_f205( x ) + 1; }
+int lib14_f207( int x ) { return lib14_f206( x ) + 1; }
+int lib14_f208( int x ) { return lib14_f207( x ) + 1; }
+int lib14_f209( int x ) { return lib14_f208( x ) + 1; }
+int lib14_f210( int x ) { return lib14_f209( x ) + 1; }
+int lib14_f211( int x ) { return lib14_f210( x ) + 1; }
+int lib14_f212( int x ) { return lib14_f211( x ) + 1; }
+int lib14_f213( int x ) { return lib14_f212( x ) + 1; }
+int lib14_f214( int x ) { return lib14_f213( x ) + 1; }
+int lib14_f215( int x ) { return lib14_f214( x ) + 1; }
+int lib14_f216( int x ) { return lib14_f215( x ) + 1; }
+int lib14_f217( int x ) { return lib14_f216( x ) + 1; }
+int lib14_f218( int x ) { return lib14_f217( x ) + 1; }
+int lib14_f219( int x ) { return lib14_f218( x ) + 1; }
+int lib14_f220( int x ) { return lib14_f219( x ) + 1; }
+int lib14_f221( int x ) { return lib14_f220( x ) + 1; }
+int lib14_f222( int x ) { return lib14_f221( x ) + 1; }
+int lib14_f223( int x ) { return lib14_f222( x ) + 1; }
+int lib14_f224( int x ) { return lib14_f223( x ) + 1; }
+int lib14_f225( int x ) { return lib14_f224( x ) + 1; }
+int lib14_f226( int x ) { return lib14_f225( x ) + 1; }
+int lib14_f227( int x ) { return lib14_f226( x ) + 1; }
+int lib14_f228( int x ) { return lib14_f227( x ) + 1; }
+int lib14_f229( int x ) { return lib14_f228( x ) + 1; }
+int lib14_f230( int x ) { return lib14_f229( x ) + 1; }
+int lib14_f231( int x ) { return lib14_f230( x ) + 1; }
+int lib14_f232( int x ) { return lib14_f231( x ) + 1; }
+int lib14_f233( int x ) { return lib14_f232( x ) + 1; }
+int lib14_f234( int x ) { return lib14_f233( x ) + 1; }
+int lib14_f235( int x ) { return lib14_f234( x ) + 1; }
+int lib14_f236( int x ) { return lib14_f235( x ) + 1; }
+int lib14_f237( int x ) { return lib14_f236( x ) + 1; }
+int lib14_f238( int x ) { return lib14_f237( x ) + 1; }
+int lib14_f239( int x ) { return lib14_f238( x ) + 1; }
+int lib14_f240( int x ) { return lib14_f239( x ) + 1; }
+int lib14_f241( int x ) { return lib14_f240( x ) + 1; }
+int lib14_f242( int x ) { return lib14_f241( x ) + 1; }
+int lib14_f243( int x ) { return lib14_f242( x ) + 1; }
+int lib14_f244( int x ) { return lib14_f243( x ) + 1; }
+int lib14_f245( int x ) { return lib14_f244( x ) + 1; }
+int lib14_f246( int x ) { return lib14_f245( x ) + 1; }
+int lib14_f247( int x ) { return lib14_f246( x ) + 1; }
+int lib14_f248( int x ) { return lib14_f247( x ) + 1; }
+int lib14_f249( int x ) { return lib14_f248( x ) + 1; }
+int lib14_f250( int x ) { return lib14_f249( x ) + 1; }
+int lib14_f251( int x ) { return lib14_f250( x ) + 1; }
+int lib14_f252( int x ) { return lib14_f251( x ) + 1; }
+int lib14_f253( int x ) { return lib14_f252( x ) + 1; }
+int lib14_f254( int x ) { return lib14_f253( x ) + 1; }
+int lib14_f255( int x ) { return lib14_f254( x ) + 1; }
+EXPORT int lib14_entry( int x ) { return lib14_f255( x ); }
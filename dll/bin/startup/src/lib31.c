@@ -0,0 +1,258 @@
+#define EXPORT __attribute__((visibility("default")))
+int lib31_f0( int x ) { return x + 1; }
+int lib31_f1( int x ) { return lib31_f0( x ) + 1; }
+int lib31_f2( int x ) { return lib31_f1( x ) + 1; }
+int lib31_f3( int x ) { return lib31_f2( x ) + 1; }
+int lib31_f4( int x ) { return lib31_f3( x ) + 1; }
+int lib31_f5( int x ) { return lib31_f4( x ) + 1; }
+int lib31_f6( int x ) { return lib31_f5( x ) + 1; }
+int lib31_f7( int x ) { return lib31_f6( x ) + 1; }
+int lib31_f8( int x ) { return lib31_f7( x ) + 1; }
+int lib31_f9( int x ) { return lib31_f8( x ) + 1; }
+int lib31_f10( int x ) { return lib31_f9( x ) + 1; }
+int lib31_f11( int x ) { return lib31_f10( x ) + 1; }
+int lib31_f12( int x ) { return lib31_f11( x ) + 1; }
+int lib31_f13( int x ) { return lib31_f12( x ) + 1; }
+int lib31_f14( int x ) { return lib31_f13( x ) + 1; }
+int lib31_f15( int x ) { return lib31_f14( x ) + 1; }
+int lib31_f16( int x ) { return lib31_f15( x ) + 1; }
+int lib31_f17( int x ) { return lib31_f16( x ) + 1; }
+int lib31_f18( int x ) { return lib31_f17( x ) + 1; }
+int lib31_f19( int x ) { return lib31_f18( x ) + 1; }
+int lib31_f20( int x ) { return lib31_f19( x ) + 1; }
+int lib31_f21( int x ) { return lib31_f20( x ) + 1; }
+int lib31_f22( int x ) { return lib31_f21( x ) + 1; }
+int lib31_f23( int x ) { return lib31_f22( x ) + 1; }
+int lib31_f24( int x ) { return lib31_f23( x ) + 1; }
+int lib31_f25( int x ) { return lib31_f24( x ) + 1; }
+int lib31_f26( int x ) { return lib31_f25( x ) + 1; }
+int lib31_f27( int x ) { return lib31_f26( x ) + 1; }
+int lib31_f28( int x ) { return lib31_f27( x ) + 1; }
+int lib31_f29( int x ) { return lib31_f28( x ) + 1; }
+int lib31_f30( int x ) { return lib31_f29( x ) + 1; }
+int lib31_f31( int x ) { return lib31_f30( x ) + 1; }
+int lib31_f32( int x ) { return lib31_f31( x ) + 1; }
+int lib31_f33( int x ) { return lib31_f32( x ) + 1; }
+int lib31_f34( int x ) { return lib31_f33( x ) + 1; }
+int lib31_f35( int x ) { return lib31_f34( x ) + 1; }
+int lib31_f36( int x ) { return lib31_f35( x ) + 1; }
+int lib31_f37( int x ) { return lib31_f36( x ) + 1; }
+int lib31_f38( int x ) { return lib31_f37( x ) + 1; }
+int lib31_f39( int x ) { return lib31_f38( x ) + 1; }
+int lib31_f40( int x ) { return lib31_f39( x ) + 1; }
+int lib31_f41( int x ) { return lib31_f40( x ) + 1; }
+int lib31_f42( int x ) { return lib31_f41( x ) + 1; }
+int lib31_f43( int x ) { return lib31_f42( x ) + 1; }
+int lib31_f44( int x ) { return lib31_f43( x ) + 1; }
+int lib31_f45( int x ) { return lib31_f44( x ) + 1; }
+int lib31_f46( int x ) { return lib31_f45( x ) + 1; }
+int lib31_f47( int x ) { return lib31_f46( x ) + 1; }
+int lib31_f48( int x ) { return lib31_f47( x ) + 1; }
+int lib31_f49( int x ) { return lib31_f48( x ) + 1; }
+int lib31_f50( int x ) { return lib31_f49( x ) + 1; }
+int lib31_f51( int x ) { return lib31_f50( x ) + 1; }
+int lib31_f52( int x ) { return lib31_f51( x ) + 1; }
+int lib31_f53( int x ) { return lib31_f52( x ) + 1; }
+int lib31_f54( int x ) { return lib31_f53( x ) + 1; }
+int lib31_f55( int x ) { return lib31_f54( x ) + 1; }
+int lib31_f56( int x ) { return lib31_f55( x ) + 1; }
+int lib31_f57( int x ) { return lib31_f56( x ) + 1; }
+int lib31_f58( int x ) { return lib31_f57( x ) + 1; }
+int lib31_f59( int x ) { return lib31_f58( x ) + 1; }
+int lib31_f60( int x ) { return lib31_f59( x ) + 1; }
+int lib31_f61( int x ) { return lib31_f60( x ) + 1; }
+int lib31_f62( int x ) { return lib31_f61( x ) + 1; }
+int lib31_f63( int x ) { return lib31_f62( x ) + 1; }
+int lib31_f64( int x ) { return lib31_f63( x ) + 1; }
+int lib31_f65( int x ) { return lib31_f64( x ) + 1; }
+int lib31_f66( int x ) { return lib31_f65( x ) + 1; }
+int lib31_f67( int x ) { return lib31_f66( x ) + 1; }
+int lib31_f68( int x ) { return lib31_f67( x ) + 1; }
+int lib31_f69( int x ) { return lib31_f68( x ) + 1; }
+int lib31_f70( int x ) { return lib31_f69( x ) + 1; }
+int lib31_f71( int x ) { return lib31_f70( x ) + 1; }
+int lib31_f72( int x ) { return lib31_f71( x ) + 1; }
+int lib31_f73( int x ) { return lib31_f72( x ) + 1; }
+int lib31_f74( int x ) { return lib31_f73( x ) + 1; }
+int lib31_f75( int x ) { return lib31_f74( x ) + 1; }
+int lib31_f76( int x ) { return lib31_f75( x ) + 1; }
+int lib31_f77( int x ) { return lib31_f76( x ) + 1; }
+int lib31_f78( int x ) { return lib31_f77( x ) + 1; }
+int lib31_f79( int x ) { return lib31_f78( x ) + 1; }
+int lib31_f80( int x ) { return lib31_f79( x ) + 1; }
+int lib31_f81( int x ) { return lib31_f80( x ) + 1; }
+int lib31_f82( int x ) { return lib31_f81( x ) + 1; }
+int lib31_f83( int x ) { return lib31_f82( x ) + 1; }
+int lib31_f84( int x ) { return lib31_f83( x ) + 1; }
+int lib31_f85( int x ) { return lib31_f84( x ) + 1; }
+int lib31_f86( int x ) { return lib31_f85( x ) + 1; }
+int lib31_f87( int x ) { return lib31_f86( x ) + 1; }
+int lib31_f88( int x ) { return lib31_f87( x ) + 1; }
+int lib31_f89( int x ) { return lib31_f88( x ) + 1; }
+int lib31_f90( int x ) { return lib31_f89( x ) + 1; }
+int lib31_f91( int x ) { return lib31_f90( x ) + 1; }
+int lib31_f92( int x ) { return lib31_f91( x ) + 1; }
+int lib31_f93( int x ) { return lib31_f92( x ) + 1; }
+int lib31_f94( int x ) { return lib31_f93( x ) + 1; }
+int lib31_f95( int x ) { return lib31_f94( x ) + 1; }
+int lib31_f96( int x ) { return lib31_f95( x ) + 1; }
+int lib31_f97( int x ) { return lib31_f96( x ) + 1; }
+int lib31_f98( int x ) { return lib31_f97( x ) + 1; }
+int lib31_f99( int x ) { return lib31_f98( x ) + 1; }
+int lib31_f100( int x ) { return lib31_f99( x ) + 1; }
+int lib31_f101( int x ) { return lib31_f100( x ) + 1; }
+int lib31_f102( int x ) { return lib31_f101( x ) + 1; }
+int lib31_f103( int x ) { return lib31_f102( x ) + 1; }
+int lib31_f104( int x ) { return lib31_f103( x ) + 1; }
+int lib31_f105( int x ) { return lib31_f104( x ) + 1; }
+int lib31_f106( int x ) { return lib31_f105( x ) + 1; }
+int lib31_f107( int x ) { return lib31_f106( x ) + 1; }
+int lib31_f108( int x ) { return lib31_f107( x ) + 1; }
+int lib31_f109( int x ) { return lib31_f108( x ) + 1; }
+int lib31_f110( int x ) { return lib31_f109( x ) + 1; }
+int lib31_f111( int x ) { return lib31_f110( x ) + 1; }
+int lib31_f112( int x ) { return lib31_f111( x ) + 1; }
+int lib31_f113( int x ) { return lib31_f112( x ) + 1; }
+int lib31_f114( int x ) { return lib31_f113( x ) + 1; }
+int lib31_f115( int x ) { return lib31_f114( x ) + 1; }
+int lib31_f116( int x ) { return lib31_f115( x ) + 1; }
+int lib31_f117( int x ) { return lib31_f116( x ) + 1; }
+int lib31_f118( int x ) { return lib31_f117( x ) + 1; }
+int lib31_f119( int x ) { return lib31_f118( x ) + 1; }
+int lib31_f120( int x ) { return lib31_f119( x ) + 1; }
+int lib31_f121( int x ) { return lib31_f120( x ) + 1; }
+int lib31_f122( int x ) { return lib31_f121( x ) + 1; }
+int lib31_f123( int x ) { return lib31_f122( x ) + 1; }
+int lib31_f124( int x ) { return lib31_f123( x ) + 1; }
+int lib31_f125( int x ) { return lib31_f124( x ) + 1; }
+int lib31_f126( int x ) { return lib31_f125( x ) + 1; }
+int lib31_f127( int x ) { return lib31_f126( x ) + 1; }
+int lib31_f128( int x ) { return lib31_f127( x ) + 1; }
+int lib31_f129( int x ) { return lib31_f128( x ) + 1; }
+int lib31_f130( int x ) { return lib31_f129( x ) + 1; }
+int lib31_f131( int x ) { return lib31_f130( x ) + 1; }
+int lib31_f132( int x ) { return lib31_f131( x ) + 1; }
+int lib31_f133( int x ) { return lib31_f132( x ) + 1; }
+int lib31_f134( int x ) { return lib31_f133( x ) + 1; }
+int lib31_f135( int x ) { return lib31_f134( x ) + 1; }
+int lib31_f136( int x ) { return lib31_f135( x ) + 1; }
+int lib31_f137( int x ) { return lib31_f136( x ) + 1; }
+int lib31_f138( int x ) { return lib31_f137( x ) + 1; }
+int lib31_f139( int x ) { return lib31_f138( x ) + 1; }
+int lib31_f140( int x ) { return lib31_f139( x ) + 1; }
+int lib31_f141( int x ) { return lib31_f140( x ) + 1; }
+int lib31_f142( int x ) { return lib31_f141( x ) + 1; }
+int lib31_f143( int x ) { return lib31_f142( x ) + 1; }
+int lib31_f144( int x ) { return lib31_f143( x ) + 1; }
+int lib31_f145( int x ) { return lib31_f144( x ) + 1; }
+int lib31_f146( int x ) { return lib31_f145( x ) + 1; }
+int lib31_f147( int x ) { return lib31_f146( x ) + 1; }
+int lib31_f148( int x ) { return lib31_f147( x ) + 1; }
+int lib31_f149( int x ) { return lib31_f148( x ) + 1; }
+int lib31_f150( int x ) { return lib31_f149( x ) + 1; }
+int lib31_f151( int x ) { return lib31_f150( x ) + 1; }
+int lib31_f152( int x ) { return lib31_f151( x ) + 1; }
+int lib31_f153( int x ) { return lib31_f152( x ) + 1; }
+int lib31_f154( int x ) { return lib31_f153( x ) + 1; }
+int lib31_f155( int x ) { return lib31_f154( x ) + 1; }
+int lib31_f156( int x ) { return lib31_f155( x ) + 1; }
+int lib31_f157( int x ) { return lib31_f156( x ) + 1; }
+int lib31_f158( int x ) { return lib31_f157( x ) + 1; }
+int lib31_f159( int x ) { return lib31_f158( x ) + 1; }
+int lib31_f160( int x ) { return lib31_f159( x ) + 1; }
+int lib31_f161( int x ) { return lib31_f160( x ) + 1; }
+int lib31_f162( int x ) { return lib31_f161( x ) + 1; }
+int lib31_f163( int x ) { return lib31_f162( x ) + 1; }
+int lib31_f164( int x ) { return lib31_f163( x ) + 1; }
+int lib31_f165( int x ) { return lib31_f164( x ) + 1; }
+int lib31_f166( int x ) { return lib31_f165( x ) + 1; }
+int lib31_f167( int x ) { return lib31_f166( x ) + 1; }
+int lib31_f168( int x ) { return lib31_f167( x ) + 1; }
+int lib31_f169( int x ) { return lib31_f168( x ) + 1; }
+int lib31_f170( int x ) { return lib31_f169( x ) + 1; }
+int lib31_f171( int x ) { return lib31_f170( x ) + 1; }
+int lib31_f172( int x ) { return lib31_f171( x ) + 1; }
+int lib31_f173( int x ) { return lib31_f172( x ) + 1; }
+int lib31_f174( int x ) { return lib31_f173( x ) + 1; }
+int lib31_f175( int x ) { return lib31_f174( x ) + 1; }
+int lib31_f176( int x ) { return lib31_f175( x ) + 1; }
+int lib31_f177( int x ) { return lib31_f176( x ) + 1; }
+int lib31_f178( int x ) { return lib31_f177( x ) + 1; }
+int lib31_f179( int x ) { return lib31_f178( x ) + 1; }
+int lib31_f180( int x ) { return lib31_f179( x ) + 1; }
+int lib31_f181( int x ) { return lib31_f180( x ) + 1; }
+int lib31_f182( int x ) { return lib31_f181( x ) + 1; }
+int lib31_f183( int x ) { return lib31_f182( x ) + 1; }
+int lib31_f184( int x ) { return lib31_f183( x ) + 1; }
+int lib31_f185( int x ) { return lib31_f184( x ) + 1; }
+int lib31_f186( int x ) { return lib31_f185( x ) + 1; }
+int lib31_f187( int x ) { return lib31_f186( x ) + 1; }
+int lib31_f188( int x ) { return lib31_f187( x ) + 1; }
+int lib31_f189( int x ) { return lib31_f188( x ) + 1; }
+int lib31_f190( int x ) { return lib31_f189( x ) + 1; }
+int lib31_f191( int x ) { return lib31_f190( x ) + 1; }
+int lib31_f192( int x ) { return lib31_f191( x ) + 1; }
+int lib31_f193( int x ) { return lib31_f192( x ) + 1; }
+int lib31_f194( int x ) { return lib31_f193( x ) + 1; }
+int lib31_f195( int x ) { return lib31_f194( x ) + 1; }
+int lib31_f196( int x ) { return lib31_f195( x ) + 1; }
+int lib31_f197( int x ) { return lib31_f196( x ) + 1; }
+int lib31_f198( int x ) { return lib31_f197( x ) + 1; }
+int lib31_f199( int x ) { return lib31_f198( x ) + 1; }
+int lib31_f200( int x ) { return lib31_f199( x ) + 1; }
+int lib31_f201( int x ) { return lib31_f200( x ) + 1; }
+int lib31_f202( int x ) { return lib31_f201( x ) + 1; }
+int lib31_f203( int x ) { return lib31_f202( x ) + 1; }
+int lib31_f204( int x ) { return lib31_f203( x ) + 1; }
+int lib31_f205( int x ) { return lib31_f204( x ) + 1; }
+int lib31_f206( int x ) { return lib31_f205( x ) + 1; }
+int lib31_f207( int x ) { return lib31_f206( x ) + 1; }
+int lib31_f208( int x ) { return lib31_f207( x ) + 1; }
+int lib31_f209( int x ) { return lib31_f208( x ) + 1; }
+int lib31_f210( int x ) { return lib31_f209( x ) + 1; }
+int lib31_f211( int x ) { return lib31_f210( x ) + 1; }
+int lib31_f212( int x ) { return lib31_f211( x ) + 1; }
+int lib31_f213( int x ) { return lib31_f212( x ) + 1; }
+int lib31_f214( int x ) { return lib31_f213( x ) + 1; }
+int lib31_f215( int x ) { return lib31_f214( x ) + 1; }
+int lib31_f216( int x ) { return lib31_f215( x ) + 1; }
+int lib31_f217( int x ) { return lib31_f216( x ) + 1; }
+int lib31_f218( int x ) { return lib31_f217( x ) + 1; }
+int lib31_f219( int x ) { return lib31_f218( x ) + 1; }
+int lib31_f220( int x ) { return lib31_f219( x ) + 1; }
+int lib31_f221( int x ) { return lib31_f220( x ) + 1; }
+int lib31_f222( int x ) { return lib31_f221( x ) + 1; }
+int lib31_f223( int x ) { return lib31_f222( x ) + 1; }
+int lib31_f224( int x ) { return lib31_f223( x ) + 1; }
+int lib31_f225( int x ) { return lib31_f224( x ) + 1; }
+int lib31_f226( int x ) { return lib31_f225( x ) + 1; }
+int lib31_f227( int x ) { return lib31_f226( x ) + 1; }
+int lib31_f228( int x ) { return lib31_f227( x ) + 1; }
+int lib31_f229( int x ) { return lib31_f228( x ) + 1; }
+int lib31_f230( int x ) { return lib31_f229( x ) + 1; }
+int lib31_f231( int x ) { return lib31_f230( x ) + 1; }
+int lib31_f232( int x ) { return lib31_f231( x ) + 1; }
+int lib31_f233( int x ) { return lib31_f232( x ) + 1; }
+int lib31_f234( int x ) { return lib31_f233( x ) + 1; }
+int lib31_f235( int x ) { return lib31_f234( x ) + 1; }
+int lib31_f236( int x ) { return lib31_f235( x ) + 1; }
+int lib31_f237( int x ) { return lib31_f236( x ) + 1; }
+int lib31_f238( int x ) { return lib31_f237( x ) + 1; }
+int lib31_f239( int x ) { return lib31_f238( x ) + 1; }
+int lib31_f240( int x ) { return lib31_f239( x ) + 1; }
+int lib31_f241( int x ) { return lib31_f240( x ) + 1; }
+int lib31_f242( int x ) { return lib31_f241( x ) + 1; }
+int lib31_f243( int x ) { return lib31_f242( x ) + 1; }
+int lib31_f244( int x ) { return lib31_f243( x ) + 1; }
+int lib31_f245( int x ) { return lib31_f244( x ) + 1; }
+int lib31_f246( int x ) { return lib31_f245( x ) + 1; }
+int lib31_f247( int x ) { return lib31_f246( x ) + 1; }
+int lib31_f248( int x ) { return lib31_f247( x ) + 1; }
+int lib31_f249( int x ) { return lib31_f248( x ) + 1; }
+int lib31_f250( int x ) { return lib31_f249( x ) + 1; }
+int lib31_f251( int x ) { return lib31_f250( x ) + 1; }
+int lib31_f252( int x ) { return lib31_f251( x ) + 1; }
+int lib31_f253( int x ) { return lib31_f252( x ) + 1; }
+int lib31_f254( int x ) { return lib31_f253( x ) + 1; }
+int lib31_f255( int x ) { return lib31_f254( x ) + 1; }
+EXPORT int lib31_entry( int x ) { return lib31_f255( x ); }
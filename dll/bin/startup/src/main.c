@@ -0,0 +1,26 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+extern int lib0_entry( int x );
+extern int lib1_entry( int x );
+extern int lib2_entry( int x );
+extern int lib3_entry( int x );
+static long long now( void ) {
+    struct timespec t;
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+int main( int argc, char** argv ) {
+    long long at_main = now(), after_call;
+    long long start = argc > 1 ? atoll( argv[1] ) : at_main;
+    int v = lib0_entry( argc );
+    after_call = now();
+    /* every library is used, not only loaded */
+    if (argc > 2) {
+        v += lib1_entry( v );
+        v += lib2_entry( v );
+        v += lib3_entry( v );
+    }
+    printf( "%lld %lld %d\n", at_main - start, after_call - start, v );
+    return 0;
+}
@@ -1,16 +1,24 @@
 #!/bin/sh
 
+# build modes, comma separated (see modes.sh), e.g.
+# $ ./build.sh hidden,symbolic,now,noplt
+. ./modes.sh
+set_modes "${1:-default}" || exit 1
+
 # create bin dir if not exists
 mkdir -p bin
 
 # creating object file for the main part
-gcc -c  -o bin/mainlib.o mainlib.c
-# creating object file for the library
-gcc -c -fPIC -o bin/dynlib.o  dynlib.c
+gcc -c $MAIN_CFLAGS -o bin/mainlib.o mainlib.c
+# creating object files for the library (libsum uses
+# array_sum kernels of ../syntax)
+gcc -c $LIB_CFLAGS -I../syntax -o bin/dynlib.o  dynlib.c
+gcc -c $LIB_CFLAGS -o bin/array_sum_kernels.o ../syntax/array_sum_kernels.c
 # creating dynamic library itself
-gcc -o bin/dynlib.so -shared bin/dynlib.o 
+gcc -o bin/dynlib.so -shared $LIB_LDFLAGS $(export_flags dynlib.map) \
+    bin/dynlib.o bin/array_sum_kernels.o
 # creating an executable and linking it with the dynamic library
-gcc -o bin/main  bin/mainlib.o bin/dynlib.so
+gcc -o bin/main $MAIN_LDFLAGS bin/mainlib.o bin/dynlib.so
 
 
 # libraries are searched for in /lib/
@@ -27,3 +35,34 @@ ldd ./bin/main
 # run
 echo "Running ./bin/main"
 ./bin/main
+# libsum variant forced, instead of the one for this CPU
+echo "Running DYNLIB_SUM=scalar ./bin/main"
+DYNLIB_SUM=scalar ./bin/main
+
+
+
+# plugins: loaded at run time by plugin.c (see plugin.h),
+# plugin_v2.so stands for a rebuilt plugin.so
+build_plugins() {
+    gcc -c -fPIC -DGENERATION=1 -o bin/plugin_demo.o plugin_demo.c
+    gcc -o bin/plugin.so -shared bin/plugin_demo.o
+    gcc -c -fPIC -DGENERATION=2 -o bin/plugin_demo_v2.o plugin_demo.c
+    gcc -o bin/plugin_v2.so -shared bin/plugin_demo_v2.o
+}
+gcc -o bin/plugin_host plugin_host.c plugin.c -ldl
+build_plugins
+
+echo "Running ./bin/plugin_host (reloads plugin.so)"
+./bin/plugin_host ./bin
+# host moved plugin_v2.so over plugin.so, build both again
+build_plugins
+
+# call and reload costs, optimized, results as JSON:
+# $ ./bin/bench_plugin ./bin > bench_plugin.json
+gcc -O2 -I../syntax -o bin/bench_plugin bench_plugin.c plugin.c \
+    ../syntax/bench.c bin/dynlib.so -Wl,-rpath,'$ORIGIN' -ldl -pthread
+
+# libsum resolved at load (IFUNC) against check per call:
+# $ ./bin/bench_ifunc > bench_ifunc.json
+gcc -O2 -I../syntax -o bin/bench_ifunc bench_ifunc.c \
+    ../syntax/bench.c bin/dynlib.so -Wl,-rpath,'$ORIGIN'
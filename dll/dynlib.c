@@ -6,14 +6,178 @@
  * -c -> compile
  * -fPIC -> format Position Independent Code
  * -shared -> creates dll executable
+ *
+ * libsum needs the kernels of ../syntax (see build.sh):
+ * $ gcc -c -fPIC -I../syntax -o dynlib.o dynlib.c
+ * $ gcc -c -fPIC -o array_sum_kernels.o ../syntax/array_sum_kernels.c
+ * $ gcc -o dynlib.so -shared dynlib.o array_sum_kernels.o
  */
 #include <stdio.h>
+#include <stdlib.h>
+/* for: getenv */
+#include <string.h>
+/* for: strcmp, strncmp */
+#include <fcntl.h>
+/* for: open */
+#include <unistd.h>
+/* for: read, close */
+#include "array_sum.h"
 
 /* declare using data from other module */
 extern int global;
 
+/* 
+ * Public functions stay exported when built with
+ * -fvisibility=hidden (hidden mode of build.sh),
+ * dynlib.map lists the same names.
+ */
+#define DYNLIB_EXPORT __attribute__((visibility("default")))
 
-void libfun(int value) {
+
+DYNLIB_EXPORT void libfun(int value) {
     printf( "param: %d\n", value );
     printf( "global: %d\n", global );
-}
\ No newline at end of file
+}
+
+/* cheap call, for measuring cost of the call itself */
+DYNLIB_EXPORT int libnext(int value) {
+    return value + 1;
+}
+
+
+/* 
+ * libsum: array_sum (same contract) selected for the CPU
+ * once, when the library is loaded.
+ *
+ * libsum is a GNU indirect function (IFUNC): the dynamic
+ * loader calls resolve_libsum while relocating, and stores
+ * address it returns in GOT, so a call is a plain call
+ * through PLT, no check per call. &libsum is the selected
+ * function itself.
+ *
+ * DYNLIB_SUM=scalar|avx2|avx512 forces a variant (for tests),
+ * unsupported or unknown one falls back to the best. Resolver
+ * runs before constructors of the library, so it only calls
+ * libc/libgcc (relocated before) and takes addresses of static
+ * functions (no relocation needed). When bound at load time
+ * (-z now, or address taken) it runs even before libc has set
+ * environ, see early_getenv.
+ */
+typedef int (libsum_fn)(int const* array, size_t count);
+
+static char const* libsum_name = "none";
+
+static int sum_with(array_sum_kernel* acc, int const* array, size_t count) {
+    int sum = 0;
+
+    if (array == NULL || !acc(array, count, &sum))
+        return -1;
+    return sum;
+}
+
+static int libsum_scalar(int const* array, size_t count) {
+    return sum_with(array_sum_acc_scalar, array, count);
+}
+
+static int libsum_avx2(int const* array, size_t count) {
+    return sum_with(array_sum_acc_avx2, array, count);
+}
+
+static int libsum_avx512(int const* array, size_t count) {
+    return sum_with(array_sum_acc_avx512, array, count);
+}
+
+static struct {
+    char const* name;
+    enum array_sum_isa isa;
+    libsum_fn* fn;
+} const libsum_variants[] = {
+    {"avx512", ARRAY_SUM_ISA_AVX512, libsum_avx512},
+    {"avx2",   ARRAY_SUM_ISA_AVX2,   libsum_avx2},
+    {"scalar", ARRAY_SUM_ISA_C,      libsum_scalar}
+};
+#define LIBSUM_VARIANTS (sizeof libsum_variants / sizeof libsum_variants[0])
+
+/* 
+ * Not array_sum_supported: a call to other function of the
+ * library may go through PLT not relocated yet.
+ */
+static int libsum_supported(size_t i) {
+    switch (libsum_variants[i].isa) {
+#if defined(__x86_64__) || defined(__i386__)
+        case ARRAY_SUM_ISA_AVX512: return __builtin_cpu_supports( "avx512f" );
+        case ARRAY_SUM_ISA_AVX2:   return __builtin_cpu_supports( "avx2" );
+#endif
+        case ARRAY_SUM_ISA_C:      return 1;
+        default:                   return 0;
+    }
+}
+
+/* set by libc initialization, NULL until then */
+extern char** environ;
+
+/* 
+ * getenv, or value read from /proc/self/environ (first 4 KiB)
+ * while environ is not set yet. Value stays valid after.
+ */
+static char const* early_getenv(char const* name) {
+    static char buffer[4096];
+    size_t length = strlen( name );
+    ssize_t got;
+    char* p;
+    int fd;
+
+    if (environ != NULL)
+        return getenv( name );
+    fd = open( "/proc/self/environ", O_RDONLY );
+    if (fd < 0)
+        return NULL;
+    got = read( fd, buffer, sizeof buffer - 1 );
+    close( fd );
+    if (got <= 0)
+        return NULL;
+    buffer[got] = '\0';
+    for( p = buffer; p < buffer + got; p += strlen( p ) + 1 )
+        if (strncmp( p, name, length ) == 0 && p[length] == '=')
+            return p + length + 1;
+    return NULL;
+}
+
+static libsum_fn* resolve_libsum(void) {
+    char const* forced = early_getenv( "DYNLIB_SUM" );
+    size_t i;
+
+#if defined(__x86_64__) || defined(__i386__)
+    /* resolvers run before libgcc initializes CPU model */
+    __builtin_cpu_init();
+#endif
+    for( i = 0; forced != NULL && i < LIBSUM_VARIANTS; i++ )
+        if (strcmp( forced, libsum_variants[i].name ) == 0 && libsum_supported( i )) {
+            libsum_name = libsum_variants[i].name;
+            return libsum_variants[i].fn;
+        }
+    for( i = 0; !libsum_supported( i ); i++ )
+        ;
+    libsum_name = libsum_variants[i].name;
+    return libsum_variants[i].fn;
+}
+
+DYNLIB_EXPORT int libsum(int const* array, size_t count)
+    __attribute__((ifunc("resolve_libsum")));
+
+/* name of variant libsum resolved to */
+DYNLIB_EXPORT char const* libsum_variant(void) {
+    return libsum_name;
+}
+
+/* 
+ * Same sum, variant chosen on every call: what libsum saves
+ * (for bench_ifunc).
+ */
+DYNLIB_EXPORT int libsum_dispatch(int const* array, size_t count) {
+    size_t i;
+
+    for( i = 0; !libsum_supported( i ); i++ )
+        ;
+    return libsum_variants[i].fn( array, count );
+}
@@ -5,13 +5,25 @@
  * 
  */
 
+#include <stdio.h>
+#include <stddef.h>
 
 /* declare using function from other module */
 extern void libfun( int value );
+/* CPU specific, chosen at load (DYNLIB_SUM=scalar forces one) */
+extern int libsum( int const* array, size_t count );
+extern char const* libsum_variant( void );
 
 int global = 100;
 
 int main( void ) {
+    int array[100];
+    int i;
+
     libfun( 42 );
+
+    for( i = 0; i < 100; i++ )
+        array[i] = i + 1;
+    printf( "libsum (%s): %d\n", libsum_variant(), libsum( array, 100 ) );
     return 0;
 }
\ No newline at end of file
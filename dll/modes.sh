@@ -0,0 +1,53 @@
+# Build modes shared by build.sh and startup.sh.
+# Source it, then call: set_modes hidden,symbolic,now,noplt
+#
+#   default   everything exported, lazy binding, calls through PLT
+#   hidden    -fvisibility=hidden, only symbols marked export
+#             (and listed in the library's .map version script)
+#             are dynamic, calls inside library are direct
+#   symbolic  -Bsymbolic, library binds its own symbols to
+#             itself at link time (no interposition)
+#   now       -z now, all symbols bound at load time
+#   lazy      -z lazy, symbols bound at first call (default)
+#   noplt     -fno-plt, calls load address from GOT, no PLT stub
+#             (implies binding at load time for those calls)
+#
+# Sets LIB_CFLAGS LIB_LDFLAGS MAIN_CFLAGS MAIN_LDFLAGS and
+# EXPORT_LIST (yes when libraries link with their .map).
+
+set_modes() {
+    LIB_CFLAGS="-fPIC"
+    LIB_LDFLAGS=""
+    MAIN_CFLAGS=""
+    MAIN_LDFLAGS=""
+    EXPORT_LIST=no
+    for one_mode in $(echo "$1" | tr ',' ' '); do
+        case $one_mode in
+            default) ;;
+            hidden)
+                LIB_CFLAGS="$LIB_CFLAGS -fvisibility=hidden"
+                EXPORT_LIST=yes ;;
+            symbolic)
+                LIB_LDFLAGS="$LIB_LDFLAGS -Wl,-Bsymbolic" ;;
+            now)
+                LIB_LDFLAGS="$LIB_LDFLAGS -Wl,-z,now"
+                MAIN_LDFLAGS="$MAIN_LDFLAGS -Wl,-z,now" ;;
+            lazy)
+                LIB_LDFLAGS="$LIB_LDFLAGS -Wl,-z,lazy"
+                MAIN_LDFLAGS="$MAIN_LDFLAGS -Wl,-z,lazy" ;;
+            noplt)
+                LIB_CFLAGS="$LIB_CFLAGS -fno-plt"
+                MAIN_CFLAGS="$MAIN_CFLAGS -fno-plt" ;;
+            *)
+                echo "unknown build mode: $one_mode" >&2
+                return 1 ;;
+        esac
+    done
+}
+
+# linker flag with version script of library, when hidden
+export_flags() {
+    if [ "$EXPORT_LIST" = yes ]; then
+        echo "-Wl,--version-script=$1"
+    fi
+}
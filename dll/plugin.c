@@ -0,0 +1,162 @@
+/*
+ * Plugin loader declared in plugin.h.
+ *
+ * dlopen returns the already loaded library when asked for
+ * the same path again, so every load opens a private copy in
+ * $TMPDIR, default /tmp (unlinked right after dlopen, mapping
+ * stays valid). Then a rebuilt library can be reloaded from
+ * the same path, and build may overwrite it while old one is
+ * in use.
+ */
+
+#define _GNU_SOURCE
+
+#include "plugin.h"
+#include <dlfcn.h>
+/* for: dlopen, dlsym, dlclose, dlerror */
+#include <stdio.h>
+/* for: snprintf */
+#include <stdlib.h>
+/* for: malloc, free, mkstemp, getenv */
+#include <string.h>
+/* for: memcpy */
+#include <fcntl.h>
+/* for: open */
+#include <unistd.h>
+/* for: read, write, close, unlink */
+
+/* copies path to new temporary file, its name to copy */
+static int copy_file(char const* path, char* copy) {
+    char buffer[1 << 16];
+    ssize_t got;
+    int in = open(path, O_RDONLY), out;
+
+    if (in < 0)
+        return -1;
+    out = mkstemp(copy);
+    if (out < 0) {
+        close(in);
+        return -1;
+    }
+    while ((got = read(in, buffer, sizeof buffer)) > 0)
+        if (write(out, buffer, (size_t)got) != got) {
+            got = -1;
+            break;
+        }
+    close(in);
+    close(out);
+    if (got < 0) {
+        unlink(copy);
+        return -1;
+    }
+    return 0;
+}
+
+#define PLUGIN_RESOLVE(R, N, P) \
+    symbol = dlsym(handle, #N); \
+    if (symbol == NULL && missing == NULL) \
+        missing = #N; \
+    memcpy(&table->N, &symbol, sizeof symbol);
+
+static struct plugin_table* load(struct plugin* plugin) {
+    char const* dir = getenv("TMPDIR");
+    char copy[4096];
+    struct plugin_table* table;
+    uint32_t const* abi;
+    char const* missing = NULL;
+    void* handle;
+    void* symbol;
+
+    /* $TMPDIR when set, /tmp may be mounted noexec */
+    if (dir == NULL || *dir == '\0')
+        dir = "/tmp";
+    if ((size_t)snprintf(copy, sizeof copy, "%s/plugin-XXXXXX", dir) >= sizeof copy
+            || copy_file(plugin->path, copy) != 0) {
+        snprintf(plugin->error, sizeof plugin->error, "can not copy %s to %s", plugin->path, dir);
+        return NULL;
+    }
+    handle = dlopen(copy, RTLD_NOW | RTLD_LOCAL);
+    unlink(copy);
+    if (handle == NULL) {
+        snprintf(plugin->error, sizeof plugin->error, "%s", dlerror());
+        return NULL;
+    }
+
+    abi = dlsym(handle, "plugin_abi");
+    if (abi == NULL || *abi >> 16 != PLUGIN_ABI_MAJOR
+            || (*abi & 0xffff) < PLUGIN_ABI_MINOR) {
+        snprintf(plugin->error, sizeof plugin->error,
+                 "%s: ABI %u.%u, host needs %u.%u", plugin->path,
+                 abi != NULL ? (unsigned)(*abi >> 16) : 0,
+                 abi != NULL ? (unsigned)(*abi & 0xffff) : 0,
+                 PLUGIN_ABI_MAJOR, PLUGIN_ABI_MINOR);
+        dlclose(handle);
+        return NULL;
+    }
+
+    table = malloc(sizeof *table);
+    if (table == NULL) {
+        snprintf(plugin->error, sizeof plugin->error, "not enough memory");
+        dlclose(handle);
+        return NULL;
+    }
+    PLUGIN_ENTRIES(PLUGIN_RESOLVE)
+    if (missing != NULL) {
+        snprintf(plugin->error, sizeof plugin->error,
+                 "%s: no entry %s", plugin->path, missing);
+        free(table);
+        dlclose(handle);
+        return NULL;
+    }
+    table->abi = *abi;
+    table->generation = ++plugin->generation;
+    table->handle = handle;
+    table->retired = NULL;
+    return table;
+}
+
+int plugin_open(struct plugin* plugin, char const* path) {
+    struct plugin_table* table;
+
+    plugin->path = path;
+    plugin->retired = NULL;
+    plugin->generation = 0;
+    plugin->error[0] = '\0';
+    table = load(plugin);
+    atomic_init(&plugin->current, table);
+    return table != NULL ? 0 : -1;
+}
+
+int plugin_reload(struct plugin* plugin) {
+    struct plugin_table* table = load(plugin);
+    struct plugin_table* old;
+
+    if (table == NULL)
+        return -1;
+    old = atomic_exchange_explicit(&plugin->current, table, memory_order_acq_rel);
+    if (old != NULL) {
+        old->retired = plugin->retired;
+        plugin->retired = old;
+    }
+    return 0;
+}
+
+static void unload(struct plugin_table* table) {
+    while (table != NULL) {
+        struct plugin_table* next = table->retired;
+
+        dlclose(table->handle);
+        free(table);
+        table = next;
+    }
+}
+
+void plugin_collect(struct plugin* plugin) {
+    unload(plugin->retired);
+    plugin->retired = NULL;
+}
+
+void plugin_close(struct plugin* plugin) {
+    plugin_collect(plugin);
+    unload(atomic_exchange(&plugin->current, NULL));
+}
@@ -0,0 +1,78 @@
+/*
+ * Plugins: shared libraries loaded at run time (dlopen)
+ * instead of linked at build time like dynlib.so.
+ *
+ * Entry points are resolved once per load (dlsym) into a
+ * struct plugin_table of function pointers, so a call costs
+ * one indirect call, like through the PLT but without lazy
+ * binding. Plugin exports plugin_abi, a host refuses plugins
+ * of other major version or older minor version.
+ *
+ * plugin_reload loads the rebuilt library next to the old
+ * one and publishes its table with one atomic store, callers
+ * never wait. Old library stays mapped (callers may still run
+ * in it) until plugin_collect, which the host calls where no
+ * thread is inside a call through an old table (e.g. between
+ * requests). Reload and collect are called by one thread.
+ *
+ * build with:
+ * $ gcc -c -fPIC -o plugin.o plugin.c
+ * and link host with -ldl.
+ */
+#ifndef PLUGIN_H
+#define PLUGIN_H
+
+#include <stdint.h>
+/* for: uint32_t */
+#include <stdatomic.h>
+/* for: _Atomic, atomic_load_explicit */
+
+/* major changes break callers, minor ones only add entries */
+#define PLUGIN_ABI_MAJOR 1
+#define PLUGIN_ABI_MINOR 0
+#define PLUGIN_ABI(major, minor) ((uint32_t)(major) << 16 | (uint32_t)(minor))
+
+/* entry points every plugin exports: F(result, name, parameters) */
+#define PLUGIN_ENTRIES(F) \
+    F(void, plugin_hello, (int value)) \
+    F(int, plugin_next, (int value))
+
+/* a plugin puts this at file scope */
+#define PLUGIN_EXPORT_ABI \
+    uint32_t const plugin_abi = PLUGIN_ABI(PLUGIN_ABI_MAJOR, PLUGIN_ABI_MINOR);
+
+#define PLUGIN_POINTER(R, N, P) R (*N) P;
+
+struct plugin_table {
+    PLUGIN_ENTRIES(PLUGIN_POINTER)
+    uint32_t abi;
+    unsigned generation;            /* 1 for first load */
+    void* handle;
+    struct plugin_table* retired;   /* older tables not closed yet */
+};
+
+struct plugin {
+    char const* path;               /* kept by caller */
+    _Atomic(struct plugin_table*) current;
+    struct plugin_table* retired;
+    unsigned generation;
+    char error[256];
+};
+
+/* 0, or -1 with reason in plugin->error */
+int plugin_open(struct plugin* plugin, char const* path);
+/*
+ * Loads library at path again. On failure (-1) current
+ * table stays in use.
+ */
+int plugin_reload(struct plugin* plugin);
+/* Closes libraries replaced by reloads. */
+void plugin_collect(struct plugin* plugin);
+void plugin_close(struct plugin* plugin);
+
+/* Hot path: current table, one load (a plain mov on x86). */
+static inline struct plugin_table const* plugin_get(struct plugin* plugin) {
+    return atomic_load_explicit(&plugin->current, memory_order_acquire);
+}
+
+#endif /* PLUGIN_H */
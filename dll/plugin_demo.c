@@ -0,0 +1,24 @@
+/* 
+ * Example plugin, see plugin.h.
+ * build with:
+ * $ gcc -c -fPIC -DGENERATION=1 -o plugin_demo.o plugin_demo.c
+ * $ gcc -o plugin.so -shared plugin_demo.o
+ * 
+ * GENERATION tells builds apart when plugin is reloaded.
+ */
+#include <stdio.h>
+#include "plugin.h"
+
+#ifndef GENERATION
+#define GENERATION 1
+#endif
+
+PLUGIN_EXPORT_ABI
+
+void plugin_hello(int value) {
+    printf( "plugin generation %d, param: %d\n", GENERATION, value );
+}
+
+int plugin_next(int value) {
+    return value + GENERATION;
+}
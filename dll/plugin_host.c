@@ -0,0 +1,37 @@
+/* 
+ * Host loading plugin.so at run time, replacing it while
+ * running (as after a rebuild) and reloading it.
+ * build with:
+ * $ gcc -o plugin_host plugin_host.c plugin.c -ldl
+ * 
+ * Run from directory with plugin.so and plugin_v2.so.
+ */
+#include <stdio.h>
+#include "plugin.h"
+
+int main( int argc, char** argv ) {
+    char const* dir = argc > 1 ? argv[1] : ".";
+    char path[4096], next[4096];
+    struct plugin plugin;
+
+    snprintf( path, sizeof path, "%s/plugin.so", dir );
+    snprintf( next, sizeof next, "%s/plugin_v2.so", dir );
+    if (plugin_open( &plugin, path ) != 0) {
+        printf( "%s\n", plugin.error );
+        return 1;
+    }
+    plugin_get( &plugin )->plugin_hello( 42 );
+
+    /* "rebuild": new library replaces old file atomically */
+    if (rename( next, path ) != 0 || plugin_reload( &plugin ) != 0) {
+        printf( "reload failed: %s\n", plugin.error );
+        plugin_close( &plugin );
+        return 1;
+    }
+    plugin_get( &plugin )->plugin_hello( 42 );
+
+    /* no call runs through old table any more */
+    plugin_collect( &plugin );
+    plugin_close( &plugin );
+    return 0;
+}
@@ -0,0 +1,95 @@
+#!/bin/sh
+
+# Startup time by build mode (see modes.sh).
+#
+# Generates LIBS libraries with SYMBOLS functions each, and
+# a main linked with all of them, builds them once per mode,
+# then bench_startup times exec -> main and exec -> return
+# of first call into a library, over many runs.
+#
+# $ ./startup.sh [LIBS [SYMBOLS [MODE ...]]] > startup.json
+# default: 32 libraries, 256 symbols, modes below.
+
+LIBS=${1:-32}
+SYMBOLS=${2:-256}
+if [ $# -ge 2 ]; then shift 2; else shift $#; fi
+MODES=${*:-"default lazy now hidden symbolic noplt hidden,symbolic,now,noplt"}
+
+. ./modes.sh
+
+SRC=bin/startup/src
+mkdir -p $SRC
+
+# lib<i>.c: chain f<SYMBOLS-1> -> ... -> f0, entry calls the
+# top one. Only entry is exported in hidden mode (lib<i>.map).
+i=0
+while [ $i -lt $LIBS ]; do
+    {
+        echo "#define EXPORT __attribute__((visibility(\"default\")))"
+        echo "int lib${i}_f0( int x ) { return x + 1; }"
+        j=1
+        while [ $j -lt $SYMBOLS ]; do
+            echo "int lib${i}_f$j( int x ) { return lib${i}_f$((j - 1))( x ) + 1; }"
+            j=$((j + 1))
+        done
+        echo "EXPORT int lib${i}_entry( int x ) { return lib${i}_f$((SYMBOLS - 1))( x ); }"
+    } > $SRC/lib$i.c
+    echo "{ global: lib${i}_entry; local: *; };" > $SRC/lib$i.map
+    i=$((i + 1))
+done
+
+# main.c: times are taken at main and after first call,
+# start (taken just before exec) comes as argv[1]
+{
+    echo "#include <stdio.h>"
+    echo "#include <stdlib.h>"
+    echo "#include <time.h>"
+    i=0
+    while [ $i -lt $LIBS ]; do
+        echo "extern int lib${i}_entry( int x );"
+        i=$((i + 1))
+    done
+    echo "static long long now( void ) {"
+    echo "    struct timespec t;"
+    echo "    clock_gettime( CLOCK_MONOTONIC, &t );"
+    echo "    return t.tv_sec * 1000000000LL + t.tv_nsec;"
+    echo "}"
+    echo "int main( int argc, char** argv ) {"
+    echo "    long long at_main = now(), after_call;"
+    echo "    long long start = argc > 1 ? atoll( argv[1] ) : at_main;"
+    echo "    int v = lib0_entry( argc );"
+    echo "    after_call = now();"
+    echo "    /* every library is used, not only loaded */"
+    echo "    if (argc > 2) {"
+    i=1
+    while [ $i -lt $LIBS ]; do
+        echo "        v += lib${i}_entry( v );"
+        i=$((i + 1))
+    done
+    echo "    }"
+    printf '%s\n' '    printf( "%lld %lld %d\n", at_main - start, after_call - start, v );'
+    echo "    return 0;"
+    echo "}"
+} > $SRC/main.c
+
+gcc -O2 -I../syntax -o bin/bench_startup bench_startup.c ../syntax/bench.c || exit 1
+
+RUNS=""
+for mode in $MODES; do
+    set_modes $mode || exit 1
+    OUT=bin/startup/$mode
+    mkdir -p $OUT
+    LINK=""
+    i=0
+    while [ $i -lt $LIBS ]; do
+        gcc -O2 $LIB_CFLAGS -shared $LIB_LDFLAGS $(export_flags $SRC/lib$i.map) \
+            -Wl,-soname,lib$i.so -o $OUT/lib$i.so $SRC/lib$i.c || exit 1
+        LINK="$LINK $OUT/lib$i.so"
+        i=$((i + 1))
+    done
+    gcc -O2 $MAIN_CFLAGS $MAIN_LDFLAGS -o $OUT/main $SRC/main.c $LINK \
+        -Wl,-rpath,'$ORIGIN' || exit 1
+    RUNS="$RUNS $mode=$OUT/main"
+done
+
+./bin/bench_startup $RUNS
@@ -1,4 +1,4 @@
-/* $ gcc -o alignment -pedantic-errors -Werror alignment.c */
+/* $ gcc -o alignment -pedantic-errors -Werror alignment.c arena.c pool.c layout.c */
 /* run with: */
 /* ./alignment */
 
@@ -6,36 +6,127 @@
 /* For printf */
 #include <stdalign.h>
 /* alignment aliases */
+#include <stdint.h>
+/* for: uintptr_t */
+#include "arena.h"
+/* for: arena_new, arena_new_array */
+#include "pool.h"
+/* for: struct pool, pool_get, pool_put */
+#include "layout.h"
+/* for: LAYOUT_STRUCT, DEFINE_LAYOUT, layout_report */
+
+/* objects of struct X must be allocated at 4-byte boundaries */
+/* because X.n must be allocated at 4-byte boundaries */
+/* because int's alignment requirement is (usually) 4 */
+struct X
+{
+    int n;  /* size: 4, alignment: 4 */
+    char c; /* size: 1, alignment: 1 */
+            /* three bytes padding */
+};          /* size: 8, alignment: 4 */
+
+/* every object of type struct sse_t will be aligned to 16-byte boundary */
+/* (note: needs support for DR 444) */
+struct sse_t
+{
+    alignas(16) float sse_data[4];
+};
+
+/* every object of type struct data will be aligned to 128-byte boundary */
+struct data
+{
+    char x;
+    alignas(128) char cacheline[128]; /* over-aligned array of char,  */
+                                      /* not array of over-aligned chars */
+};
+
+/* 
+ * Padding comments above, worked out by layout.h from lists
+ * of fields (existing structs listed as declared).
+ */
+#define X_FIELDS(F, S) F(S, int, n) F(S, char, c)
+DEFINE_LAYOUT(x, struct X, X_FIELDS)
+
+typedef char cacheline_bytes[128];
+#define DATA_FIELDS(F, S) F(S, char, x) F(S, cacheline_bytes, cacheline)
+DEFINE_LAYOUT(data, struct data, DATA_FIELDS)
+
+/* MixedData of c.md, declared from its list */
+#define MIXED_FIELDS(F, S) \
+    F(S, char, data1) F(S, short, data2) F(S, int, data3) F(S, char, data4)
+LAYOUT_STRUCT(mixed_data, MIXED_FIELDS)
+DEFINE_LAYOUT(mixed_data, struct mixed_data, MIXED_FIELDS)
+
+/* typical hot struct grown field by field */
+#define SESSION_FIELDS(F, S) \
+    F(S, char, active) F(S, double, started) F(S, short, port) \
+    F(S, void*, peer) F(S, char, retries) F(S, int, bytes_in) \
+    F(S, char, flags) F(S, long long, bytes_out)
+LAYOUT_STRUCT(session, SESSION_FIELDS)
+DEFINE_LAYOUT(session, struct session, SESSION_FIELDS)
+
+static void layouts(void)
+{
+    struct layout const* all[4];
+    int i;
+
+    all[0] = &x_layout;
+    all[1] = &data_layout;
+    all[2] = &mixed_data_layout;
+    all[3] = &session_layout;
+    for( i = 0; i < 4; i++ ) {
+        puts("");
+        layout_report(stdout, all[i], 1000000);
+    }
+}
+
+/* 
+ * malloc only guarantees alignof(max_align_t) (16 on x86-64),
+ * struct sse_t and struct data must come from an allocator
+ * which is told their alignment.
+ */
+static int dynamic_alignment(void)
+{
+    struct arena arena;
+    struct pool pool;
+    struct pool_cache cache;
+    struct sse_t* vectors;
+    struct data* d[3];
+    char* byte;
+    int i, misaligned = 0;
+
+    if (!arena_init(&arena, 4096) || !pool_init_type(&pool, struct data)) {
+        puts("Not enough memory");
+        return 1;
+    }
+    byte = arena_new(&arena, char);     /* next block would be odd */
+    vectors = arena_new_array(&arena, struct sse_t, 4);
+    printf("arena: char at +%zu, sse_t[4] at +%zu (16-byte aligned: %s)\n",
+           (size_t)(byte - arena.base), (size_t)((char*)vectors - arena.base),
+           (uintptr_t)vectors % alignof(struct sse_t) == 0 ? "yes" : "no");
+    misaligned += (uintptr_t)vectors % alignof(struct sse_t) != 0;
+    arena_reset(&arena);                /* request done, all freed */
+
+    pool_cache_init(&cache, &pool);
+    for( i = 0; i < 3; i++ ) {
+        d[i] = pool_get(&cache);
+        printf("pool: struct data %d at 128-byte boundary: %s\n", i,
+               (uintptr_t)d[i] % alignof(struct data) == 0 ? "yes" : "no");
+        misaligned += (uintptr_t)d[i] % alignof(struct data) != 0;
+    }
+    for( i = 0; i < 3; i++ )
+        pool_put(&cache, d[i]);
+    pool_cache_flush(&cache);
+
+    pool_free(&pool);
+    arena_free(&arena);
+    return misaligned != 0;
+}
 
 int main(void)
 {
     alignas(8) short x; /* Aligns short at 8 Bytes */
 
-    /* objects of struct X must be allocated at 4-byte boundaries */
-    /* because X.n must be allocated at 4-byte boundaries */
-    /* because int's alignment requirement is (usually) 4 */
-    struct X
-    {
-        int n;  /* size: 4, alignment: 4 */
-        char c; /* size: 1, alignment: 1 */
-                /* three bytes padding */
-    };          /* size: 8, alignment: 4 */
-
-    /* every object of type struct sse_t will be aligned to 16-byte boundary */
-    /* (note: needs support for DR 444) */
-    struct sse_t
-    {
-        alignas(16) float sse_data[4];
-    };
-
-    /* every object of type struct data will be aligned to 128-byte boundary */
-    struct data
-    {
-        char x;
-        alignas(128) char cacheline[128]; /* over-aligned array of char,  */
-                                          /* not array of over-aligned chars */
-    };
-
     printf(
         "%zu\n",
         alignof(x) /* Compile time alignment computation */
@@ -46,6 +137,7 @@ int main(void)
         "sizeof(data) = %zu (1 byte + 127 bytes padding + 128-byte array)\n",
         sizeof(struct data));
     printf("alignment of sse_t is %zu\n", alignof(struct sse_t));
+    layouts();
 
-    return 0;
+    return dynamic_alignment();
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+/* 
+ * Copies of the example layouts of alignment.c, for
+ * benchmarks (alignment.c keeps its own, as notes).
+ */
+#ifndef ALIGNMENT_H
+#define ALIGNMENT_H
+
+#include <stdalign.h>
+/* alignment aliases */
+
+/* objects of struct X must be allocated at 4-byte boundaries */
+/* because X.n must be allocated at 4-byte boundaries */
+/* because int's alignment requirement is (usually) 4 */
+struct X
+{
+    int n;  /* size: 4, alignment: 4 */
+    char c; /* size: 1, alignment: 1 */
+            /* three bytes padding */
+};          /* size: 8, alignment: 4 */
+
+/* every object of type struct sse_t will be aligned to 16-byte boundary */
+/* (note: needs support for DR 444) */
+struct sse_t
+{
+    alignas(16) float sse_data[4];
+};
+
+/* every object of type struct data will be aligned to 128-byte boundary */
+struct data
+{
+    char x;
+    alignas(128) char cacheline[128]; /* over-aligned array of char,  */
+                                      /* not array of over-aligned chars */
+};
+
+#endif /* ALIGNMENT_H */
@@ -0,0 +1,30 @@
+/* 
+ * Pluggable allocator interface, used by containers
+ * (e.g. DEFINE_VEC in vec.h).
+ *
+ * One function does everything, like realloc:
+ *   resize(ctx, NULL, 0, n, align)  -> allocate n bytes
+ *   resize(ctx, p, old, n, align)   -> grow/shrink, may move
+ *   resize(ctx, p, old, 0, align)   -> free, returns NULL
+ * Old size is passed back, so allocators need not store it
+ * (an arena can grow its last block in place). Returns NULL
+ * when out of memory, then old block stays valid.
+ */
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stddef.h>
+/* for: size_t */
+
+typedef void* (allocator_resize)(
+    void* ctx, void* ptr, size_t old_size, size_t new_size, size_t align);
+
+struct allocator {
+    allocator_resize* resize;
+    void* ctx;
+};
+
+/* malloc/realloc/free (aligned_alloc for over-aligned types) */
+extern struct allocator const allocator_malloc;
+
+#endif /* ALLOCATOR_H */
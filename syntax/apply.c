@@ -0,0 +1,108 @@
+/* 
+ * Definitions for apply.h, compiled separately so calls
+ * through apply are real (not inlined) indirect calls.
+ */
+
+/* for sysconf */
+#define _POSIX_C_SOURCE 200809L
+
+#include "apply.h"
+#include <stdlib.h>
+/* for: malloc, free */
+#include <threads.h>
+/* for: thrd_create, thrd_join */
+#include <unistd.h>
+/* for: sysconf */
+
+/* below this many elements per thread, threads cost more than they save */
+#define APPLY_MIN_CHUNK (64 * 1024)
+
+/* function definition or circle_area! */
+double circle_area(int r) {
+    return circle_area_inline(r);
+}
+
+double apply(fun_int_to_double* f, int x) {
+    return f(x);
+}
+
+void apply_n(fun_int_to_double* f, int const* in, double* out, size_t n) {
+    size_t i;
+
+    for( i = 0; i < n; i++ )
+        out[i] = f(in[i]);
+}
+
+struct chunk {
+    apply_batch* batch;
+    fun_int_to_double* f;
+    int const* in;
+    double* out;
+    size_t n;
+};
+
+static int map_chunk(void* arg) {
+    struct chunk* c = arg;
+
+    c->batch(c->f, c->in, c->out, c->n);
+    return 0;
+}
+
+void apply_n_parallel(
+    apply_batch* batch, fun_int_to_double* f,
+    int const* in, double* out, size_t n, unsigned threads
+) {
+    struct chunk* chunks;
+    thrd_t* ids;
+    size_t i, started;
+
+    if (n / APPLY_MIN_CHUNK <= 1 || threads == 1) {
+        /* too small to split, also saves sysconf (reads a file) */
+        batch(f, in, out, n);
+        return;
+    }
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned)online : 1;
+    }
+    if (threads > n / APPLY_MIN_CHUNK)
+        threads = (unsigned)(n / APPLY_MIN_CHUNK);
+    if (threads <= 1) {
+        batch(f, in, out, n);
+        return;
+    }
+
+    chunks = malloc(threads * sizeof(*chunks));
+    ids = malloc(threads * sizeof(*ids));
+    if (chunks == NULL || ids == NULL) {
+        free(chunks);
+        free(ids);
+        batch(f, in, out, n);
+        return;
+    }
+
+    for( i = 0; i < threads; i++ ) {
+        size_t begin = n / threads * i;
+        size_t end = i + 1 == threads ? n : n / threads * (i + 1);
+
+        chunks[i].batch = batch;
+        chunks[i].f = f;
+        chunks[i].in = in + begin;
+        chunks[i].out = out + begin;
+        chunks[i].n = end - begin;
+    }
+
+    /* calling thread takes chunk 0, failed starts run inline too */
+    for( started = 1; started < threads; started++ )
+        if (thrd_create(&ids[started], map_chunk, &chunks[started])
+                != thrd_success)
+            break;
+    map_chunk(&chunks[0]);
+    for( i = started; i < threads; i++ )
+        map_chunk(&chunks[i]);
+    for( i = 1; i < started; i++ )
+        thrd_join(ids[i], NULL);
+
+    free(chunks);
+    free(ids);
+}
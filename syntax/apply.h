@@ -0,0 +1,75 @@
+/* 
+ * Function types and higher order functions of
+ * functional_types in c_synt.c (which keeps its own, as
+ * notes), with batched versions, for benchmarks.
+ *
+ * apply calls f for one element, an indirect call compiler
+ * can not inline. Batched versions map whole arrays,
+ * out[i] = f(in[i]) for i < n:
+ *
+ *   apply_n(f, in, out, n)    f is any pointer, one indirect
+ *                             call per element (fallback)
+ *   apply_n_NAME(in, out, n)  made by DEFINE_APPLY_N(NAME, F)
+ *                             for F known at compile time, loop
+ *                             body inlines and vectorizes
+ *   apply_n_parallel          splits large arrays between threads,
+ *                             each thread runs a batch function
+ */
+#ifndef APPLY_H
+#define APPLY_H
+
+#include <stddef.h>
+/* for: size_t */
+
+typedef double (fun_int_to_double)(int);
+/* function declaration of circle_area function using typedef! */
+fun_int_to_double circle_area; 
+/* function declaration of applay function */
+double apply(fun_int_to_double*, int);
+
+/* body of circle_area, visible so batches can inline it */
+static inline double circle_area_inline(int r) {
+    return 3.14 * (double)r;
+}
+
+/* 
+ * Batch function: maps n elements of in to out. Specialized
+ * batches (apply_batch_NAME) ignore f.
+ */
+typedef void (apply_batch)(fun_int_to_double* f, int const* in, double* out, size_t n);
+
+/* fallback for f unknown until run time */
+apply_batch apply_n;
+
+/* 
+ * Makes apply_n_NAME(in, out, n) computing F(in[i]), F is an
+ * inline function or macro, and apply_batch_NAME for
+ * apply_n_parallel.
+ */
+#define DEFINE_APPLY_N(NAME, F) \
+    static inline void apply_n_##NAME(int const* in, double* out, size_t n) { \
+        size_t i; \
+        \
+        for( i = 0; i < n; i++ ) \
+            out[i] = F(in[i]); \
+    } \
+    \
+    static inline void apply_batch_##NAME( \
+        fun_int_to_double* f, int const* in, double* out, size_t n \
+    ) { \
+        (void)f; \
+        apply_n_##NAME(in, out, n); \
+    }
+
+DEFINE_APPLY_N(circle_area, circle_area_inline)
+
+/* 
+ * batch(f, in, out, n) split into contiguous chunks, one per
+ * thread (0 -> one per online CPU). Small arrays, or threads
+ * failing to start, run in the calling thread.
+ */
+void apply_n_parallel(
+    apply_batch* batch, fun_int_to_double* f,
+    int const* in, double* out, size_t n, unsigned threads);
+
+#endif /* APPLY_H */
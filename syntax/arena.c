@@ -0,0 +1,110 @@
+/* 
+ * Arena declared in arena.h, and the malloc allocator
+ * declared in allocator.h.
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+/* for: malloc, realloc, aligned_alloc, free */
+#include <string.h>
+/* for: memcpy */
+#include <stdint.h>
+/* for: uintptr_t */
+#include <stdalign.h>
+/* for: alignof */
+
+
+static void* malloc_resize(
+    void* ctx, void* ptr, size_t old_size, size_t new_size, size_t align
+) {
+    void* moved;
+
+    (void)ctx;
+    if (new_size == 0) {
+        free(ptr);
+        return NULL;
+    }
+    if (align <= alignof(max_align_t))
+        return realloc(ptr, new_size);
+
+    /* realloc does not keep over-alignment, copy by hand */
+    moved = aligned_alloc(align, (new_size + align - 1) / align * align);
+    if (moved != NULL && ptr != NULL) {
+        memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+        free(ptr);
+    }
+    return moved;
+}
+
+struct allocator const allocator_malloc = {malloc_resize, NULL};
+
+
+bool arena_init(struct arena* arena, size_t capacity) {
+    /* aligned_alloc wants a multiple of alignment */
+    capacity = (capacity + ARENA_CACHE_LINE - 1) / ARENA_CACHE_LINE * ARENA_CACHE_LINE;
+    arena_init_buffer(arena, aligned_alloc(ARENA_CACHE_LINE, capacity), capacity);
+    arena->owned = true;
+    return arena->base != NULL;
+}
+
+void arena_init_buffer(struct arena* arena, void* buffer, size_t capacity) {
+    arena->base = buffer;
+    arena->capacity = buffer != NULL ? capacity : 0;
+    arena->used = 0;
+    arena->last = 0;
+    arena->owned = false;
+}
+
+void arena_free(struct arena* arena) {
+    if (arena->owned)
+        free(arena->base);
+    arena_init_buffer(arena, NULL, 0);
+}
+
+void* arena_alloc(struct arena* arena, size_t size, size_t align) {
+    uintptr_t at = (uintptr_t)(arena->base + arena->used);
+    size_t pad = (size_t)(-at & (align - 1));
+
+    if (size > arena->capacity - arena->used 
+            || pad > arena->capacity - arena->used - size)
+        return NULL; /* arena full */
+    arena->last = arena->used + pad;
+    arena->used = arena->last + size;
+    return arena->base + arena->last;
+}
+
+void arena_reset(struct arena* arena) {
+    arena->used = 0;
+    arena->last = 0;
+}
+
+static void* arena_resize(
+    void* ctx, void* ptr, size_t old_size, size_t new_size, size_t align
+) {
+    struct arena* arena = ctx;
+    char* moved;
+
+    if (ptr == (void*)(arena->base + arena->last) && ptr != NULL) {
+        /* last block: grow, shrink or free in place */
+        if (new_size <= arena->capacity - arena->last) {
+            arena->used = arena->last + new_size;
+            return new_size != 0 ? ptr : NULL;
+        }
+        return NULL;
+    }
+    if (new_size == 0)
+        return NULL; /* freed with the arena */
+
+    moved = arena_alloc(arena, new_size, align);
+    if (moved != NULL && ptr != NULL)
+        memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    return moved;
+}
+
+struct allocator arena_allocator(struct arena* arena) {
+    struct allocator allocator;
+
+    allocator.resize = arena_resize;
+    allocator.ctx = arena;
+    return allocator;
+}
@@ -0,0 +1,62 @@
+/* 
+ * Arena (bump) allocator over one fixed region.
+ *
+ * Allocation moves a pointer, nothing is freed one by one,
+ * arena_reset frees everything in O(1). The last allocation
+ * can grow or shrink in place, so a container which is the
+ * only user of an arena never copies when growing.
+ *
+ * Memory from arena_init starts at a cache line, so blocks
+ * aligned to ARENA_CACHE_LINE (e.g. per-thread counters) do
+ * not share lines with each other or with other data.
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include <stdint.h>
+/* for: SIZE_MAX */
+#include <stdalign.h>
+/* for: alignof */
+#include "allocator.h"
+/* for: struct allocator */
+
+#define ARENA_CACHE_LINE 64
+
+struct arena {
+    char* base;
+    size_t capacity;
+    size_t used;
+    size_t last;        /* offset of last allocation */
+    bool owned;         /* base comes from malloc */
+};
+
+/* Arena over capacity bytes from malloc, false if out of memory. */
+bool arena_init(struct arena* arena, size_t capacity);
+/* Arena over caller memory (e.g. stack buffer). */
+void arena_init_buffer(struct arena* arena, void* buffer, size_t capacity);
+void arena_free(struct arena* arena);
+
+/* NULL when arena is full. align must be a power of two. */
+void* arena_alloc(struct arena* arena, size_t size, size_t align);
+/* Forgets all allocations in O(1). */
+void arena_reset(struct arena* arena);
+
+/* 
+ * Uninitialized T (or count of them) aligned as T requires,
+ * over-aligned types too (e.g. struct data of alignment.h).
+ * NULL when arena is full.
+ */
+#define arena_new(arena, T) \
+    ((T*)arena_alloc((arena), sizeof(T), alignof(T)))
+#define arena_new_array(arena, T, count) \
+    ((count) > SIZE_MAX / sizeof(T) ? (T*)NULL \
+     : (T*)arena_alloc((arena), (count) * sizeof(T), alignof(T)))
+
+/* Allocator view of arena, for containers. */
+struct allocator arena_allocator(struct arena* arena);
+
+#endif /* ARENA_H */
@@ -1,46 +1,508 @@
 /* Compile with: */
-/* $ gcc -o array_sum_example -ansi -pedantic-errors -Werror array_sum.c */
+/* $ gcc -o array_sum_example -std=c11 -pedantic-errors -Werror array_sum.c array_sum_kernels.c array_sum_threads.c array_sum_generic.c array_sum_mmap.c scan.c parse.c -pthread */
 /* run with: */
-/* ./array_sum_example */
+/* ./array_sum_example              (example and self check) */
+/* ./array_sum_example scale 64 N   (threads scaling, 1..64 threads, N ints) */
+/* ./array_sum_example file F [W]   (sum of little-endian int32 file F, W byte windows) */
+/* ./array_sum_example text [F]     (sum of ints written as text in F, default - is stdin) */
+
+/* For fileno, open */
+#define _POSIX_C_SOURCE 200809L
 
 /* For printf */
 #include <stdio.h>
 /* For INT_MAX, INT_MIN */
 #include <limits.h>
+/* For rand, malloc, strtoul */
+#include <stdlib.h>
+/* For strcmp */
+#include <string.h>
+/* For timespec_get */
+#include <time.h>
+/* For int16_t, uint32_t, int64_t */
+#include <stdint.h>
+/* For PRId64, PRIu64 */
+#include <inttypes.h>
+/* For open */
+#include <fcntl.h>
+/* For close */
+#include <unistd.h>
+
+#include "array_sum.h"
+#include "scan.h"
+#include "parse.h"
+
+/*
+ * Compares every SIMD variant against scalar reference on
+ * random data and on arrays built to overflow at chosen
+ * positions (block boundaries, tails). Returns number of
+ * mismatches.
+ */
+int check_variants(void) {
+    size_t const max_count = 5000;
+    size_t const counts[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 1023, 1024, 1025, 5000};
+    int* array = malloc(max_count * sizeof(int));
+    struct array_sum_variant const* v;
+    size_t c, i, k;
+    int failed = 0;
+
+    if (array == NULL)
+        return 1;
+
+    for( k = 0; k < 200; k++ )
+    for( c = 0; c < sizeof(counts) / sizeof(counts[0]); c++ ) {
+        size_t count = counts[c];
+        int expected;
+
+        for( i = 0; i < count; i++ ) {
+            switch (k % 4) {
+                /* small values, never overflows */
+                case 0: array[i] = rand() % 2001 - 1000; break;
+                /* big values of one sign, overflows quickly */
+                case 1: array[i] = rand() % (INT_MAX / 64); break;
+                /* big values, wanders around int range */
+                case 2: array[i] = rand() - RAND_MAX / 2; break;
+                /* extremes */
+                default: array[i] = rand() % 2 ? INT_MAX : INT_MIN; break;
+            }
+        }
+        /* sometimes push the sum to a limit and back */
+        if (count > 2 && k % 8 == 5) {
+            size_t at = (size_t)rand() % (count - 1);
+            array[at] = k % 16 == 5 ? INT_MAX : INT_MIN;
+            array[at + 1] = k % 16 == 5 ? INT_MIN + 1 : INT_MAX;
+        }
+
+        expected = array_sum_scalar(array, count);
+
+        /* chunks summarized independently, merged in order */
+        {
+            struct array_sum_summary s1, s2, s3;
+            size_t a = count / 3, b = count - count / 4;
+            int sum = 0;
+            int got;
+
+            array_sum_summarize(array, a, &s1);
+            array_sum_summarize(array + a, b - a, &s2);
+            array_sum_summarize(array + b, count - b, &s3);
+            got = array_sum_acc_summary(array, a, &s1, &sum)
+               && array_sum_acc_summary(array + a, b - a, &s2, &sum)
+               && array_sum_acc_summary(array + b, count - b, &s3, &sum)
+                ? sum : -1;
+            if (got != expected) {
+                printf(
+                    "summary: count %zu, got %i, expected %i\n",
+                    count, got, expected
+                );
+                failed++;
+            }
+        }
+
+        for( v = array_sum_variants(); v->name != NULL; v++ ) {
+            int sum = 0;
+            int got;
+
+            if (!array_sum_supported(v))
+                continue;
+            got = v->acc(array, count, &sum) ? sum : -1;
+            if (got != expected) {
+                printf(
+                    "%s: count %zu, got %i, expected %i\n",
+                    v->name, count, got, expected
+                );
+                failed++;
+            }
+        }
+    }
 
-int array_sum(int const* array, size_t count ) {
+    free(array);
+    return failed;
+}
+
+/* Allocates array of small values (-3..3), sum stays near 0. */
+int* big_array(size_t count) {
+    int* array = malloc(count * sizeof(int));
     size_t i;
-    int sum = 0;
 
-    if(array == NULL)
-        return -1; /* wrong (null) array pointer */
+    if (array == NULL)
+        return NULL;
+    for( i = 0; i < count; i++ )
+        array[i] = (int)(i % 7) - 3;
+    return array;
+}
+
+int check_parallel(void) {
+    size_t const count = (size_t)1 << 22;
+    int* array = big_array(count);
+    unsigned threads;
+    int failed = 0;
+
+    if (array == NULL)
+        return 1;
+
+    /* in range, then overflowing in the middle and coming back */
+    array[count / 2] = INT_MAX;
+    for( threads = 1; threads <= 8; threads++ )
+        failed += array_sum_parallel(array, count, threads) != 
+                  array_sum_scalar(array, count);
+    array[count / 2 + 1] = INT_MAX;
+    array[count - 1] = INT_MIN;
+    for( threads = 1; threads <= 8; threads++ )
+        failed += array_sum_parallel(array, count, threads) != 
+                  array_sum_scalar(array, count);
+
+    free(array);
+    return failed;
+}
+
+/* Type generic array_sum against plain loops with wide sums. */
+int check_generic(void) {
+    int16_t const shorts[] = {INT16_MAX, INT16_MAX, INT16_MIN, -1, 7};
+    uint32_t words[100];
+    int64_t const longs[] = {INT64_MAX - 5, 5, 1, -1};
+    uint64_t const ulongs[] = {UINT64_MAX - 5, 4};
+    uint64_t const ulongs_over[] = {UINT64_MAX - 5, 3, 3};
+    signed char bytes[100000];
+    int64_t wide = 0;
+    uint64_t uwide = 0;
+    size_t i;
+    int failed = 0;
+
+    for( i = 0; i < sizeof(bytes); i++ ) {
+        bytes[i] = (signed char)(i % 256 - 128);
+        wide += bytes[i];
+    }
+    for( i = 0; i < 100; i++ ) {
+        words[i] = UINT32_MAX - (uint32_t)i;
+        uwide += words[i];
+    }
+
+    failed += array_sum(bytes, sizeof(bytes)) != wide;
+    failed += array_sum(shorts, 5) != 2 * INT16_MAX + INT16_MIN - 1 + 7;
+    failed += array_sum(words, 100) != uwide;
+    /* overflows at second element, third brings it back */
+    failed += array_sum(longs, 4) != -1;
+    failed += array_sum(longs + 1, 3) != 5;
+    failed += array_sum(ulongs, 2) != UINT64_MAX - 1;
+    failed += array_sum(ulongs_over, 3) != (uint64_t)-1;
+
+    printf(
+        "int16_t sum: %" PRId64 ", uint32_t sum: %" PRIu64 
+        ", int8_t sum: %" PRId64 "\n",
+        array_sum(shorts, 5), array_sum(words, 100), 
+        array_sum(bytes, sizeof(bytes))
+    );
+
+    return failed;
+}
+
+/* 
+ * Sums temporary file through windows of one page, so overflow
+ * state has to survive many window boundaries.
+ */
+int check_file(void) {
+    size_t const count = 100000;
+    int* array = big_array(count);
+    FILE* file = tmpfile();
+    int failed = 0;
+
+    if (array == NULL || file == NULL) {
+        free(array);
+        return 1;
+    }
+    /* prefix overflows at the end of some window, total does not */
+    array[4096 / sizeof(int) * 7 - 1] = INT_MAX;
+    array[4096 / sizeof(int) * 7] = INT_MAX;
+    array[4096 / sizeof(int) * 9] = INT_MIN;
+
+    fwrite(array, sizeof(int), count, file);
+    fflush(file);
+    failed += array_sum_fd(fileno(file), 4096) != array_sum_scalar(array, count);
+    failed += array_sum_fd(fileno(file), 0) != array_sum_scalar(array, count);
+    failed += array_sum_fd(fileno(file), 4096) != -1;
+
+    rewind(file);
+    array[4096 / sizeof(int) * 7] = -INT_MAX;
+    array[4096 / sizeof(int) * 9] = INT_MIN / 2;
+    fwrite(array, sizeof(int), count, file);
+    fflush(file);
+    failed += array_sum_fd(fileno(file), 4096) != array_sum_scalar(array, count);
+    failed += array_sum_fd(fileno(file), 4096) == -1;
+
+    fclose(file);
+    free(array);
+    return failed;
+}
+
+/* parse sink: values added to running sum, false on overflow */
+bool add_values(void* ctx, int const* values, size_t count) {
+    return array_sum_acc_best()(values, count, ctx);
+}
+
+struct collected {
+    int* values;
+    size_t count;
+    size_t capacity;
+};
+
+bool collect_values(void* ctx, int const* values, size_t count) {
+    struct collected* c = ctx;
+
+    if (count > c->capacity - c->count)
+        return false;
+    memcpy(c->values + c->count, values, count * sizeof(int));
+    c->count += count;
+    return true;
+}
 
+/* 
+ * Text of all kinds of ints and separators, over more than
+ * one parse_fd chunk, parsed by every kernel from memory and
+ * from file; then bad tokens and sum overflow.
+ */
+int check_text(void) {
+    size_t const count = 300000;
+    char const* const separators[] = {" ", "\n", "\t", "\r\n", "  \n"};
+    int* array = malloc(count * sizeof(int));
+    struct collected c = {NULL, 0, 0};
+    struct parse_variant const* v;
+    struct parse_result r;
+    FILE* file = tmpfile();
+    char* text = NULL;
+    long size;
+    size_t i;
+    int failed = 0;
+    int sum = 0;
+
+    c.values = malloc(count * sizeof(int));
+    c.capacity = count;
+    if (array == NULL || c.values == NULL || file == NULL) {
+        free(array);
+        free(c.values);
+        return 1;
+    }
     for( i = 0; i < count; i++ ) {
-        /*
-         * clang and gcc 5 have builtins now overflows:
-         * __builtin_add_overflow and
-         * __builtin_mul_overflow 
-         */
-        if (
-            (array[i] > 0 && sum > INT_MAX - array[i]) ||
-            (array[i] < 0 && sum < INT_MIN - array[i])
-        )
-            return -1; /* overflow or underflow */
-        
-        sum = sum + array[i];
+        array[i] = i == 0 ? INT_MIN : i == 1 ? INT_MAX
+                 : (int)((uint32_t)i * 2654435761u) >> (i % 32);
+        if (i % 1000 == 1)
+            fprintf(file, "%+012d", array[i]);   /* sign, leading zeros */
+        else
+            fprintf(file, "%d", array[i]);
+        fputs(i == count / 2 ? "                                    \n"
+              : separators[i % 5], file);
+    }
+    fflush(file);
+    size = ftell(file);
+    if (size > 0)
+        text = malloc((size_t)size);
+    rewind(file);
+    if (text == NULL || fread(text, 1, (size_t)size, file) != (size_t)size) {
+        free(text);
+        free(array);
+        free(c.values);
+        fclose(file);
+        return 1;
+    }
+
+    for( v = parse_variants(); v->name != NULL; v++ ) {
+        if (!parse_supported(v))
+            continue;
+        c.count = 0;
+        r = parse_text(v, text, (size_t)size, collect_values, &c);
+        failed += r.status != PARSE_OK || r.count != count || r.offset != (uint64_t)size
+                  || c.count != count || memcmp(c.values, array, count * sizeof(int)) != 0;
+        c.count = 0;
+        lseek(fileno(file), 0, SEEK_SET);
+        r = parse_fd(v, fileno(file), collect_values, &c);
+        failed += r.status != PARSE_OK || r.offset != (uint64_t)size
+                  || c.count != count || memcmp(c.values, array, count * sizeof(int)) != 0;
+    }
+    lseek(fileno(file), 0, SEEK_SET);
+    r = parse_fd(NULL, fileno(file), add_values, &sum);
+    failed += r.status != PARSE_STOPPED || array_sum_scalar(array, count) != -1;
+
+    r = parse_text(NULL, "1 2147483648 3", 14, add_values, &sum);
+    failed += r.status != PARSE_OVERFLOW || r.offset != 2 || r.count != 1;
+    c.count = 0;
+    r = parse_text(NULL, "-2147483648\n", 12, collect_values, &c);
+    failed += r.status != PARSE_OK || c.values[c.count - 1] != INT_MIN;
+    r = parse_text(NULL, "1 2x 3", 6, collect_values, &c);
+    failed += r.status != PARSE_INVALID || r.offset != 2;
+    r = parse_text(NULL, "4 - 5", 5, collect_values, &c);
+    failed += r.status != PARSE_INVALID || r.offset != 2;
+    sum = 0;
+    r = parse_text(NULL, "  7\n-3 +2", 9, add_values, &sum);
+    failed += r.status != PARSE_OK || r.count != 3 || sum != 6;
+
+    fclose(file);
+    free(text);
+    free(array);
+    free(c.values);
+    return failed;
+}
+
+/* Sum of ints written as text in path ("-" is stdin). */
+int sum_text(char const* path) {
+    int fd = strcmp(path, "-") == 0 ? 0 : open(path, O_RDONLY);
+    struct parse_result r;
+    int sum = 0;
+
+    if (fd < 0) {
+        fprintf(stderr, "Can not open %s\n", path);
+        return 1;
+    }
+    r = parse_fd(NULL, fd, add_values, &sum);
+    if (fd != 0)
+        close(fd);
+    if (r.status != PARSE_OK && r.status != PARSE_STOPPED) {
+        fprintf(stderr, "%s: %s at byte %" PRIu64 "\n",
+                path, parse_status_name(r.status), r.offset);
+        return 1;
+    }
+    /* sink stops when sum overflows */
+    printf("The sum is: %i\n", r.status == PARSE_OK ? sum : -1);
+    return r.status == PARSE_OK ? 0 : 1;
+}
+
+/* Scans and segment sums against plain loops and array_sum. */
+int check_scan(void) {
+    size_t const count = 300000;
+    int* array = big_array(count);
+    int* out = malloc(count * sizeof(int));
+    size_t offsets[1001];
+    int sums[1000];
+    int total;
+    size_t i;
+    int failed = 0;
+
+    if (array == NULL || out == NULL) {
+        free(array);
+        free(out);
+        return 1;
+    }
+    array[count / 3] = INT_MAX - 10;
+
+    total = scan_inclusive(array, out, count);
+    failed += total != array_sum_scalar(array, count);
+    for( i = 0; i < count; i += 997 )
+        failed += out[i] != array_sum_scalar(array, i + 1);
+    total = scan_exclusive_parallel(array, out, count, 4);
+    failed += total != array_sum_scalar(array, count);
+    for( i = 0; i < count; i += 997 )
+        failed += out[i] != array_sum_scalar(array, i);
+    total = scan_inclusive_parallel(array, out, count, 3);
+    for( i = 0; i < count; i += 997 )
+        failed += out[i] != array_sum_scalar(array, i + 1);
+
+    /* segments of growing length, some overflow */
+    offsets[0] = 0;
+    for( i = 0; i < 1000; i++ )
+        offsets[i + 1] = offsets[i] + i % 300;
+    array[offsets[500] + 1] = INT_MAX;
+    array[offsets[500] + 2] = INT_MAX;
+    failed += scan_segments(array, offsets, 1000, sums) != 0;
+    for( i = 0; i < 1000; i++ )
+        failed += sums[i] != 
+            array_sum_scalar(array + offsets[i], offsets[i + 1] - offsets[i]);
+
+    /* overflow in the middle, back in range at the end */
+    array[count / 3 + 1] = 100;
+    array[count / 3 + 2] = -INT_MAX;
+    failed += scan_inclusive(array, out, count) != -1;
+    failed += scan_exclusive_parallel(array, out, count, 4) != -1;
+
+    free(array);
+    free(out);
+    return failed;
+}
+
+double seconds(void) {
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Prints time and bandwidth of array_sum_parallel for 1..max threads. */
+int scale(unsigned max_threads, size_t count) {
+    int* array = big_array(count);
+    unsigned threads;
+
+    if (array == NULL) {
+        puts("Not enough memory");
+        return 1;
+    }
+
+    printf("threads  ms        GB/s    sum\n");
+    for( threads = 1; threads <= max_threads; threads++ ) {
+        double best = 1e30;
+        int sum = 0;
+        int run;
+
+        for( run = 0; run < 5; run++ ) {
+            double start = seconds();
+            double took;
+
+            sum = array_sum_parallel(array, count, threads);
+            took = seconds() - start;
+            if (took < best)
+                best = took;
+        }
+        printf(
+            "%-8u %-9.3f %-7.2f %i\n", threads, best * 1e3, 
+            (double)(count * sizeof(int)) / best * 1e-9, sum
+        );
     }
 
-    return sum;
+    free(array);
+    return 0;
 }
 
 int main( int argc, char** argv ) {
     /*  */
     int const array[] = {1,2,3,4,5};
+    struct array_sum_variant const* v;
+    int failed;
+
+    if (argc > 1 && strcmp(argv[1], "scale") == 0)
+        return scale(
+            argc > 2 ? (unsigned)strtoul(argv[2], NULL, 10) : 8,
+            argc > 3 ? (size_t)strtoull(argv[3], NULL, 10) : (size_t)1 << 26
+        );
+
+    if (argc > 2 && strcmp(argv[1], "file") == 0) {
+        int sum = array_sum_file(
+            argv[2], argc > 3 ? (size_t)strtoull(argv[3], NULL, 10) : 0);
+        printf("The sum is: %i\n", sum);
+        return sum == -1 ? 1 : 0;
+    }
+
+    if (argc > 1 && strcmp(argv[1], "text") == 0)
+        return sum_text(argc > 2 ? argv[2] : "-");
 
     printf(
-        "The sum is: %i\n", 
+        "The sum is: %i\n",
         array_sum(array, sizeof(array) / sizeof(int))
     );
 
-    return 0;
-}
\ No newline at end of file
+    printf("Kernels:");
+    for( v = array_sum_variants(); v->name != NULL; v++ )
+        if (array_sum_supported(v))
+            printf(" %s", v->name);
+    puts("");
+
+    failed = check_variants();
+    printf("Kernels agree with scalar reference: %s\n", failed ? "no" : "yes");
+    failed += check_parallel();
+    printf("Threads agree with scalar reference: %s\n", failed ? "no" : "yes");
+    failed += check_generic();
+    printf("Type generic sums are correct: %s\n", failed ? "no" : "yes");
+    failed += check_file();
+    printf("File sums agree with scalar reference: %s\n", failed ? "no" : "yes");
+    failed += check_scan();
+    printf("Scans agree with scalar reference: %s\n", failed ? "no" : "yes");
+    failed += check_text();
+    printf("Text parsers agree with printf: %s\n", failed ? "no" : "yes");
+
+    return failed ? 1 : 0;
+}
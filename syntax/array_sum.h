@@ -0,0 +1,134 @@
+/* 
+ * Overflow-checked integer array summation.
+ *
+ * Every kernel follows the contract of the oryginal array_sum:
+ * elements are added left to right and the whole sum is
+ * rejected (-1 returned) as soon as any prefix sum leaves
+ * the [INT_MIN, INT_MAX] range, or when array is NULL.
+ */
+#ifndef ARRAY_SUM_H
+#define ARRAY_SUM_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include <stdint.h>
+/* for: int64_t */
+
+/* 
+ * Accumulating kernel: adds count elements to *sum.
+ * Returns false (and leaves *sum unspecified) if some
+ * prefix sum overflows, so kernels can be chained over
+ * consecutive chunks of one logical array.
+ */
+typedef bool (array_sum_kernel)(int const* array, size_t count, int* sum);
+
+array_sum_kernel array_sum_acc_scalar;  /* reference, element by element */
+array_sum_kernel array_sum_acc_sse42;   /* 2 x 64-bit lanes */
+array_sum_kernel array_sum_acc_avx2;    /* 4 x 64-bit lanes */
+array_sum_kernel array_sum_acc_avx512;  /* 8 x 64-bit lanes */
+
+/* instruction set a kernel needs */
+enum array_sum_isa {
+    ARRAY_SUM_ISA_C,
+    ARRAY_SUM_ISA_SSE42,
+    ARRAY_SUM_ISA_AVX2,
+    ARRAY_SUM_ISA_AVX512
+};
+struct array_sum_variant {
+    const char* name;
+    enum array_sum_isa isa;
+    array_sum_kernel* acc;
+};
+/* 
+ * All kernels in order of preference, NULL name terminated.
+ * Before calling a kernel check it with array_sum_supported.
+ */
+struct array_sum_variant const* array_sum_variants(void);
+bool array_sum_supported(struct array_sum_variant const* variant);
+
+/* Best kernel supported by running CPU (by CPUID, checked once). */
+array_sum_kernel* array_sum_acc_best(void);
+
+/* 
+ * Summary of a chunk which does not depend on the sum of
+ * elements before it, so chunks can be summarized
+ * independently (e.g. by threads) and merged in order.
+ * Bounds are conservative (computed per block).
+ */
+struct array_sum_summary {
+    int64_t total;   /* exact sum of chunk elements */
+    int64_t low;     /* <= every prefix sum of chunk */
+    int64_t high;    /* >= every prefix sum of chunk */
+    bool overflows;  /* overflows whatever int sum comes before */
+};
+void array_sum_summarize(
+    int const* array, size_t count, struct array_sum_summary* out);
+/* 
+ * Adds summarized chunk to *sum with array_sum_kernel
+ * contract, replaying chunk exactly when bounds are too wide.
+ */
+bool array_sum_acc_summary(
+    int const* array, size_t count,
+    struct array_sum_summary const* summary, int* sum);
+
+/* Reference implementation, element by element. */
+int array_sum_scalar(int const* array, size_t count);
+/* Sum using best kernel, same results as array_sum_scalar. */
+int (array_sum)(int const* array, size_t count);
+/* 
+ * Same result as array_sum, chunks are summarized by
+ * threads (0 -> one per online CPU) and merged in order.
+ */
+int array_sum_parallel(int const* array, size_t count, unsigned threads);
+/* 
+ * Same result as array_sum over raw little-endian int32 file,
+ * mapped window bytes at a time (0 -> 64 MiB, rounded up to
+ * pages). -1 also when file can not be opened or mapped, or its
+ * size is not a multiple of int size. POSIX only.
+ */
+int array_sum_file(char const* path, size_t window);
+int array_sum_fd(int fd, size_t window);
+
+
+/* 
+ * Sums of other integer widths, same contract: NULL array or
+ * overflow of result type gives -1 (max value for unsigned).
+ * Narrow types sum in 32-bit blocks with no per-element check
+ * and widen to 64-bit result, which can not overflow (it would
+ * need more than 2^32 elements for 32-bit inputs).
+ */
+int64_t array_sum_char(char const* array, size_t count);
+int64_t array_sum_schar(signed char const* array, size_t count);
+uint64_t array_sum_uchar(unsigned char const* array, size_t count);
+int64_t array_sum_short(short const* array, size_t count);
+uint64_t array_sum_ushort(unsigned short const* array, size_t count);
+uint64_t array_sum_uint(unsigned const* array, size_t count);
+long array_sum_long(long const* array, size_t count);
+unsigned long array_sum_ulong(unsigned long const* array, size_t count);
+long long array_sum_llong(long long const* array, size_t count);
+unsigned long long array_sum_ullong(unsigned long long const* array, size_t count);
+
+/* 
+ * Type generic array_sum(x, n) (C11), dispatches on element
+ * type of x (array or pointer, const or not), e.g.:
+ * int16_t -> array_sum_short, uint32_t -> array_sum_uint,
+ * int64_t -> array_sum_long. For int the function array_sum
+ * itself is called (macro names are not expanded recursively).
+ * No copy of the input is made.
+ */
+#define array_sum(x, n) (_Generic( *(x), \
+            char: array_sum_char,\
+            signed char: array_sum_schar,\
+            unsigned char: array_sum_uchar,\
+            short: array_sum_short,\
+            unsigned short: array_sum_ushort,\
+            int: array_sum,\
+            unsigned: array_sum_uint,\
+            long: array_sum_long,\
+            unsigned long: array_sum_ulong,\
+            long long: array_sum_llong,\
+            unsigned long long: array_sum_ullong)((x), (n)))
+
+#endif /* ARRAY_SUM_H */
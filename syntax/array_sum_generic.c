@@ -0,0 +1,106 @@
+/* 
+ * Kernels behind the type generic array_sum(x, n) macro.
+ *
+ * Kernels are generated by macros (like DEFINE_PAIR in
+ * polymorphisms.c), one per element type, each with the
+ * cheapest accumulator which can not overflow inside a block.
+ */
+
+#include "array_sum.h"
+/* For UINT32_MAX */
+#include <stdint.h>
+
+/* elements per block, 4 accumulators take BLOCK / 4 each */
+#define ARRAY_SUM_NARROW_BLOCK 32768
+
+/* 
+ * Narrow element type T summed into four ACC accumulators per
+ * block (independent chains, easy to vectorize), blocks added
+ * to RES with overflow check. For T = short:
+ * |element| <= 2^15, 2^13 elements per accumulator -> < 2^28.
+ */
+#define DEFINE_ARRAY_SUM_NARROW(name, T, ACC, RES) \
+RES name(T const* array, size_t count) {\
+    size_t i, j, n;\
+    RES sum = 0;\
+    if (array == NULL)\
+        return (RES)-1; /* wrong (null) array pointer */\
+    for( i = 0; i < count; i += n ) {\
+        ACC a0 = 0, a1 = 0, a2 = 0, a3 = 0;\
+        T const* block = array + i;\
+        n = count - i < ARRAY_SUM_NARROW_BLOCK ? count - i\
+                                               : ARRAY_SUM_NARROW_BLOCK;\
+        for( j = 0; j + 4 <= n; j += 4 ) {\
+            a0 += block[j];\
+            a1 += block[j + 1];\
+            a2 += block[j + 2];\
+            a3 += block[j + 3];\
+        }\
+        for( ; j < n; j++ )\
+            a0 += block[j];\
+        if (__builtin_add_overflow(sum, (RES)a0 + a1 + a2 + a3, &sum))\
+            return (RES)-1; /* overflow */\
+    }\
+    return sum;\
+}
+
+DEFINE_ARRAY_SUM_NARROW(array_sum_char, char, int32_t, int64_t)
+DEFINE_ARRAY_SUM_NARROW(array_sum_schar, signed char, int32_t, int64_t)
+DEFINE_ARRAY_SUM_NARROW(array_sum_uchar, unsigned char, uint32_t, uint64_t)
+DEFINE_ARRAY_SUM_NARROW(array_sum_short, short, int32_t, int64_t)
+DEFINE_ARRAY_SUM_NARROW(array_sum_ushort, unsigned short, uint32_t, uint64_t)
+/* 2^13 elements < 2^32 each per accumulator -> < 2^45 */
+DEFINE_ARRAY_SUM_NARROW(array_sum_uint, unsigned, uint64_t, uint64_t)
+
+/* 
+ * Signed 64-bit: no wider accumulator, and prefix sums are not
+ * monotonic, so every element is checked (as in array_sum).
+ */
+#define DEFINE_ARRAY_SUM_CHECKED(name, T) \
+T name(T const* array, size_t count) {\
+    size_t i;\
+    T sum = 0;\
+    if (array == NULL)\
+        return -1; /* wrong (null) array pointer */\
+    for( i = 0; i < count; i++ )\
+        if (__builtin_add_overflow(sum, array[i], &sum))\
+            return -1; /* overflow or underflow */\
+    return sum;\
+}
+
+DEFINE_ARRAY_SUM_CHECKED(array_sum_long, long)
+DEFINE_ARRAY_SUM_CHECKED(array_sum_llong, long long)
+
+/* 
+ * Unsigned 64-bit: prefix sums only grow, so the sum overflows
+ * exactly when the total does. Low and high 32-bit halves are
+ * summed separately per block (no carries to check), then
+ * joined: total = high * 2^32 + low.
+ */
+#define DEFINE_ARRAY_SUM_HALVES(name, T) \
+T name(T const* array, size_t count) {\
+    size_t i, j, n;\
+    T sum = 0;\
+    if (array == NULL)\
+        return (T)-1; /* wrong (null) array pointer */\
+    for( i = 0; i < count; i += n ) {\
+        uint64_t low = 0, high = 0;\
+        T block;\
+        n = count - i < ARRAY_SUM_NARROW_BLOCK ? count - i\
+                                               : ARRAY_SUM_NARROW_BLOCK;\
+        for( j = 0; j < n; j++ ) {\
+            low += (uint32_t)array[i + j];\
+            high += (uint64_t)array[i + j] >> 32;\
+        }\
+        high += low >> 32;\
+        if (high > UINT32_MAX)\
+            return (T)-1; /* overflow */\
+        block = (T)(high << 32 | (low & UINT32_MAX));\
+        if (__builtin_add_overflow(sum, block, &sum))\
+            return (T)-1; /* overflow */\
+    }\
+    return sum;\
+}
+
+DEFINE_ARRAY_SUM_HALVES(array_sum_ulong, unsigned long)
+DEFINE_ARRAY_SUM_HALVES(array_sum_ullong, unsigned long long)
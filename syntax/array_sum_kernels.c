@@ -0,0 +1,329 @@
+/* 
+ * Kernels declared in array_sum.h.
+ *
+ * SIMD kernels add elements in 64-bit lanes (no lane can
+ * overflow inside a block) and check for int overflow once
+ * per block. Sequential semantics (first overflowing prefix
+ * rejects whole sum) are kept by summing positive and
+ * negative parts of the block separately: every prefix sum
+ * inside the block lies in [sum + negatives, sum + positives],
+ * so if both bounds fit in int, no prefix can overflow.
+ * Otherwise the block is replayed by the scalar kernel,
+ * which finds the exact answer.
+ */
+
+#include "array_sum.h"
+/* For INT_MAX, INT_MIN */
+#include <limits.h>
+/* For atomic_load_explicit, atomic_store_explicit */
+#include <stdatomic.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define ARRAY_SUM_X86 1
+#   include <immintrin.h>
+#endif
+
+/* elements per overflow check, multiple of every lane count */
+#define ARRAY_SUM_BLOCK 1024
+
+/* 
+ * Sums positive and negative parts of n elements,
+ * n is a multiple of the kernel lane count.
+ */
+typedef void (block_parts)(int const* block, size_t n, int64_t* pos, int64_t* neg);
+
+
+bool array_sum_acc_scalar(int const* array, size_t count, int* sum) {
+    size_t i;
+    int s = *sum;
+
+    for( i = 0; i < count; i++ ) {
+        /*
+         * clang and gcc 5 have builtins now overflows:
+         * __builtin_add_overflow and
+         * __builtin_mul_overflow 
+         */
+        if (
+            (array[i] > 0 && s > INT_MAX - array[i]) ||
+            (array[i] < 0 && s < INT_MIN - array[i])
+        )
+            return false; /* overflow or underflow */
+
+        s = s + array[i];
+    }
+
+    *sum = s;
+    return true;
+}
+
+static void parts_scalar(int const* block, size_t n, int64_t* pos, int64_t* neg) {
+    size_t i;
+    int64_t p = 0, q = 0;
+
+    for( i = 0; i < n; i++ ) {
+        if (block[i] > 0) p += block[i];
+        else              q += block[i];
+    }
+    *pos = p;
+    *neg = q;
+}
+
+/* 
+ * Block by block accumulation shared by SIMD kernels,
+ * tail shorter than lanes goes to scalar kernel.
+ */
+static bool acc_blocks(
+    block_parts* parts, size_t lanes,
+    int const* array, size_t count, int* sum
+) {
+    size_t i, n;
+
+    for( i = 0; i + lanes <= count; i += n ) {
+        int64_t pos, neg, s = *sum;
+
+        n = count - i < ARRAY_SUM_BLOCK ? (count - i) & ~(lanes - 1)
+                                        : ARRAY_SUM_BLOCK;
+        parts(array + i, n, &pos, &neg);
+
+        if (s + pos <= INT_MAX && s + neg >= INT_MIN)
+            *sum = (int)(s + pos + neg);
+        else if (!array_sum_acc_scalar(array + i, n, sum))
+            return false;
+    }
+    return array_sum_acc_scalar(array + i, count - i, sum);
+}
+
+/* 
+ * Block by block summary shared by all ISAs. Block
+ * boundaries are true prefix sums, so once the running sum
+ * leaves [-2^33, 2^33] no int start value can save the chunk
+ * (and int64_t can not overflow, a block adds at most 2^41).
+ */
+static void summarize_blocks(
+    block_parts* parts, size_t lanes,
+    int const* array, size_t count, struct array_sum_summary* out
+) {
+    int64_t const limit = (int64_t)1 << 33;
+    size_t i, n;
+
+    out->total = out->low = out->high = 0;
+    out->overflows = false;
+
+    for( i = 0; i < count; i += n ) {
+        int64_t pos, neg;
+
+        n = count - i < ARRAY_SUM_BLOCK ? count - i : ARRAY_SUM_BLOCK;
+        if (n >= lanes)
+            n &= ~(lanes - 1);
+        else
+            parts = parts_scalar;
+        parts(array + i, n, &pos, &neg);
+
+        if (out->total + pos > out->high) out->high = out->total + pos;
+        if (out->total + neg < out->low)  out->low  = out->total + neg;
+        out->total += pos + neg;
+
+        if (out->total > limit || out->total < -limit) {
+            out->overflows = true;
+            return;
+        }
+    }
+}
+
+
+#ifdef ARRAY_SUM_X86
+
+__attribute__((target("sse4.2")))
+static void parts_sse42(int const* block, size_t n, int64_t* p, int64_t* q) {
+    size_t j;
+    __m128i const zero = _mm_setzero_si128();
+    __m128i pos = zero;
+    __m128i neg = zero;
+    int64_t lanes[2];
+
+    for( j = 0; j < n; j += 4 ) {
+        __m128i v = _mm_loadu_si128((__m128i const*)(block + j));
+        __m128i vp = _mm_max_epi32(v, zero);
+        __m128i vn = _mm_min_epi32(v, zero);
+        /* positive parts zero extend, negative parts sign extend */
+        pos = _mm_add_epi64(pos, _mm_unpacklo_epi32(vp, zero));
+        pos = _mm_add_epi64(pos, _mm_unpackhi_epi32(vp, zero));
+        neg = _mm_add_epi64(neg, _mm_cvtepi32_epi64(vn));
+        neg = _mm_add_epi64(neg, _mm_cvtepi32_epi64(_mm_srli_si128(vn, 8)));
+    }
+    _mm_storeu_si128((__m128i*)lanes, pos);
+    *p = lanes[0] + lanes[1];
+    _mm_storeu_si128((__m128i*)lanes, neg);
+    *q = lanes[0] + lanes[1];
+}
+
+__attribute__((target("avx2")))
+static void parts_avx2(int const* block, size_t n, int64_t* p, int64_t* q) {
+    size_t j;
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i pos = zero;
+    __m256i neg = zero;
+    int64_t lanes[4];
+
+    for( j = 0; j < n; j += 8 ) {
+        __m256i v = _mm256_loadu_si256((__m256i const*)(block + j));
+        __m256i vp = _mm256_max_epi32(v, zero);
+        __m256i vn = _mm256_min_epi32(v, zero);
+        /* lane order does not matter for a sum */
+        pos = _mm256_add_epi64(pos, _mm256_unpacklo_epi32(vp, zero));
+        pos = _mm256_add_epi64(pos, _mm256_unpackhi_epi32(vp, zero));
+        neg = _mm256_add_epi64(neg, 
+            _mm256_cvtepi32_epi64(_mm256_castsi256_si128(vn)));
+        neg = _mm256_add_epi64(neg, 
+            _mm256_cvtepi32_epi64(_mm256_extracti128_si256(vn, 1)));
+    }
+    _mm256_storeu_si256((__m256i*)lanes, pos);
+    *p = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256((__m256i*)lanes, neg);
+    *q = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+__attribute__((target("avx512f")))
+static void parts_avx512(int const* block, size_t n, int64_t* p, int64_t* q) {
+    size_t j;
+    __m512i const zero = _mm512_setzero_si512();
+    __m512i pos = zero;
+    __m512i neg = zero;
+
+    for( j = 0; j < n; j += 16 ) {
+        __m512i v = _mm512_loadu_si512((void const*)(block + j));
+        __m512i vp = _mm512_max_epi32(v, zero);
+        __m512i vn = _mm512_min_epi32(v, zero);
+        pos = _mm512_add_epi64(pos, _mm512_unpacklo_epi32(vp, zero));
+        pos = _mm512_add_epi64(pos, _mm512_unpackhi_epi32(vp, zero));
+        neg = _mm512_add_epi64(neg, 
+            _mm512_cvtepi32_epi64(_mm512_castsi512_si256(vn)));
+        neg = _mm512_add_epi64(neg, 
+            _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(vn, 1)));
+    }
+    *p = _mm512_reduce_add_epi64(pos);
+    *q = _mm512_reduce_add_epi64(neg);
+}
+
+#else /* no x86 SIMD, every variant is the scalar one */
+
+#   define parts_sse42  parts_scalar
+#   define parts_avx2   parts_scalar
+#   define parts_avx512 parts_scalar
+
+#endif /* ARRAY_SUM_X86 */
+
+
+bool array_sum_acc_sse42(int const* array, size_t count, int* sum) {
+    return acc_blocks(parts_sse42, 4, array, count, sum);
+}
+
+bool array_sum_acc_avx2(int const* array, size_t count, int* sum) {
+    return acc_blocks(parts_avx2, 8, array, count, sum);
+}
+
+bool array_sum_acc_avx512(int const* array, size_t count, int* sum) {
+    return acc_blocks(parts_avx512, 16, array, count, sum);
+}
+
+
+bool array_sum_supported(struct array_sum_variant const* variant) {
+#ifdef ARRAY_SUM_X86
+    /* CPUID results are cached by libgcc, so checks are cheap */
+    __builtin_cpu_init();
+    switch (variant->isa) {
+        case ARRAY_SUM_ISA_SSE42:  return __builtin_cpu_supports("sse4.2");
+        case ARRAY_SUM_ISA_AVX2:   return __builtin_cpu_supports("avx2");
+        case ARRAY_SUM_ISA_AVX512: return __builtin_cpu_supports("avx512f");
+        default: break;
+    }
+#endif
+    return variant->isa == ARRAY_SUM_ISA_C;
+}
+
+struct array_sum_variant const* array_sum_variants(void) {
+    static struct array_sum_variant const all[] = {
+        {"avx512", ARRAY_SUM_ISA_AVX512, array_sum_acc_avx512},
+        {"avx2",   ARRAY_SUM_ISA_AVX2,   array_sum_acc_avx2},
+        {"sse4.2", ARRAY_SUM_ISA_SSE42,  array_sum_acc_sse42},
+        {"c",      ARRAY_SUM_ISA_C,      array_sum_acc_scalar},
+        {NULL,     ARRAY_SUM_ISA_C,      NULL}
+    };
+    return all;
+}
+
+array_sum_kernel* array_sum_acc_best(void) {
+    /*
+     * picked on first use, racing threads store the same kernel;
+     * relaxed is enough, the kernels are there before main
+     */
+    static _Atomic(array_sum_kernel*) best;
+    array_sum_kernel* acc = atomic_load_explicit(&best, memory_order_relaxed);
+    struct array_sum_variant const* v;
+
+    if (acc != NULL)
+        return acc;
+    acc = array_sum_acc_scalar;
+    for( v = array_sum_variants(); v->name != NULL; v++ )
+        if (array_sum_supported(v)) {
+            acc = v->acc;
+            break;
+        }
+    atomic_store_explicit(&best, acc, memory_order_relaxed);
+    return acc;
+}
+
+
+void array_sum_summarize(
+    int const* array, size_t count, struct array_sum_summary* out
+) {
+    array_sum_kernel* best = array_sum_acc_best();
+
+    if (best == array_sum_acc_avx512)
+        summarize_blocks(parts_avx512, 16, array, count, out);
+    else if (best == array_sum_acc_avx2)
+        summarize_blocks(parts_avx2, 8, array, count, out);
+    else if (best == array_sum_acc_sse42)
+        summarize_blocks(parts_sse42, 4, array, count, out);
+    else
+        summarize_blocks(parts_scalar, 1, array, count, out);
+}
+
+bool array_sum_acc_summary(
+    int const* array, size_t count,
+    struct array_sum_summary const* summary, int* sum
+) {
+    int64_t s = *sum;
+
+    if (summary->overflows)
+        return false;
+    if (s + summary->high <= INT_MAX && s + summary->low >= INT_MIN) {
+        *sum = (int)(s + summary->total);
+        return true;
+    }
+    /* close to a limit, only the exact replay knows */
+    return array_sum_acc_best()(array, count, sum);
+}
+
+
+int array_sum_scalar(int const* array, size_t count) {
+    int sum = 0;
+
+    if(array == NULL)
+        return -1; /* wrong (null) array pointer */
+
+    if (!array_sum_acc_scalar(array, count, &sum))
+        return -1; /* overflow or underflow */
+    return sum;
+}
+
+int (array_sum)(int const* array, size_t count) {
+    int sum = 0;
+
+    if(array == NULL)
+        return -1; /* wrong (null) array pointer */
+
+    if (!array_sum_acc_best()(array, count, &sum))
+        return -1; /* overflow or underflow */
+    return sum;
+}
@@ -0,0 +1,106 @@
+/* 
+ * array_sum over raw little-endian int32 files, which may be
+ * larger than RAM.
+ *
+ * File is mapped window by window (never read() into heap
+ * buffer), each window is fed to the array_sum kernel with
+ * the running sum carried over, and unmapped before the next
+ * one is mapped, so resident memory stays bounded by window
+ * size (plus page cache, which kernel may reclaim).
+ */
+
+/* for mmap, madvise, posix_fadvise */
+#define _DEFAULT_SOURCE
+/* 64-bit off_t on 32-bit hosts too, files may pass 2 GiB */
+#define _FILE_OFFSET_BITS 64
+
+#include "array_sum.h"
+#include <fcntl.h>
+/* for: open, posix_fadvise */
+#include <sys/mman.h>
+/* for: mmap, munmap, madvise */
+#include <sys/stat.h>
+/* for: fstat */
+#include <unistd.h>
+/* for: close, sysconf */
+
+/* default window, big enough to amortize mmap/munmap calls */
+#define ARRAY_SUM_WINDOW ((size_t)64 << 20)
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+/* 
+ * Big-endian host: mapped words must be swapped, so they are
+ * summed through a small buffer (window stays read only).
+ */
+static bool acc_window(int const* words, size_t count, int* sum) {
+    int buffer[4096];
+    size_t i, j, n;
+
+    for( i = 0; i < count; i += n ) {
+        n = count - i < 4096 ? count - i : 4096;
+        for( j = 0; j < n; j++ )
+            buffer[j] = (int)__builtin_bswap32((uint32_t)words[i + j]);
+        if (!array_sum_acc_best()(buffer, n, sum))
+            return false;
+    }
+    return true;
+}
+#else
+static bool acc_window(int const* words, size_t count, int* sum) {
+    return array_sum_acc_best()(words, count, sum);
+}
+#endif
+
+int array_sum_fd(int fd, size_t window) {
+    struct stat st;
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size, offset;
+    int sum = 0;
+
+    if (fstat(fd, &st) != 0 || st.st_size < 0)
+        return -1; /* not a file */
+    size = (size_t)st.st_size;
+    if (size % sizeof(int) != 0)
+        return -1; /* truncated last element */
+
+    if (window == 0)
+        window = ARRAY_SUM_WINDOW;
+    /* mmap offsets are page aligned, page is multiple of int size */
+    window = (window + page - 1) / page * page;
+
+    /* tells kernel to read ahead aggressively, and drop behind */
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    for( offset = 0; offset < size; offset += window ) {
+        size_t length = size - offset < window ? size - offset : window;
+        void* map;
+        bool ok;
+
+        map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, (off_t)offset);
+        if (map == MAP_FAILED)
+            return -1;
+        madvise(map, length, MADV_SEQUENTIAL);
+        /* start reading next window while this one is summed */
+        if (offset + length < size)
+            posix_fadvise(fd, (off_t)(offset + length), (off_t)window, 
+                          POSIX_FADV_WILLNEED);
+
+        ok = acc_window(map, length / sizeof(int), &sum);
+        munmap(map, length);
+        if (!ok)
+            return -1; /* overflow or underflow */
+    }
+
+    return sum;
+}
+
+int array_sum_file(char const* path, size_t window) {
+    int fd = open(path, O_RDONLY);
+    int sum;
+
+    if (fd < 0)
+        return -1; /* can not open */
+    sum = array_sum_fd(fd, window);
+    close(fd);
+    return sum;
+}
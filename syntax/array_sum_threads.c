@@ -0,0 +1,92 @@
+/* 
+ * Multi-threaded array_sum (C11 <threads.h>).
+ *
+ * Array is split into one contiguous chunk per thread. Each
+ * thread builds an array_sum_summary of its chunk: 64-bit
+ * total plus bounds of prefix sums. The merge walks chunks in
+ * order with the running int sum, so a prefix overflowing in
+ * chunk k is rejected even when later chunks would bring the
+ * total back into range, exactly like sequential array_sum.
+ */
+
+/* for sysconf */
+#define _POSIX_C_SOURCE 200809L
+
+#include "array_sum.h"
+#include <stdlib.h>
+/* for: malloc, free */
+#include <threads.h>
+/* for: thrd_create, thrd_join */
+#include <unistd.h>
+/* for: sysconf */
+
+/* below this many elements per thread, threads cost more than they save */
+#define ARRAY_SUM_MIN_CHUNK (64 * 1024)
+
+struct chunk {
+    int const* array;
+    size_t count;
+    struct array_sum_summary summary;
+};
+
+static int summarize_chunk(void* arg) {
+    struct chunk* c = arg;
+
+    array_sum_summarize(c->array, c->count, &c->summary);
+    return 0;
+}
+
+int array_sum_parallel(int const* array, size_t count, unsigned threads) {
+    struct chunk* chunks;
+    thrd_t* ids;
+    size_t i, started;
+    int sum = 0;
+    bool ok = true;
+
+    if(array == NULL)
+        return -1; /* wrong (null) array pointer */
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned)online : 1;
+    }
+    if (threads > count / ARRAY_SUM_MIN_CHUNK)
+        threads = (unsigned)(count / ARRAY_SUM_MIN_CHUNK);
+    if (threads <= 1)
+        return array_sum(array, count);
+
+    chunks = malloc(threads * sizeof(*chunks));
+    ids = malloc(threads * sizeof(*ids));
+    if (chunks == NULL || ids == NULL) {
+        free(chunks);
+        free(ids);
+        return array_sum(array, count);
+    }
+
+    for( i = 0; i < threads; i++ ) {
+        size_t begin = count / threads * i;
+        size_t end = i + 1 == threads ? count : count / threads * (i + 1);
+
+        chunks[i].array = array + begin;
+        chunks[i].count = end - begin;
+    }
+
+    /* calling thread takes chunk 0, failed starts run inline too */
+    for( started = 1; started < threads; started++ )
+        if (thrd_create(&ids[started], summarize_chunk, &chunks[started])
+                != thrd_success)
+            break;
+    summarize_chunk(&chunks[0]);
+    for( i = started; i < threads; i++ )
+        summarize_chunk(&chunks[i]);
+    for( i = 1; i < started; i++ )
+        thrd_join(ids[i], NULL);
+
+    for( i = 0; i < threads && ok; i++ )
+        ok = array_sum_acc_summary(
+            chunks[i].array, chunks[i].count, &chunks[i].summary, &sum);
+
+    free(chunks);
+    free(ids);
+    return ok ? sum : -1; /* -1 on overflow or underflow */
+}
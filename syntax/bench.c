@@ -0,0 +1,200 @@
+/* 
+ * Harness declared in bench.h (Linux: CPU pinning uses
+ * sched_setaffinity).
+ */
+
+/* for: sched_setaffinity, CPU_SET */
+#define _GNU_SOURCE
+
+#include "bench.h"
+#include <stdio.h>
+/* for: printf, fprintf */
+#include <stdlib.h>
+/* for: getenv, strtol, malloc, qsort */
+#include <string.h>
+/* for: strstr */
+#include <time.h>
+/* for: clock_gettime */
+#include <sched.h>
+/* for: sched_setaffinity, sched_getaffinity */
+
+static struct {
+    char const* suite;
+    char const* filter;
+    int cpu;
+    cpu_set_t allowed;  /* mask before pinning, for threaded cases */
+    int repeats;
+    uint64_t warmup_ns;
+    int cases;
+    int failed;
+} bench;
+
+static volatile uint64_t bench_sink;
+
+void bench_consume(uint64_t value) {
+    bench_sink ^= value;
+}
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static long env_long(char const* name, long fallback) {
+    char const* value = getenv(name);
+
+    return value != NULL && *value != '\0' ? strtol(value, NULL, 10) : fallback;
+}
+
+/* Pins calling thread to BENCH_CPU or first allowed CPU, -1 on failure. */
+static int pin_cpu(void) {
+    cpu_set_t set;
+    int cpu = (int)env_long("BENCH_CPU", -1);
+
+    if (cpu < 0) {
+        for( cpu = 0; cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &bench.allowed); cpu++ )
+            ;
+        if (cpu == CPU_SETSIZE)
+            return -1;
+    }
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? cpu : -1;
+}
+
+void bench_init(char const* suite) {
+    bench.suite = suite;
+    bench.filter = getenv("BENCH_FILTER");
+    bench.repeats = (int)env_long("BENCH_REPEATS", 31);
+    if (bench.repeats < 1)
+        bench.repeats = 1;
+    bench.warmup_ns = (uint64_t)env_long("BENCH_WARMUP_MS", 100) * 1000000u;
+    if (sched_getaffinity(0, sizeof(bench.allowed), &bench.allowed) != 0)
+        CPU_ZERO(&bench.allowed);
+    bench.cpu = pin_cpu();
+    bench.cases = 0;
+    bench.failed = 0;
+
+    printf("{\n");
+    printf("  \"suite\": \"%s\",\n", suite);
+    printf("  \"compiler\": \"%s\",\n", __VERSION__);
+#ifdef __OPTIMIZE__
+    printf("  \"optimized\": true,\n");
+#else
+    printf("  \"optimized\": false,\n");
+#endif
+    printf("  \"cpu\": %d,\n", bench.cpu);
+    printf("  \"repeats\": %d,\n", bench.repeats);
+    printf("  \"results\": [");
+
+    fprintf(stderr, "%s (cpu %d, %d samples)\n", suite, bench.cpu, bench.repeats);
+    fprintf(stderr, "%-44s %12s %12s %9s\n", "case", "median ns/op", "max ns/op", "GB/s");
+}
+
+void bench_unpin(void) {
+    if (bench.cpu >= 0)
+        sched_setaffinity(0, sizeof(bench.allowed), &bench.allowed);
+}
+
+void bench_pin(void) {
+    cpu_set_t set;
+
+    if (bench.cpu >= 0) {
+        CPU_ZERO(&set);
+        CPU_SET(bench.cpu, &set);
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+}
+
+static int compare_doubles(void const* a, void const* b) {
+    double x = *(double const*)a;
+    double y = *(double const*)b;
+
+    return (x > y) - (x < y);
+}
+
+double bench_run(
+    char const* name, bench_fn* run, void* ctx,
+    size_t ops, size_t bytes_per_op
+) {
+    double* samples;
+    double median, max, gbps;
+    uint64_t start, took;
+    size_t calls, warm, i;
+    int r;
+
+    if (bench.filter != NULL && strstr(name, bench.filter) == NULL)
+        return 0.0;
+    samples = malloc((size_t)bench.repeats * sizeof(double));
+    if (samples == NULL) {
+        bench.failed++;
+        return 0.0;
+    }
+    if (ops == 0)
+        ops = 1;
+
+    /* warmup, also measures how many calls fill one sample */
+    start = bench_now_ns();
+    warm = 0;
+    do {
+        run(ctx);
+        warm++;
+        took = bench_now_ns() - start;
+    } while (took < bench.warmup_ns);
+    calls = (size_t)(BENCH_MIN_SAMPLE_NS / (took / warm + 1)) + 1;
+
+    for( r = 0; r < bench.repeats; r++ ) {
+        start = bench_now_ns();
+        for( i = 0; i < calls; i++ )
+            run(ctx);
+        took = bench_now_ns() - start;
+        samples[r] = (double)took / (double)calls / (double)ops;
+    }
+
+    qsort(samples, (size_t)bench.repeats, sizeof(double), compare_doubles);
+    median = samples[bench.repeats / 2];
+    /* with the default 31 samples a p99 would be the max anyway */
+    max = samples[bench.repeats - 1];
+    /* bytes per nanosecond are GB/s */
+    gbps = bytes_per_op != 0 ? (double)bytes_per_op / median : 0.0;
+    free(samples);
+
+    fprintf(stderr, "%-44s %12.3f %12.3f %9.2f\n", name, median, max, gbps);
+    printf(
+        "%s\n    {\"name\": \"%s\", \"ops\": %zu, \"calls_per_sample\": %zu, "
+        "\"median_ns_per_op\": %.4f, \"max_ns_per_op\": %.4f, "
+        "\"gb_per_s\": %.4f}",
+        bench.cases == 0 ? "" : ",", name, ops, calls, median, max, gbps
+    );
+    bench.cases++;
+    fflush(stdout);
+    return median;
+}
+
+void bench_metric(char const* name, char const* unit, double value) {
+    if (bench.filter != NULL && strstr(name, bench.filter) == NULL)
+        return;
+    fprintf(stderr, "%-44s %12.3f %s\n", name, value, unit);
+    printf(
+        "%s\n    {\"name\": \"%s\", \"unit\": \"%s\", \"value\": %.4f}",
+        bench.cases == 0 ? "" : ",", name, unit, value
+    );
+    bench.cases++;
+    fflush(stdout);
+}
+
+void bench_rate(char const* name, char const* unit, double ns) {
+    char rate[128];
+
+    if (ns <= 0)
+        return;
+    snprintf(rate, sizeof rate, "%s/rate", name);
+    bench_metric(rate, unit, 1e3 / ns);
+}
+
+int bench_finish(void) {
+    printf("\n  ]\n}\n");
+    return bench.failed != 0;
+}
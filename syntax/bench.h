@@ -0,0 +1,73 @@
+/* 
+ * Micro-benchmark harness.
+ *
+ * Every case is run on a pinned CPU (threaded ones unpin),
+ * warmed up, then sampled many times. A sample times enough
+ * calls of the case to last at least BENCH_MIN_SAMPLE_NS,
+ * results are median and max nanoseconds per operation (and
+ * GB/s when case tells how many bytes an operation touches).
+ *
+ * Human readable table goes to stderr, JSON document to stdout,
+ * so runs can be saved and compared between builds:
+ * $ ./bin/bench/bench_array_sum > before.json
+ *
+ * Environment:
+ *   BENCH_CPU      CPU to pin to (default: first allowed CPU)
+ *   BENCH_REPEATS  samples per case (default 31)
+ *   BENCH_WARMUP_MS warmup time per case (default 100)
+ *   BENCH_FILTER   run only cases whose name contains it
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdint.h>
+/* for: uint64_t */
+
+#define BENCH_MIN_SAMPLE_NS 1000000
+
+/* One call performs ops operations of a case over ctx. */
+typedef void (bench_fn)(void* ctx);
+
+/* Starts suite (pins CPU, reads environment, opens JSON). */
+void bench_init(char const* suite);
+/* 
+ * Runs one case, ops operations per call of run, each
+ * operation touching bytes_per_op bytes (0 -> no GB/s).
+ * Returns median ns per operation (0 when case was skipped).
+ */
+double bench_run(
+    char const* name, bench_fn* run, void* ctx,
+    size_t ops, size_t bytes_per_op);
+/* 
+ * Reports a measured value which is not a time, e.g. bytes
+ * per entry or pause length (unit is free text).
+ */
+void bench_metric(char const* name, char const* unit, double value);
+/* 
+ * Reports ns per operation (as returned by bench_run) as
+ * "name/rate" in millions of operations per second, unit e.g.
+ * "M lines/s"; nothing for a skipped case (ns = 0).
+ */
+void bench_rate(char const* name, char const* unit, double ns);
+/*
+ * Threads inherit CPU mask of the thread creating them: cases
+ * starting threads (or pools of them) do so between bench_unpin
+ * (back to CPUs allowed before bench_init) and bench_pin.
+ */
+void bench_unpin(void);
+void bench_pin(void);
+/* Closes JSON, returns exit code for main. */
+int bench_finish(void);
+
+/* Monotonic clock in nanoseconds. */
+uint64_t bench_now_ns(void);
+
+/* 
+ * Results passed here are "used", so compiler can not
+ * remove computations of benchmarked code.
+ */
+void bench_consume(uint64_t value);
+
+#endif /* BENCH_H */
@@ -0,0 +1,196 @@
+/*
+ * Allocators against glibc malloc.
+ *
+ * request: one request allocates 64 small blocks of mixed
+ * sizes, then frees all of them (free one by one against
+ * arena_reset).
+ * data/<threads>: every thread gets and puts back batches
+ * of 64 struct data (alignment.h, 128-byte aligned), through
+ * aligned_alloc/free or its own pool_cache, 1 to 64 threads.
+ * fragmentation: after churn leaving every 4th object
+ * alive, bytes taken from system per live byte (malloc is
+ * measured by mallinfo2, main arena, single thread).
+ * BENCH_N sets allocations per call (default 2^18).
+ */
+
+/* for mallinfo2 */
+#define _GNU_SOURCE
+
+#include "bench.h"
+#include "alignment.h"
+#include "arena.h"
+#include "pool.h"
+#include <stdlib.h>
+/* for: malloc, aligned_alloc, free, getenv, strtoul */
+#include <stdio.h>
+/* for: fprintf, snprintf */
+#include <malloc.h>
+/* for: mallinfo2 */
+#include <threads.h>
+/* for: thrd_create, thrd_join */
+
+#define BATCH 64
+#define MAX_THREADS 64
+
+static size_t const request_sizes[8] = {16, 24, 40, 64, 24, 96, 32, 200};
+
+struct alloc_case {
+    size_t count;           /* allocations per call */
+    size_t threads;
+    struct arena arena;
+    struct pool pool;
+};
+
+static void run_request_malloc(void* ctx) {
+    struct alloc_case* c = ctx;
+    void* block[BATCH];
+    size_t done, i;
+
+    for( done = 0; done < c->count; done += BATCH ) {
+        for( i = 0; i < BATCH; i++ ) {
+            block[i] = malloc(request_sizes[i % 8]);
+            *(char*)block[i] = (char)i;
+        }
+        for( i = 0; i < BATCH; i++ )
+            free(block[i]);
+    }
+}
+
+static void run_request_arena(void* ctx) {
+    struct alloc_case* c = ctx;
+    size_t done, i;
+
+    for( done = 0; done < c->count; done += BATCH ) {
+        for( i = 0; i < BATCH; i++ ) {
+            char* block = arena_alloc(&c->arena, request_sizes[i % 8],
+                                      alignof(max_align_t));
+            *block = (char)i;
+        }
+        arena_reset(&c->arena);
+    }
+}
+
+struct worker {
+    struct alloc_case* c;
+    size_t count;
+};
+
+static int churn_malloc(void* arg) {
+    struct worker* w = arg;
+    struct data* d[BATCH];
+    size_t done, i;
+
+    for( done = 0; done < w->count; done += BATCH ) {
+        for( i = 0; i < BATCH; i++ ) {
+            d[i] = aligned_alloc(alignof(struct data), sizeof(struct data));
+            d[i]->x = (char)i;
+        }
+        for( i = 0; i < BATCH; i++ )
+            free(d[i]);
+    }
+    return 0;
+}
+
+static int churn_pool(void* arg) {
+    struct worker* w = arg;
+    struct pool_cache cache;
+    struct data* d[BATCH];
+    size_t done, i;
+
+    pool_cache_init(&cache, &w->c->pool);
+    for( done = 0; done < w->count; done += BATCH ) {
+        for( i = 0; i < BATCH; i++ ) {
+            d[i] = pool_get(&cache);
+            d[i]->x = (char)i;
+        }
+        for( i = 0; i < BATCH; i++ )
+            pool_put(&cache, d[i]);
+    }
+    pool_cache_flush(&cache);
+    return 0;
+}
+
+static void run_threads(struct alloc_case* c, thrd_start_t fn) {
+    thrd_t ids[MAX_THREADS];
+    struct worker w[MAX_THREADS];
+    size_t i, started;
+
+    for( started = 0; started < c->threads; started++ ) {
+        w[started].c = c;
+        w[started].count = c->count / c->threads;
+        if (thrd_create(&ids[started], fn, &w[started]) != thrd_success)
+            break;
+    }
+    for( i = 0; i < started; i++ )
+        thrd_join(ids[i], NULL);
+}
+
+static void run_data_malloc(void* ctx) { run_threads(ctx, churn_malloc); }
+static void run_data_pool(void* ctx) { run_threads(ctx, churn_pool); }
+
+/* every 4th of count objects stays alive, reserved / live bytes */
+static void fragmentation(struct alloc_case* c) {
+    struct data** d = malloc(c->count * sizeof(struct data*));
+    struct pool_cache cache;
+    struct mallinfo2 before, after;
+    double live = (double)(c->count / 4) * sizeof(struct data);
+    size_t i;
+
+    if (d == NULL)
+        return;
+    before = mallinfo2();
+    for( i = 0; i < c->count; i++ )
+        d[i] = aligned_alloc(alignof(struct data), sizeof(struct data));
+    for( i = 0; i < c->count; i++ )
+        if (i % 4 != 0)
+            free(d[i]);
+    after = mallinfo2();
+    bench_metric("fragmentation/malloc", "reserved/live",
+                 (double)(after.arena + after.hblkhd - before.arena - before.hblkhd) / live);
+    for( i = 0; i < c->count; i += 4 )
+        free(d[i]);
+
+    pool_free(&c->pool);
+    pool_init_type(&c->pool, struct data);
+    pool_cache_init(&cache, &c->pool);
+    for( i = 0; i < c->count; i++ )
+        d[i] = pool_get(&cache);
+    for( i = 0; i < c->count; i++ )
+        if (i % 4 != 0)
+            pool_put(&cache, d[i]);
+    bench_metric("fragmentation/pool", "reserved/live",
+                 (double)pool_reserved(&c->pool) / live);
+    free(d);
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)1 << 18;
+    struct alloc_case c;
+    char name[64];
+
+    c.count = (count + BATCH * MAX_THREADS - 1) / (BATCH * MAX_THREADS)
+              * BATCH * MAX_THREADS;
+    c.threads = 1;
+    if (!arena_init(&c.arena, BATCH * 256) || !pool_init_type(&c.pool, struct data)) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+
+    bench_init("alloc");
+    bench_run("request/malloc_free", run_request_malloc, &c, c.count, 0);
+    bench_run("request/arena_reset", run_request_arena, &c, c.count, 0);
+    bench_unpin();
+    for( c.threads = 1; c.threads <= MAX_THREADS; c.threads *= 2 ) {
+        snprintf(name, sizeof name, "data/%zu/aligned_alloc", c.threads);
+        bench_run(name, run_data_malloc, &c, c.count, sizeof(struct data));
+        snprintf(name, sizeof name, "data/%zu/pool", c.threads);
+        bench_run(name, run_data_pool, &c, c.count, sizeof(struct data));
+    }
+    bench_pin();
+    fragmentation(&c);
+
+    pool_free(&c.pool);
+    arena_free(&c.arena);
+    return bench_finish();
+}
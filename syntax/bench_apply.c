@@ -0,0 +1,167 @@
+/* 
+ * Batched apply (apply.h) of circle_area over int arrays:
+ *   pointer   apply_n, one indirect call per element
+ *   inline    apply_n_circle_area, body inlined and vectorized
+ *   threads   apply_batch_circle_area split by apply_n_parallel
+ *             (one thread per online CPU, run unpinned)
+ * at 1K, 1M and BENCH_N elements (default 1G, 12 GB of input
+ * and output; skipped when it does not fit in free memory).
+ * Every case also reports elements per second.
+ */
+
+/* for sysconf(_SC_AVPHYS_PAGES) */
+#define _DEFAULT_SOURCE
+
+#include "bench.h"
+#include "apply.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul */
+#include <stdio.h>
+/* for: snprintf, fprintf */
+#include <stdbool.h>
+/* for: bool */
+#include <unistd.h>
+/* for: sysconf */
+
+struct apply_case {
+    int* in;
+    double* out;
+    size_t n;
+};
+
+/* pointer through volatile, so it is not known at compile time */
+static fun_int_to_double* volatile function = circle_area;
+
+static void run_pointer(void* ctx) {
+    struct apply_case* c = ctx;
+
+    apply_n(function, c->in, c->out, c->n);
+    bench_consume((uint64_t)c->out[c->n - 1]);
+}
+
+static void run_inline(void* ctx) {
+    struct apply_case* c = ctx;
+
+    apply_n_circle_area(c->in, c->out, c->n);
+    bench_consume((uint64_t)c->out[c->n - 1]);
+}
+
+static void run_threads(void* ctx) {
+    struct apply_case* c = ctx;
+
+    apply_n_parallel(apply_batch_circle_area, NULL, c->in, c->out, c->n, 0);
+    bench_consume((uint64_t)c->out[c->n - 1]);
+}
+
+static void modes(struct apply_case* c, char const* size_name) {
+    static struct {
+        char const* name;
+        bench_fn* run;
+        bool threaded;
+    } const all[] = {
+        {"pointer", run_pointer, false},
+        {"inline", run_inline, false},
+        {"threads", run_threads, true}
+    };
+    char name[64];
+    double ns;
+    size_t i;
+
+    for( i = 0; i < sizeof all / sizeof all[0]; i++ ) {
+        snprintf(name, sizeof(name), "apply_n/%s/%s", all[i].name, size_name);
+        if (all[i].threaded)
+            bench_unpin();
+        ns = bench_run(name, all[i].run, c, c->n, sizeof(int) + sizeof(double));
+        if (all[i].threaded)
+            bench_pin();
+        bench_rate(name, "M elements/s", ns);
+    }
+}
+
+/* free physical memory in bytes, (size_t)-1 when unknown */
+static size_t free_memory(void) {
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long page = sysconf(_SC_PAGESIZE);
+
+    if (pages < 0 || page < 0)
+        return (size_t)-1;
+    if ((unsigned long)pages > (size_t)-1 / (unsigned long)page)
+        return (size_t)-1;
+    return (size_t)pages * (size_t)page;
+}
+
+/* results of every mode equal to apply of circle_area */
+static int check(struct apply_case* c) {
+    double* expected = malloc(c->n * sizeof(double));
+    size_t i;
+    int ok = expected != NULL;
+
+    for( i = 0; ok && i < c->n; i++ )
+        expected[i] = apply(&circle_area, c->in[i]);
+    apply_n(circle_area, c->in, c->out, c->n);
+    for( i = 0; ok && i < c->n; i++ )
+        ok = c->out[i] == expected[i];
+    apply_n_circle_area(c->in, c->out, c->n);
+    for( i = 0; ok && i < c->n; i++ )
+        ok = c->out[i] == expected[i];
+    apply_n_parallel(apply_batch_circle_area, NULL, c->in, c->out, c->n, 4);
+    for( i = 0; ok && i < c->n; i++ )
+        ok = c->out[i] == expected[i];
+    free(expected);
+    return ok;
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t big = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)1 << 30;
+    size_t count = big > (size_t)1 << 20 ? big : (size_t)1 << 20;
+    struct apply_case c;
+    size_t i;
+
+    /* 
+     * With overcommit malloc of too much rarely fails, the
+     * init loop below gets killed instead, so check first.
+     */
+    if (count > free_memory() / (sizeof(int) + sizeof(double))) {
+        fprintf(stderr, "Not enough free memory for %zu elements (lower BENCH_N)\n", count);
+        count = (size_t)1 << 20;
+        big = 0;
+    }
+    c.in = malloc(count * sizeof(int));
+    c.out = malloc(count * sizeof(double));
+    if (c.in == NULL || c.out == NULL) {
+        /* big size does not fit, the others still run */
+        fprintf(stderr, "Not enough memory for %zu elements (lower BENCH_N)\n", count);
+        free(c.in);
+        free(c.out);
+        count = (size_t)1 << 20;
+        big = 0;
+        c.in = malloc(count * sizeof(int));
+        c.out = malloc(count * sizeof(double));
+        if (c.in == NULL || c.out == NULL) {
+            fprintf(stderr, "Not enough memory\n");
+            return 1;
+        }
+    }
+    for( i = 0; i < count; i++ )
+        c.in[i] = (int)(i * 7919 % 1000);
+    c.n = (size_t)1 << 20;
+    if (!check(&c)) {
+        fprintf(stderr, "apply_n modes differ from apply\n");
+        return 1;
+    }
+
+    bench_init("apply");
+    c.n = 1024;
+    modes(&c, "1K");
+    c.n = (size_t)1 << 20;
+    modes(&c, "1M");
+    if (big > c.n) {
+        c.n = big;
+        modes(&c, big == (size_t)1 << 30 ? "1G" : "big");
+    }
+
+    free(c.in);
+    free(c.out);
+    return bench_finish();
+}
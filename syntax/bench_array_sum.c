@@ -0,0 +1,110 @@
+/* 
+ * Benchmarks of array_sum kernels (array_sum.h).
+ * $ make bench   or   ./bin/bench/bench_array_sum > out.json
+ * BENCH_N sets element count of big arrays (default 2^24).
+ */
+
+#include "bench.h"
+#include "array_sum.h"
+#include <stdlib.h>
+/* for: malloc, getenv, strtoul */
+#include <stdio.h>
+/* for: snprintf */
+
+struct sum_case {
+    int const* ints;
+    short const* shorts;
+    unsigned const* uints;
+    size_t count;
+    array_sum_kernel* acc;
+};
+
+static void run_kernel(void* ctx) {
+    struct sum_case* c = ctx;
+    int sum = 0;
+
+    bench_consume(c->acc(c->ints, c->count, &sum) ? (uint64_t)sum : 0);
+}
+
+static void run_array_sum(void* ctx) {
+    struct sum_case* c = ctx;
+
+    bench_consume((uint64_t)array_sum(c->ints, c->count));
+}
+
+static void run_parallel(void* ctx) {
+    struct sum_case* c = ctx;
+
+    bench_consume((uint64_t)array_sum_parallel(c->ints, c->count, 0));
+}
+
+static void run_shorts(void* ctx) {
+    struct sum_case* c = ctx;
+
+    bench_consume((uint64_t)array_sum(c->shorts, c->count));
+}
+
+static void run_uints(void* ctx) {
+    struct sum_case* c = ctx;
+
+    bench_consume(array_sum(c->uints, c->count));
+}
+
+static void sizes(struct sum_case* c, char const* size_name) {
+    struct array_sum_variant const* v;
+    char name[64];
+
+    for( v = array_sum_variants(); v->name != NULL; v++ ) {
+        if (!array_sum_supported(v))
+            continue;
+        c->acc = v->acc;
+        snprintf(name, sizeof(name), "array_sum/%s/%s", v->name, size_name);
+        bench_run(name, run_kernel, c, c->count, sizeof(int));
+    }
+    snprintf(name, sizeof(name), "array_sum/dispatch/%s", size_name);
+    bench_run(name, run_array_sum, c, c->count, sizeof(int));
+    snprintf(name, sizeof(name), "array_sum_parallel/%s", size_name);
+    bench_unpin();
+    bench_run(name, run_parallel, c, c->count, sizeof(int));
+    bench_pin();
+    snprintf(name, sizeof(name), "array_sum/int16_t/%s", size_name);
+    bench_run(name, run_shorts, c, c->count, sizeof(short));
+    snprintf(name, sizeof(name), "array_sum/uint32_t/%s", size_name);
+    bench_run(name, run_uints, c, c->count, sizeof(unsigned));
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)1 << 24;
+    int* ints = malloc(count * sizeof(int));
+    short* shorts = malloc(count * sizeof(short));
+    unsigned* uints = malloc(count * sizeof(unsigned));
+    struct sum_case c;
+    size_t i;
+
+    if (ints == NULL || shorts == NULL || uints == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    for( i = 0; i < count; i++ ) {
+        ints[i] = (int)(i % 2001) - 1000;
+        shorts[i] = (short)ints[i];
+        uints[i] = (unsigned)i;
+    }
+    c.ints = ints;
+    c.shorts = shorts;
+    c.uints = uints;
+
+    bench_init("array_sum");
+    /* L1 resident */
+    c.count = count < 4096 ? count : 4096;
+    sizes(&c, "4K");
+    /* memory bound */
+    c.count = count;
+    sizes(&c, "big");
+
+    free(ints);
+    free(shorts);
+    free(uints);
+    return bench_finish();
+}
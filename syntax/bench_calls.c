@@ -0,0 +1,98 @@
+/* 
+ * Benchmarks of call patterns from the examples:
+ * apply/circle_area indirect call (apply.h, c_synt.c) and
+ * pair_int_any predicate call through pointer (pair.h,
+ * polymorphisms.c).
+ */
+
+#include "bench.h"
+#include "apply.h"
+#include "pair.h"
+#include <stdlib.h>
+/* for: malloc */
+#include <stdio.h>
+/* for: fprintf */
+
+#define CALLS_N 4096
+
+DEFINE_PAIR(int)
+bool is_positive( int x ) { return x > 0; }
+
+struct calls_case {
+    int ints[CALLS_N];
+    struct pair(int) pairs[CALLS_N];
+};
+
+/* apply is in apply.c, so compiler sees two real calls */
+static void run_apply(void* ctx) {
+    struct calls_case* c = ctx;
+    double sum = 0;
+    size_t i;
+
+    for( i = 0; i < CALLS_N; i++ )
+        sum += apply(&circle_area, c->ints[i]);
+    bench_consume((uint64_t)sum);
+}
+
+/* pointer through volatile, so it is not known at compile time */
+static fun_int_to_double* volatile function = circle_area;
+
+static void run_pointer(void* ctx) {
+    struct calls_case* c = ctx;
+    fun_int_to_double* f = function;
+    double sum = 0;
+    size_t i;
+
+    for( i = 0; i < CALLS_N; i++ )
+        sum += f(c->ints[i]);
+    bench_consume((uint64_t)sum);
+}
+
+static void run_direct(void* ctx) {
+    struct calls_case* c = ctx;
+    double sum = 0;
+    size_t i;
+
+    for( i = 0; i < CALLS_N; i++ )
+        sum += circle_area(c->ints[i]);
+    bench_consume((uint64_t)sum);
+}
+
+/* predicate through volatile too, as a caller from other module */
+static bool (* volatile predicate)(int) = is_positive;
+
+static void run_pair_any(void* ctx) {
+    struct calls_case* c = ctx;
+    bool (*p)(int) = predicate;
+    uint64_t count = 0;
+    size_t i;
+
+    for( i = 0; i < CALLS_N; i++ )
+        count += any(int)(c->pairs[i], p);
+    bench_consume(count);
+}
+
+int main(void) {
+    struct calls_case* c = malloc(sizeof(*c));
+    size_t i;
+
+    if (c == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    for( i = 0; i < CALLS_N; i++ ) {
+        c->ints[i] = (int)(i * 7919 % 1000);
+        c->pairs[i].fst = (int)(i * 7919 % 1001) - 500;
+        c->pairs[i].snd = (int)(i * 104729 % 1003) - 500;
+    }
+
+    bench_init("calls");
+    bench_run("apply/circle_area", run_apply, c, CALLS_N, sizeof(int));
+    bench_run("pointer/circle_area", run_pointer, c, CALLS_N, sizeof(int));
+    bench_run("direct/circle_area", run_direct, c, CALLS_N, sizeof(int));
+    bench_run("pair_int_any/is_positive", run_pair_any, c, CALLS_N, 
+              sizeof(struct pair(int)));
+
+    free(c);
+    return bench_finish();
+}
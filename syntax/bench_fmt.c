@@ -0,0 +1,254 @@
+/*
+ * Number formatting: fmt.h against snprintf with the same
+ * conversions. First checks that both write same text for
+ * the cases of printf_patterns in c_synt.c and for random
+ * numbers (shortest doubles must read back same), fails
+ * when they differ.
+ * BENCH_N sets count of numbers per case (default 2^16).
+ */
+
+#include "bench.h"
+#include "fmt.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul, strtod */
+#include <stdio.h>
+/* for: snprintf, fprintf */
+#include <string.h>
+/* for: strcmp, memcpy */
+#include <stdint.h>
+/* for: uint64_t, int64_t */
+#include <inttypes.h>
+/* for: PRIi64 */
+#include <stdbool.h>
+/* for: bool */
+
+struct fmt_case {
+    int* ints;
+    int64_t* longs;
+    double* doubles;
+    size_t count;
+};
+
+static bool same(char const* what, char const* ours, char const* printfs) {
+    if (strcmp(ours, printfs) == 0)
+        return true;
+    fprintf(stderr, "%s: fmt wrote \"%s\", printf \"%s\"\n", what, ours, printfs);
+    return false;
+}
+
+static bool check(struct fmt_case const* c) {
+    char ours[FMT_BUFFER_SIZE], printfs[FMT_BUFFER_SIZE];
+    bool ok = true;
+    size_t i;
+
+    /* conversions used in printf_patterns */
+    fmt(ours, -1);
+    snprintf(printfs, sizeof printfs, "%d", -1);
+    ok &= same("%d", ours, printfs);
+    fmt(ours, 3u);
+    snprintf(printfs, sizeof printfs, "%u", 3u);
+    ok &= same("%u", ours, printfs);
+    fmt_hex(ours, 3);
+    snprintf(printfs, sizeof printfs, "%x", 3);
+    ok &= same("%x", ours, printfs);
+    fmt(ours, (int64_t)-10);
+    snprintf(printfs, sizeof printfs, "%" PRIi64, (int64_t)-10);
+    ok &= same("%" PRIi64, ours, printfs);
+    fmt_g(ours, 3.14152, 6);
+    snprintf(printfs, sizeof printfs, "%g", 3.14152);
+    ok &= same("%g", ours, printfs);
+    fmt_g(ours, 3.14152111, 6);
+    snprintf(printfs, sizeof printfs, "%.6g", 3.14152111);
+    ok &= same("%.6g", ours, printfs);
+    fmt_g(ours, -(0.0/0.0), 6);
+    snprintf(printfs, sizeof printfs, "%g", -(0.0/0.0));
+    ok &= same("%g", ours, printfs);
+    fmt_g(ours, -(1.0/0.0), 6);
+    snprintf(printfs, sizeof printfs, "%g", -(1.0/0.0));
+    ok &= same("%g", ours, printfs);
+
+    for( i = 0; i < c->count && ok; i++ ) {
+        fmt(ours, c->ints[i]);
+        snprintf(printfs, sizeof printfs, "%d", c->ints[i]);
+        ok &= same("%d", ours, printfs);
+        fmt(ours, c->longs[i]);
+        snprintf(printfs, sizeof printfs, "%" PRIi64, c->longs[i]);
+        ok &= same("%" PRIi64, ours, printfs);
+        fmt_hex(ours, (uint64_t)c->longs[i]);
+        snprintf(printfs, sizeof printfs, "%llx", (unsigned long long)c->longs[i]);
+        ok &= same("%llx", ours, printfs);
+        fmt_g(ours, c->doubles[i], (int)(i % 18));
+        snprintf(printfs, sizeof printfs, "%.*g", (int)(i % 18), c->doubles[i]);
+        ok &= same("%.*g", ours, printfs);
+        fmt(ours, c->doubles[i]);
+        if (strtod(ours, NULL) != c->doubles[i]) {
+            fprintf(stderr, "shortest: %s does not read back as %.17g\n",
+                    ours, c->doubles[i]);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+static void run_snprintf_int(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += (uint64_t)snprintf(buffer, sizeof buffer, "%d", c->ints[i]);
+    bench_consume(length);
+}
+
+static void run_fmt_int(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += fmt_int(buffer, c->ints[i]);
+    bench_consume(length);
+}
+
+static void run_snprintf_int64(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += (uint64_t)snprintf(buffer, sizeof buffer, "%" PRIi64, c->longs[i]);
+    bench_consume(length);
+}
+
+static void run_fmt_int64(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += fmt(buffer, c->longs[i]);
+    bench_consume(length);
+}
+
+static void run_snprintf_hex(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += (uint64_t)snprintf(buffer, sizeof buffer, "%llx",
+                                     (unsigned long long)c->longs[i]);
+    bench_consume(length);
+}
+
+static void run_fmt_hex(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += fmt_hex(buffer, (uint64_t)c->longs[i]);
+    bench_consume(length);
+}
+
+static void run_snprintf_g(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += (uint64_t)snprintf(buffer, sizeof buffer, "%g", c->doubles[i]);
+    bench_consume(length);
+}
+
+static void run_fmt_g(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += fmt_g(buffer, c->doubles[i], 6);
+    bench_consume(length);
+}
+
+/* %.17g is what printf needs to round trip every double */
+static void run_snprintf_round_trip(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += (uint64_t)snprintf(buffer, sizeof buffer, "%.17g", c->doubles[i]);
+    bench_consume(length);
+}
+
+static void run_fmt_shortest(void* ctx) {
+    struct fmt_case* c = ctx;
+    char buffer[FMT_BUFFER_SIZE];
+    uint64_t length = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        length += fmt_double(buffer, c->doubles[i]);
+    bench_consume(length);
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)1 << 16;
+    struct fmt_case c;
+    uint64_t state = 0x9e3779b97f4a7c15u;
+    size_t i;
+
+    c.count = count;
+    c.ints = malloc(count * sizeof(int));
+    c.longs = malloc(count * sizeof(int64_t));
+    c.doubles = malloc(count * sizeof(double));
+    if (c.ints == NULL || c.longs == NULL || c.doubles == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    /* xorshift, numbers of all lengths */
+    for( i = 0; i < count; i++ ) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        c.ints[i] = (int)(uint32_t)(state >> (state % 32));
+        c.longs[i] = (int64_t)(state >> (state % 64));
+        /* "measured" values with few digits and random bit patterns */
+        if (i % 2 == 0)
+            c.doubles[i] = (double)(int64_t)(state % 2000001 - 1000000) / 1000;
+        else
+            memcpy(&c.doubles[i], &state, sizeof(double));
+        if (c.doubles[i] != c.doubles[i])
+            c.doubles[i] = (double)i;
+    }
+    if (!check(&c))
+        return 1;
+
+    bench_init("fmt");
+    bench_run("int/snprintf", run_snprintf_int, &c, count, 0);
+    bench_run("int/fmt", run_fmt_int, &c, count, 0);
+    bench_run("int64/snprintf", run_snprintf_int64, &c, count, 0);
+    bench_run("int64/fmt", run_fmt_int64, &c, count, 0);
+    bench_run("hex/snprintf", run_snprintf_hex, &c, count, 0);
+    bench_run("hex/fmt", run_fmt_hex, &c, count, 0);
+    bench_run("double_g/snprintf", run_snprintf_g, &c, count, 0);
+    bench_run("double_g/fmt", run_fmt_g, &c, count, 0);
+    bench_run("double_round_trip/snprintf_17g", run_snprintf_round_trip, &c, count, 0);
+    bench_run("double_round_trip/fmt_shortest", run_fmt_shortest, &c, count, 0);
+
+    free(c.ints);
+    free(c.longs);
+    free(c.doubles);
+    return bench_finish();
+}
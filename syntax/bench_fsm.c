@@ -0,0 +1,185 @@
+/*
+ * Traffic light state machine of fsm.h (enum light of
+ * c_synt.c with transitions) fed BENCH_N (default 1M) events,
+ * time per event of every backend on two streams:
+ *   random   tick, fault, reset equally likely: next state
+ *            is a coin toss, branches mispredict
+ *   skewed   98% tick, 1% fault, 1% reset: the light cycles,
+ *            transitions mostly follow each other in order
+ */
+
+#include "bench.h"
+#include "fsm.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul */
+#include <stdio.h>
+/* for: fprintf, snprintf */
+#include <string.h>
+/* for: memset, memcmp */
+#include <stdint.h>
+/* for: uint64_t */
+
+struct light_stats {
+    uint64_t go;
+    uint64_t stop;
+    uint64_t fault;
+    uint64_t blink;
+};
+
+static void count_go(void* ctx) {
+    ((struct light_stats*)ctx)->go++;
+}
+
+static void count_stop(void* ctx) {
+    ((struct light_stats*)ctx)->stop++;
+}
+
+static void count_fault(void* ctx) {
+    ((struct light_stats*)ctx)->fault++;
+}
+
+static void count_blink(void* ctx) {
+    ((struct light_stats*)ctx)->blink++;
+}
+
+/* first state is the reset one */
+#define LIGHT_STATES(X, P) \
+    X(P, RED) X(P, RED_AND_YELLOW) X(P, GREEN) X(P, YELLOW) X(P, NOTHING)
+#define LIGHT_EVENTS(X, P) X(P, TICK) X(P, FAULT) X(P, RESET)
+#define LIGHT_TRANSITIONS(X, P) \
+    X(P, RED, TICK, RED_AND_YELLOW, fsm_none) \
+    X(P, RED_AND_YELLOW, TICK, GREEN, count_go) \
+    X(P, GREEN, TICK, YELLOW, fsm_none) \
+    X(P, YELLOW, TICK, RED, count_stop) \
+    X(P, RED, FAULT, NOTHING, count_fault) \
+    X(P, RED_AND_YELLOW, FAULT, NOTHING, count_fault) \
+    X(P, GREEN, FAULT, NOTHING, count_fault) \
+    X(P, YELLOW, FAULT, NOTHING, count_fault) \
+    X(P, NOTHING, TICK, NOTHING, count_blink) \
+    X(P, NOTHING, RESET, RED, fsm_none)
+DEFINE_FSM(light, LIGHT, LIGHT_STATES, LIGHT_EVENTS, LIGHT_TRANSITIONS)
+
+/* same machine by hand, unlisted pairs reset */
+static enum light_state expected_next(enum light_state state, enum light_event event) {
+    if (event == LIGHT_FAULT)
+        return state == LIGHT_NOTHING ? LIGHT_RED : LIGHT_NOTHING;
+    if (event == LIGHT_RESET)
+        return LIGHT_RED;
+    switch (state) {
+    case LIGHT_RED: return LIGHT_RED_AND_YELLOW;
+    case LIGHT_RED_AND_YELLOW: return LIGHT_GREEN;
+    case LIGHT_GREEN: return LIGHT_YELLOW;
+    case LIGHT_YELLOW: return LIGHT_RED;
+    default: return LIGHT_NOTHING;
+    }
+}
+
+typedef enum light_state (light_run)(
+    enum light_state state, unsigned char const* events, size_t n, void* ctx);
+
+struct fsm_case {
+    light_run* run;
+    unsigned char const* events;
+    size_t n;
+    struct light_stats stats;
+};
+
+static void run_case(void* ctx) {
+    struct fsm_case* c = ctx;
+
+    bench_consume(c->run(LIGHT_RED, c->events, c->n, &c->stats));
+}
+
+static uint64_t next_random(uint64_t* x) {
+    *x ^= *x << 13;
+    *x ^= *x >> 7;
+    *x ^= *x << 17;
+    return *x;
+}
+
+/* tick unless below per mille fault, reset */
+static void fill(unsigned char* events, size_t n, unsigned fault, unsigned reset) {
+    uint64_t x = 88172645463325252u;
+    size_t i;
+
+    for( i = 0; i < n; i++ ) {
+        unsigned r = (unsigned)(next_random(&x) >> 32) % 1000;
+
+        events[i] = r < fault ? LIGHT_FAULT : r < fault + reset ? LIGHT_RESET : LIGHT_TICK;
+    }
+}
+
+int main(void) {
+    char const* env_n = getenv("BENCH_N");
+    size_t n = env_n != NULL ? (size_t)strtoul(env_n, NULL, 10) : (size_t)1 << 20;
+    unsigned char* events = malloc(n > 0 ? n : 1);
+    static struct {
+        char const* name;
+        light_run* run;
+    } const backends[] = {
+        {"table", light_run_table},
+        {"switch", light_run_switch},
+#if FSM_GOTO
+        {"goto", light_run_goto},
+#endif
+    };
+    static struct {
+        char const* name;
+        unsigned fault, reset;  /* per mille */
+    } const streams[] = {
+        {"random", 333, 333},
+        {"skewed", 10, 10}
+    };
+    size_t s, b;  /* also state, event of table check */
+
+    if (events == NULL) {
+        fprintf(stderr, "Not enough memory (lower BENCH_N)\n");
+        return 1;
+    }
+    for( s = 0; s < light_states; s++ )
+        for( b = 0; b < light_events; b++ )
+            if (light_next[s][b] != expected_next((enum light_state)s, (enum light_event)b)) {
+                fprintf(stderr, "Transition %s on %s is wrong\n",
+                        light_state_names[s], light_event_names[b]);
+                return 1;
+            }
+    /* every backend ends in same state with same actions taken */
+    for( s = 0; s < sizeof streams / sizeof streams[0]; s++ ) {
+        struct light_stats expected, got;
+        enum light_state last;
+
+        fill(events, n, streams[s].fault, streams[s].reset);
+        memset(&expected, 0, sizeof expected);
+        last = light_run_table(LIGHT_RED, events, n, &expected);
+        for( b = 1; b < sizeof backends / sizeof backends[0]; b++ ) {
+            memset(&got, 0, sizeof got);
+            if (backends[b].run(LIGHT_RED, events, n, &got) != last
+                    || memcmp(&got, &expected, sizeof got) != 0) {
+                fprintf(stderr, "Backend %s differs on %s events\n",
+                        backends[b].name, streams[s].name);
+                return 1;
+            }
+        }
+    }
+
+    bench_init("fsm");
+    for( s = 0; s < sizeof streams / sizeof streams[0]; s++ ) {
+        fill(events, n, streams[s].fault, streams[s].reset);
+        for( b = 0; b < sizeof backends / sizeof backends[0]; b++ ) {
+            struct fsm_case c;
+            char name[64];
+            double ns;
+
+            memset(&c, 0, sizeof c);
+            c.run = backends[b].run;
+            c.events = events;
+            c.n = n;
+            snprintf(name, sizeof name, "light/%s/%s", streams[s].name, backends[b].name);
+            ns = bench_run(name, run_case, &c, n, 1);
+            bench_rate(name, "M events/s", ns);
+        }
+    }
+
+    free(events);
+    return bench_finish();
+}
@@ -0,0 +1,231 @@
+/* 
+ * Insert, lookup and erase throughput and memory per entry of
+ * DEFINE_HASHMAP (hashmap.h), against a chained hash table
+ * with one malloc'ed node per entry.
+ * Sizes are 1K and 1M keys, plus BENCH_N keys when set
+ * (e.g. BENCH_N=100000000 needs about 4 GB).
+ */
+
+#include "bench.h"
+#include "hashmap.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoull */
+#include <stdio.h>
+/* for: fprintf, snprintf */
+
+#define u64_hash(key) hashmap_mix(key)
+#define u64_eq(a, b) ((a) == (b))
+
+DEFINE_HASHMAP(u64, uint64_t, uint64_t, u64_hash, u64_eq)
+
+/* chained table, like the ones we replace */
+struct node {
+    uint64_t key;
+    uint64_t value;
+    struct node* next;
+};
+struct chained {
+    struct node** buckets;
+    size_t mask;
+};
+
+static bool chained_init(struct chained* t, size_t n) {
+    size_t buckets = 16;
+
+    while (buckets < n)
+        buckets *= 2;
+    t->buckets = calloc(buckets, sizeof(struct node*));
+    t->mask = buckets - 1;
+    return t->buckets != NULL;
+}
+
+static void chained_insert(struct chained* t, uint64_t key, uint64_t value) {
+    struct node** head = &t->buckets[hashmap_mix(key) & t->mask];
+    struct node* n;
+
+    for( n = *head; n != NULL; n = n->next )
+        if (n->key == key) {
+            n->value = value;
+            return;
+        }
+    n = malloc(sizeof(*n));
+    if (n == NULL)
+        return;
+    n->key = key;
+    n->value = value;
+    n->next = *head;
+    *head = n;
+}
+
+static uint64_t* chained_find(struct chained const* t, uint64_t key) {
+    struct node* n;
+
+    for( n = t->buckets[hashmap_mix(key) & t->mask]; n != NULL; n = n->next )
+        if (n->key == key)
+            return &n->value;
+    return NULL;
+}
+
+static void chained_free(struct chained* t) {
+    size_t i;
+
+    for( i = 0; i <= t->mask; i++ ) {
+        struct node* n = t->buckets[i];
+        while (n != NULL) {
+            struct node* next = n->next;
+            free(n);
+            n = next;
+        }
+    }
+    free(t->buckets);
+}
+
+struct map_case {
+    uint64_t* keys;     /* present keys, shuffled */
+    uint64_t* misses;   /* absent keys */
+    size_t count;
+    struct hashmap(u64) map;
+    struct chained chained;
+};
+
+static void run_insert(void* ctx) {
+    struct map_case* c = ctx;
+    struct hashmap(u64) m;
+    size_t i;
+
+    hashmap_u64_init(&m, allocator_malloc);
+    for( i = 0; i < c->count; i++ )
+        hashmap_u64_insert(&m, c->keys[i], i);
+    bench_consume(m.size);
+    hashmap_u64_free(&m);
+}
+
+static void run_find_hit(void* ctx) {
+    struct map_case* c = ctx;
+    uint64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        sum += *hashmap_u64_find(&c->map, c->keys[i]);
+    bench_consume(sum);
+}
+
+static void run_find_miss(void* ctx) {
+    struct map_case* c = ctx;
+    uint64_t found = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        found += hashmap_u64_find(&c->map, c->misses[i]) != NULL;
+    bench_consume(found);
+}
+
+/* erases every key and puts it back, so the map is reusable */
+static void run_erase_insert(void* ctx) {
+    struct map_case* c = ctx;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        hashmap_u64_erase(&c->map, c->keys[i]);
+    for( i = 0; i < c->count; i++ )
+        hashmap_u64_insert(&c->map, c->keys[i], i);
+    bench_consume(c->map.size);
+}
+
+static void run_chained_insert(void* ctx) {
+    struct map_case* c = ctx;
+    struct chained t;
+    size_t i;
+
+    if (!chained_init(&t, c->count))
+        return;
+    for( i = 0; i < c->count; i++ )
+        chained_insert(&t, c->keys[i], i);
+    chained_free(&t);
+}
+
+static void run_chained_find_hit(void* ctx) {
+    struct map_case* c = ctx;
+    uint64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        sum += *chained_find(&c->chained, c->keys[i]);
+    bench_consume(sum);
+}
+
+static void run_size(struct map_case* c, char const* size_name) {
+    char name[64];
+    size_t i;
+
+    hashmap_u64_init(&c->map, allocator_malloc);
+    for( i = 0; i < c->count; i++ )
+        hashmap_u64_insert(&c->map, c->keys[i], i);
+    if (c->map.size != c->count)
+        fprintf(stderr, "hashmap lost keys: %zu of %zu\n", c->map.size, c->count);
+
+    snprintf(name, sizeof(name), "hashmap/insert/%s", size_name);
+    bench_run(name, run_insert, c, c->count, 0);
+    snprintf(name, sizeof(name), "hashmap/find_hit/%s", size_name);
+    bench_run(name, run_find_hit, c, c->count, 0);
+    snprintf(name, sizeof(name), "hashmap/find_miss/%s", size_name);
+    bench_run(name, run_find_miss, c, c->count, 0);
+    snprintf(name, sizeof(name), "hashmap/erase+insert/%s", size_name);
+    bench_run(name, run_erase_insert, c, 2 * c->count, 0);
+    snprintf(name, sizeof(name), "hashmap/bytes_per_entry/%s", size_name);
+    bench_metric(name, "bytes", 
+        (double)hashmap_u64_bytes(c->map.capacity) / (double)c->map.size);
+    hashmap_u64_free(&c->map);
+
+    if (!chained_init(&c->chained, c->count))
+        return;
+    for( i = 0; i < c->count; i++ )
+        chained_insert(&c->chained, c->keys[i], i);
+    snprintf(name, sizeof(name), "chained/insert/%s", size_name);
+    bench_run(name, run_chained_insert, c, c->count, 0);
+    snprintf(name, sizeof(name), "chained/find_hit/%s", size_name);
+    bench_run(name, run_chained_find_hit, c, c->count, 0);
+    /* bucket pointer + node (malloc adds 16 bytes header) */
+    snprintf(name, sizeof(name), "chained/bytes_per_entry/%s", size_name);
+    bench_metric(name, "bytes", (double)((c->chained.mask + 1) * sizeof(void*))
+        / (double)c->count + (double)sizeof(struct node) + 16.0);
+    chained_free(&c->chained);
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t big = n != NULL ? (size_t)strtoull(n, NULL, 10) : 0;
+    size_t max = big > 1000000 ? big : 1000000;
+    struct map_case c;
+    uint64_t state = 42;
+    size_t i;
+
+    c.keys = malloc(max * sizeof(uint64_t));
+    c.misses = malloc(max * sizeof(uint64_t));
+    if (c.keys == NULL || c.misses == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    /* odd keys present, even keys missing, random order */
+    for( i = 0; i < max; i++ ) {
+        state = hashmap_mix(state + i);
+        c.keys[i] = state | 1;
+        c.misses[i] = state & ~(uint64_t)1;
+    }
+
+    bench_init("hashmap");
+    c.count = 1000;
+    run_size(&c, "1K");
+    c.count = 1000000;
+    run_size(&c, "1M");
+    if (big > 0) {
+        char size_name[32];
+        snprintf(size_name, sizeof(size_name), "%zu", big);
+        c.count = big;
+        run_size(&c, size_name);
+    }
+
+    free(c.keys);
+    free(c.misses);
+    return bench_finish();
+}
@@ -0,0 +1,102 @@
+/* 
+ * Benchmarks of struct layouts from alignment.h: scanning one
+ * field of an array of structs costs whole struct of memory
+ * traffic, padding included. GB/s counts struct bytes, so
+ * ns/op shows the real price of padding.
+ */
+
+#include "bench.h"
+#include "alignment.h"
+#include <stdlib.h>
+/* for: aligned_alloc, getenv, strtoul */
+#include <stdio.h>
+/* for: fprintf */
+
+struct layouts_case {
+    int* ints;
+    struct X* xs;
+    struct sse_t* sses;
+    struct data* datas;
+    size_t count;
+};
+
+static void run_ints(void* ctx) {
+    struct layouts_case* c = ctx;
+    uint64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        sum += (uint64_t)c->ints[i];
+    bench_consume(sum);
+}
+
+static void run_x(void* ctx) {
+    struct layouts_case* c = ctx;
+    uint64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        sum += (uint64_t)c->xs[i].n;
+    bench_consume(sum);
+}
+
+static void run_sse(void* ctx) {
+    struct layouts_case* c = ctx;
+    float sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        sum += c->sses[i].sse_data[0];
+    bench_consume((uint64_t)sum);
+}
+
+static void run_data(void* ctx) {
+    struct layouts_case* c = ctx;
+    uint64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        sum += (uint64_t)c->datas[i].x;
+    bench_consume(sum);
+}
+
+/* aligned_alloc needs size multiple of alignment */
+static void* alloc_array(size_t align, size_t size, size_t count) {
+    return aligned_alloc(align, (size * count + align - 1) / align * align);
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    struct layouts_case c;
+    size_t i;
+
+    c.count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)1 << 18;
+    c.ints = alloc_array(alignof(int), sizeof(int), c.count);
+    c.xs = alloc_array(alignof(struct X), sizeof(struct X), c.count);
+    c.sses = alloc_array(alignof(struct sse_t), sizeof(struct sse_t), c.count);
+    c.datas = alloc_array(alignof(struct data), sizeof(struct data), c.count);
+    if (c.ints == NULL || c.xs == NULL || c.sses == NULL || c.datas == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    for( i = 0; i < c.count; i++ ) {
+        c.ints[i] = (int)i;
+        c.xs[i].n = (int)i;
+        c.xs[i].c = 'x';
+        c.sses[i].sse_data[0] = 1.0f;
+        c.datas[i].x = (char)i;
+    }
+
+    bench_init("layouts");
+    bench_run("int[]/n", run_ints, &c, c.count, sizeof(int));
+    bench_run("struct X[]/n", run_x, &c, c.count, sizeof(struct X));
+    bench_run("struct sse_t[]/sse_data[0]", run_sse, &c, c.count, 
+              sizeof(struct sse_t));
+    bench_run("struct data[]/x", run_data, &c, c.count, sizeof(struct data));
+
+    free(c.ints);
+    free(c.xs);
+    free(c.sses);
+    free(c.datas);
+    return bench_finish();
+}
@@ -0,0 +1,153 @@
+/* 
+ * Virtual method calls over a mixed array of objects
+ * (object.h): indirect call per object against type bucketed
+ * batch dispatch. BENCH_N sets object count (default 10M).
+ */
+
+#include "bench.h"
+#include "object.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul */
+#include <stdio.h>
+/* for: fprintf */
+
+struct circle {
+    struct parent base;
+    double r;
+};
+struct square {
+    struct parent base;
+    double side;
+};
+struct triangle {
+    struct parent base;
+    double base_length;
+    double height;
+};
+
+static inline double circle_area(struct circle const* this) {
+    return 3.14159265358979 * this->r * this->r;
+}
+static inline double square_area(struct square const* this) {
+    return this->side * this->side;
+}
+static inline double triangle_area(struct triangle const* this) {
+    return 0.5 * this->base_length * this->height;
+}
+
+/* virtual versions, for the per object call */
+static double circle_area_virtual(struct parent const* this) {
+    return circle_area((struct circle const*)this);
+}
+static double square_area_virtual(struct parent const* this) {
+    return square_area((struct square const*)this);
+}
+static double triangle_area_virtual(struct parent const* this) {
+    return triangle_area((struct triangle const*)this);
+}
+
+DEFINE_OBJECT_BATCH(circle, area)
+DEFINE_OBJECT_BATCH(square, area)
+DEFINE_OBJECT_BATCH(triangle, area)
+
+static struct parent_vtable const circle_vtable = 
+    {"circle", 0, NULL, circle_area_virtual, circle_area_batch};
+static struct parent_vtable const square_vtable = 
+    {"square", 1, NULL, square_area_virtual, square_area_batch};
+static struct parent_vtable const triangle_vtable = 
+    {"triangle", 2, NULL, triangle_area_virtual, triangle_area_batch};
+
+/* one union per object, so objects of all types are interleaved */
+union shape {
+    struct parent base;
+    struct circle circle;
+    struct square square;
+    struct triangle triangle;
+};
+
+struct objects_case {
+    struct parent const** objects;
+    size_t count;
+    struct object_buckets buckets;
+    double* out;
+};
+
+static void run_virtual(void* ctx) {
+    struct objects_case* c = ctx;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        c->out[i] = c->objects[i]->vtable->area(c->objects[i]);
+    bench_consume((uint64_t)c->out[c->count / 2]);
+}
+
+static void run_bucketed(void* ctx) {
+    struct objects_case* c = ctx;
+
+    object_buckets_area(&c->buckets, c->out);
+    bench_consume((uint64_t)c->out[c->count / 2]);
+}
+
+static void run_bucket_build(void* ctx) {
+    struct objects_case* c = ctx;
+    struct object_buckets b;
+
+    if (object_buckets_init(&b, c->objects, c->count)) {
+        bench_consume(b.start[1]);
+        object_buckets_free(&b);
+    }
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t count = n != NULL ? (size_t)strtoul(n, NULL, 10) : 10000000;
+    union shape* shapes = malloc(count * sizeof(union shape));
+    struct objects_case c;
+    uint64_t state = 1;
+    size_t i;
+
+    c.count = count;
+    c.objects = malloc(count * sizeof(*c.objects));
+    c.out = malloc(count * sizeof(double));
+    if (shapes == NULL || c.objects == NULL || c.out == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    /* random mix of types */
+    for( i = 0; i < count; i++ ) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        switch (state >> 62) {
+            case 0:
+            case 1:
+                shapes[i].circle.base.vtable = &circle_vtable;
+                shapes[i].circle.r = (double)(i % 10);
+                break;
+            case 2:
+                shapes[i].square.base.vtable = &square_vtable;
+                shapes[i].square.side = (double)(i % 7);
+                break;
+            default:
+                shapes[i].triangle.base.vtable = &triangle_vtable;
+                shapes[i].triangle.base_length = (double)(i % 5);
+                shapes[i].triangle.height = 2.0;
+                break;
+        }
+        shapes[i].base.field_parent = "shape";
+        c.objects[i] = &shapes[i].base;
+    }
+    if (!object_buckets_init(&c.buckets, c.objects, count)) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+
+    bench_init("objects");
+    bench_run("virtual_call_per_object", run_virtual, &c, count, sizeof(union shape));
+    bench_run("bucketed_batch_dispatch", run_bucketed, &c, count, sizeof(union shape));
+    bench_run("bucket_build", run_bucket_build, &c, count, 0);
+
+    object_buckets_free(&c.buckets);
+    free(shapes);
+    free(c.objects);
+    free(c.out);
+    return bench_finish();
+}
@@ -0,0 +1,279 @@
+/*
+ * Writing lines: stdio (fputs, fprintf) against out.h
+ * (copy into buffer, numbers by fmt, gathered segments),
+ * to /dev/null (cost of calls only) and to a pipe drained by
+ * a child process (real writes). ns/op is per line, so lines
+ * per second are 1e9 / ns. Last cases write from
+ * BENCH_THREADS threads (default 4), locked FILE against
+ * struct out per thread.
+ * BENCH_N sets lines per call (default 2^16). First checks that
+ * buffered writes between segments keep their order.
+ */
+
+/* for fdopen, fileno, fork, pipe */
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "out.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul, exit */
+#include <stdio.h>
+/* for: FILE, fdopen, fputs, fprintf, snprintf, tmpfile, fread */
+#include <string.h>
+/* for: strlen, memcmp */
+#include <fcntl.h>
+/* for: open */
+#include <unistd.h>
+/* for: pipe, fork, read, close */
+#include <sys/wait.h>
+/* for: waitpid */
+#include <threads.h>
+/* for: thrd_create, thrd_join */
+
+struct out_case {
+    char** lines;       /* pre-formatted, with '\n' */
+    size_t count;
+    size_t bytes;       /* all lines */
+    int fd;
+    FILE* file;         /* stdio over fd */
+    struct out out;
+    struct out_shared shared;
+};
+
+static void run_fputs(void* ctx) {
+    struct out_case* c = ctx;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        fputs(c->lines[i], c->file);
+    fflush(c->file);
+}
+
+static void run_fprintf(void* ctx) {
+    struct out_case* c = ctx;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        fprintf(c->file, "record %zu value %d\n", i, (int)(i * 7919 % 100000));
+    fflush(c->file);
+}
+
+static void run_out_write(void* ctx) {
+    struct out_case* c = ctx;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        out_str(&c->out, c->lines[i]);
+    out_flush(&c->out);
+}
+
+static void run_out_print(void* ctx) {
+    struct out_case* c = ctx;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ ) {
+        out_write(&c->out, "record ", 7);
+        out_print(&c->out, i);
+        out_write(&c->out, " value ", 7);
+        out_print(&c->out, (int)(i * 7919 % 100000));
+        out_write(&c->out, "\n", 1);
+    }
+    out_flush(&c->out);
+}
+
+/* lines are not copied, writev gathers OUT_SEGMENTS of them */
+static void run_out_segment(void* ctx) {
+    struct out_case* c = ctx;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        out_segment(&c->out, c->lines[i], strlen(c->lines[i]));
+    out_flush(&c->out);
+}
+
+struct writer {
+    struct out_case* c;
+    size_t first, count;
+};
+
+static int write_file(void* arg) {
+    struct writer* w = arg;
+    size_t i;
+
+    for( i = w->first; i < w->first + w->count; i++ )
+        fputs(w->c->lines[i], w->c->file);
+    return 0;
+}
+
+static int write_out(void* arg) {
+    struct writer* w = arg;
+    struct out out;
+    size_t i;
+
+    if (!out_init_shared(&out, &w->c->shared, 0))
+        return 1;
+    for( i = w->first; i < w->first + w->count; i++ )
+        out_str(&out, w->c->lines[i]);
+    return out_free(&out);
+}
+
+/* lines per second of threads writers sharing one output */
+static double run_threads(struct out_case* c, thrd_start_t fn, size_t threads) {
+    thrd_t ids[64];
+    struct writer w[64];
+    size_t i, started, repeats = 16;
+    uint64_t start;
+
+    bench_unpin();
+    start = bench_now_ns();
+    while (repeats-- > 0) {
+        for( started = 0; started < threads; started++ ) {
+            w[started].c = c;
+            w[started].first = c->count / threads * started;
+            w[started].count = c->count / threads;
+            if (thrd_create(&ids[started], fn, &w[started]) != thrd_success)
+                break;
+        }
+        for( i = 0; i < started; i++ )
+            thrd_join(ids[i], NULL);
+        fflush(c->file);
+    }
+    bench_pin();
+    return 16.0 * (double)(c->count / threads * threads)
+           / ((double)(bench_now_ns() - start) / 1e9);
+}
+
+/* buffered text and segments taking turns, past OUT_SEGMENTS */
+static bool check_interleaved(void) {
+    FILE* file = tmpfile();
+    char expected[4096], got[sizeof expected];
+    size_t size = 0, i;
+    struct out out;
+    bool ok;
+
+    if (file == NULL)
+        return false;
+    if (!out_init(&out, fileno(file), 0)) {
+        fclose(file);
+        return false;
+    }
+    for( i = 0; i < 3 * OUT_SEGMENTS; i++ ) {
+        out_str(&out, "value ");
+        out_print(&out, i);
+        out_segment(&out, " ok\n", 4);
+        size += (size_t)snprintf(expected + size, sizeof expected - size, "value %zu ok\n", i);
+    }
+    ok = out_free(&out) == 0;
+    rewind(file);
+    ok = ok && fread(got, 1, sizeof got, file) == size && memcmp(got, expected, size) == 0;
+    fclose(file);
+    return ok;
+}
+
+/* child reading pipe until it is closed, returns write end */
+static int drained_pipe(pid_t* child) {
+    static char sink[1 << 16];
+    int ends[2];
+
+    if (pipe(ends) != 0)
+        return -1;
+    /* reader is not pinned to the writer's CPU */
+    bench_unpin();
+    *child = fork();
+    bench_pin();
+    if (*child < 0)
+        return -1;
+    if (*child == 0) {
+        close(ends[1]);
+        while (read(ends[0], sink, sizeof sink) > 0)
+            ;
+        exit(0);
+    }
+    close(ends[0]);
+    return ends[1];
+}
+
+static void run_target(struct out_case* c, char const* target, size_t threads) {
+    char name[64];
+    size_t per_line = c->bytes / c->count;
+
+    c->file = fdopen(c->fd, "w");
+    if (c->file == NULL || !out_init(&c->out, c->fd, 0)
+            || !out_shared_init(&c->shared, c->fd)) {
+        fprintf(stderr, "Can not open %s\n", target);
+        exit(1);
+    }
+    snprintf(name, sizeof name, "%s/stdio_fputs", target);
+    bench_run(name, run_fputs, c, c->count, per_line);
+    snprintf(name, sizeof name, "%s/stdio_fprintf", target);
+    bench_run(name, run_fprintf, c, c->count, per_line);
+    snprintf(name, sizeof name, "%s/out_write", target);
+    bench_run(name, run_out_write, c, c->count, per_line);
+    snprintf(name, sizeof name, "%s/out_print", target);
+    bench_run(name, run_out_print, c, c->count, per_line);
+    snprintf(name, sizeof name, "%s/out_segment", target);
+    bench_run(name, run_out_segment, c, c->count, per_line);
+
+    snprintf(name, sizeof name, "%s/stdio_fputs/%zu threads", target, threads);
+    bench_metric(name, "lines/s", run_threads(c, write_file, threads));
+    snprintf(name, sizeof name, "%s/out_shared/%zu threads", target, threads);
+    bench_metric(name, "lines/s", run_threads(c, write_out, threads));
+
+    out_free(&c->out);
+    out_shared_free(&c->shared);
+    fclose(c->file);
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    char const* t = getenv("BENCH_THREADS");
+    size_t count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)1 << 16;
+    size_t threads = t != NULL ? (size_t)strtoul(t, NULL, 10) : 4;
+    struct out_case c;
+    char line[64];
+    pid_t child;
+    size_t i;
+
+    if (threads == 0 || threads > 64)
+        threads = 4;
+    c.count = count;
+    c.bytes = 0;
+    c.lines = malloc(count * sizeof(char*));
+    if (c.lines == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    for( i = 0; i < count; i++ ) {
+        int size = snprintf(line, sizeof line, "record %zu value %d\n",
+                            i, (int)(i * 7919 % 100000));
+
+        c.lines[i] = malloc((size_t)size + 1);
+        if (c.lines[i] == NULL) {
+            fprintf(stderr, "Not enough memory\n");
+            return 1;
+        }
+        memcpy(c.lines[i], line, (size_t)size + 1);
+        c.bytes += (size_t)size;
+    }
+    if (!check_interleaved()) {
+        fprintf(stderr, "out.h writes differ from text\n");
+        return 1;
+    }
+
+    bench_init("out");
+    c.fd = open("/dev/null", O_WRONLY);
+    run_target(&c, "devnull", threads);
+    c.fd = drained_pipe(&child);
+    if (c.fd < 0) {
+        fprintf(stderr, "Can not start pipe reader\n");
+        return 1;
+    }
+    run_target(&c, "pipe", threads);
+    /* fclose closed pipe, child sees end of file */
+    waitpid(child, NULL, 0);
+
+    for( i = 0; i < count; i++ )
+        free(c.lines[i]);
+    free(c.lines);
+    return bench_finish();
+}
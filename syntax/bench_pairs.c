@@ -0,0 +1,119 @@
+/* 
+ * Scanning pairs with a predicate: pair_int_any through
+ * function pointer, one pair at a time (pair.h, array of
+ * structs), against batch operations over struct pairs(int)
+ * with predicate expanded in place (pairs.h, struct of
+ * arrays).
+ * BENCH_N sets number of pairs (default 2^20).
+ */
+
+#include "bench.h"
+#include "pair.h"
+#include "pairs.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul */
+#include <stdio.h>
+/* for: fprintf */
+
+DEFINE_PAIR(int)
+DEFINE_PAIRS(int)
+bool is_positive( int x ) { return x > 0; }
+
+#define positive(x) ((x) > 0)
+DEFINE_PAIRS_PREDICATE(int, positive)
+
+/* predicate through volatile, as a caller from other module */
+static bool (* volatile predicate)(int) = is_positive;
+
+struct pairs_case {
+    struct pair(int)* aos;
+    struct pairs(int) soa;
+};
+
+static void run_pointer(void* ctx) {
+    struct pairs_case* c = ctx;
+    bool (*p)(int) = predicate;
+    size_t i, count = 0;
+
+    for( i = 0; i < c->soa.size; i++ )
+        count += any(int)(c->aos[i], p);
+    bench_consume(count);
+}
+
+static void run_count_any(void* ctx) {
+    struct pairs_case* c = ctx;
+
+    bench_consume(pairs_int_positive_count_any(&c->soa));
+}
+
+static void run_count_all(void* ctx) {
+    struct pairs_case* c = ctx;
+
+    bench_consume(pairs_int_positive_count_all(&c->soa));
+}
+
+static void run_any_mask(void* ctx) {
+    struct pairs_case* c = ctx;
+    uint64_t bits = 0;
+    size_t at;
+
+    for( at = 0; at < c->soa.size; at += PAIRS_BATCH )
+        bits += (uint64_t)__builtin_popcountll(pairs_int_positive_any(&c->soa, at));
+    bench_consume(bits);
+}
+
+/* masks agree with pair_int_any, batches past the end are empty */
+static bool check(struct pairs_case const* c) {
+    size_t at, i;
+
+    for( at = 0; at < c->soa.size; at += PAIRS_BATCH ) {
+        uint64_t mask = pairs_int_positive_any(&c->soa, at);
+
+        for( i = 0; i < PAIRS_BATCH && at + i < c->soa.size; i++ )
+            if ((mask >> i & 1) != any(int)(c->aos[at + i], is_positive))
+                return false;
+    }
+    return pairs_int_positive_any(&c->soa, c->soa.size) == 0
+        && pairs_int_positive_all(&c->soa, c->soa.size + PAIRS_BATCH) == 0;
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)1 << 20;
+    struct pairs_case c;
+    size_t i;
+
+    c.aos = malloc(count * sizeof(struct pair(int)));
+    c.soa.fst = malloc(count * sizeof(int));
+    c.soa.snd = malloc(count * sizeof(int));
+    c.soa.size = 0;
+    if (c.aos == NULL || c.soa.fst == NULL || c.soa.snd == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    /* random signs, so branches on predicate mispredict */
+    for( i = 0; i < count; i++ ) {
+        c.aos[i].fst = (int)(i * 2654435761u % 2001) - 1000;
+        c.aos[i].snd = (int)(i * 40503u % 2003) - 1000;
+    }
+    pairs_int_scatter(&c.soa, c.aos, count);
+    if (!check(&c)) {
+        fprintf(stderr, "pairs masks differ from pair_int_any\n");
+        return 1;
+    }
+
+    bench_init("pairs");
+    bench_run("pair_int_any/pointer/aos", run_pointer, &c, count, 
+              sizeof(struct pair(int)));
+    bench_run("pairs_int_count_any/inline/soa", run_count_any, &c, count, 
+              2 * sizeof(int));
+    bench_run("pairs_int_count_all/inline/soa", run_count_all, &c, count, 
+              2 * sizeof(int));
+    bench_run("pairs_int_any/mask64/soa", run_any_mask, &c, count, 
+              2 * sizeof(int));
+
+    free(c.aos);
+    free(c.soa.fst);
+    free(c.soa.snd);
+    return bench_finish();
+}
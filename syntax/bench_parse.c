@@ -0,0 +1,242 @@
+/*
+ * Sum of ints written as text, BENCH_N bytes (default 256 MiB)
+ * of numbers of 1 to 10 digits, some negative, one per line
+ * or space separated, time per byte of text (and GB/s):
+ *   parse/text/<kernel>  parse.h over text in memory
+ *   parse/fd/<kernel>    parse.h over file ($TMPDIR, default
+ *                        /tmp, in page cache), reads overlapped;
+ *                        skipped when the file can not be written
+ *   strtol               strtol loop over text in memory
+ *   scanf                fscanf("%d") loop, text as FILE by
+ *                        fmemopen (no disk)
+ * every one with the overflow contract of array_sum. First
+ * checks that all give the same sum.
+ * Input is built in memory, cases are skipped when it does not
+ * fit (lower BENCH_N). Baselines are slow, they run over the
+ * first BASELINE_MAX bytes only (time per byte is the same).
+ */
+
+/* for fmemopen */
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "parse.h"
+#include "array_sum.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoull, strtol, labs */
+#include <stdio.h>
+/* for: fmemopen, fscanf, fopen, fwrite, snprintf, remove */
+#include <string.h>
+/* for: memcpy */
+#include <limits.h>
+/* for: INT_MAX, INT_MIN */
+#include <errno.h>
+/* for: errno, ERANGE */
+#include <fcntl.h>
+/* for: open */
+#include <unistd.h>
+/* for: close */
+
+/* strtol and scanf go at 30-200 MB/s, 31 samples take a while */
+#define BASELINE_MAX ((size_t)32 << 20)
+
+struct parse_case {
+    char* text;
+    size_t size;
+    char path[4096];
+    struct parse_variant const* variant;
+};
+
+static bool add_values(void* ctx, int const* values, size_t count) {
+    return array_sum_acc_best()(values, count, ctx);
+}
+
+static int sum_text(struct parse_case const* c) {
+    struct parse_result r;
+    int sum = 0;
+
+    r = parse_text(c->variant, c->text, c->size, add_values, &sum);
+    return r.status == PARSE_OK ? sum : -1;
+}
+
+static void run_text(void* ctx) {
+    bench_consume((uint64_t)sum_text(ctx));
+}
+
+static int sum_fd(struct parse_case const* c) {
+    struct parse_result r;
+    int fd = open(c->path, O_RDONLY);
+    int sum = 0;
+
+    if (fd < 0)
+        return -1;
+    r = parse_fd(c->variant, fd, add_values, &sum);
+    close(fd);
+    return r.status == PARSE_OK ? sum : -1;
+}
+
+static void run_fd(void* ctx) {
+    bench_consume((uint64_t)sum_fd(ctx));
+}
+
+/* how it is done without parse.h */
+static int sum_strtol(struct parse_case const* c) {
+    char const* p = c->text;
+    char const* end = c->text + c->size;
+    long long sum = 0;
+
+    while (p < end) {
+        char* next;
+        long x;
+
+        errno = 0;
+        x = strtol(p, &next, 10);
+        if (next == p)
+            break;      /* only white space left */
+        if (errno == ERANGE || x > INT_MAX || x < INT_MIN)
+            return -1;
+        sum += x;
+        if (sum > INT_MAX || sum < INT_MIN)
+            return -1;
+        p = next;
+    }
+    return (int)sum;
+}
+
+static void run_strtol(void* ctx) {
+    bench_consume((uint64_t)sum_strtol(ctx));
+}
+
+static int sum_scanf(struct parse_case const* c) {
+    FILE* in = fmemopen(c->text, c->size, "r");
+    long long sum = 0;
+    int x;
+
+    if (in == NULL)
+        return -1;
+    while (fscanf(in, "%d", &x) == 1) {
+        sum += x;
+        if (sum > INT_MAX || sum < INT_MIN) {
+            sum = -1;
+            break;
+        }
+    }
+    fclose(in);
+    return (int)sum;
+}
+
+static void run_scanf(void* ctx) {
+    bench_consume((uint64_t)sum_scanf(ctx));
+}
+
+static uint64_t next_random(uint64_t* x) {
+    *x ^= *x << 13;
+    *x ^= *x >> 7;
+    *x ^= *x << 17;
+    return *x;
+}
+
+/* first tokens of c up to about size bytes */
+static struct parse_case head(struct parse_case const* c, size_t size) {
+    struct parse_case h = *c;
+
+    if (size >= c->size)
+        return h;
+    /* ends at a token end, so strtol does not skip white space past it */
+    while (size > 0 && (c->text[size] != ' ' && c->text[size] != '\n'))
+        size--;
+    h.size = size;
+    return h;
+}
+
+/* numbers of every length, far from zero sum turns back */
+static size_t fill(char* text, size_t size) {
+    static long const limits[] = {
+        10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, INT_MAX
+    };
+    uint64_t r = 88172645463325252u;
+    size_t used = 0;
+    long sum = 0;
+
+    while (size - used > 16) {
+        uint64_t bits = next_random(&r);
+        long x = (long)((bits >> 32) % (uint64_t)limits[bits % 10]);
+
+        if (bits & 0x10)
+            x = -x;
+        if (labs(sum + x) > 1L << 30)
+            x = sum > 0 ? -labs(x) : labs(x);
+        sum += x;
+        used += (size_t)snprintf(text + used, 16, "%ld", x);
+        text[used++] = bits & 0x20 ? ' ' : '\n';
+    }
+    return used;
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    char const* dir = getenv("TMPDIR");
+    struct parse_variant const* v;
+    struct parse_case c, baseline;
+    FILE* file;
+    bool on_disk;
+    int expected;
+    char name[64];
+
+    c.size = n != NULL ? (size_t)strtoull(n, NULL, 10) : (size_t)256 << 20;
+    snprintf(c.path, sizeof c.path, "%s/bench_parse.txt", dir != NULL ? dir : "/tmp");
+    /* NUL after text for strtol */
+    c.text = malloc(c.size + 1);
+    if (c.text == NULL) {
+        fprintf(stderr, "Not enough memory (lower BENCH_N)\n");
+        bench_init("parse");
+        return bench_finish();
+    }
+    c.size = fill(c.text, c.size);
+    c.text[c.size] = '\0';
+    file = fopen(c.path, "wb");
+    on_disk = file != NULL && fwrite(c.text, 1, c.size, file) == c.size;
+    if (file != NULL && fclose(file) != 0)
+        on_disk = false;
+    if (!on_disk) {
+        /* e.g. full $TMPDIR, text cases still run */
+        fprintf(stderr, "Can not write %s, parse/fd cases skipped\n", c.path);
+        remove(c.path);
+    }
+
+    c.variant = parse_best();
+    baseline = head(&c, BASELINE_MAX);
+    expected = sum_strtol(&c);
+    if (expected == -1 || sum_scanf(&baseline) != sum_strtol(&baseline)) {
+        fprintf(stderr, "strtol and scanf differ\n");
+        return 1;
+    }
+    for( v = parse_variants(); v->name != NULL; v++ ) {
+        c.variant = v;
+        if (parse_supported(v)
+                && (sum_text(&c) != expected || (on_disk && sum_fd(&c) != expected))) {
+            fprintf(stderr, "parse %s gives other sum\n", v->name);
+            return 1;
+        }
+    }
+
+    bench_init("parse");
+    for( v = parse_variants(); v->name != NULL; v++ ) {
+        if (!parse_supported(v))
+            continue;
+        c.variant = v;
+        snprintf(name, sizeof name, "parse/text/%s", v->name);
+        bench_run(name, run_text, &c, c.size, 1);
+        if (!on_disk)
+            continue;
+        snprintf(name, sizeof name, "parse/fd/%s", v->name);
+        bench_run(name, run_fd, &c, c.size, 1);
+    }
+    bench_run("strtol", run_strtol, &baseline, baseline.size, 1);
+    bench_run("scanf", run_scanf, &baseline, baseline.size, 1);
+
+    if (on_disk)
+        remove(c.path);
+    free(c.text);
+    return bench_finish();
+}
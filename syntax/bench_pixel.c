@@ -0,0 +1,168 @@
+/*
+ * RGB24 (union pixel) conversions of pixel.h, per variant and
+ * format, in megapixels per second:
+ *   row          one 1920 pixel row (stays in cache)
+ *   frame        whole 3840x2160 frame (memory bound)
+ *   frame/rows   frame split by rows between tasks.h workers
+ *                (one per online CPU), best variant
+ * plus the per-pixel struct field loop of data_unions style
+ * code as baseline. Every variant is first checked to give
+ * the bytes of the scalar one, on odd widths too.
+ */
+
+#include "bench.h"
+#include "pixel.h"
+#include <stdlib.h>
+/* for: malloc, free */
+#include <stdio.h>
+/* for: snprintf, fprintf */
+#include <string.h>
+/* for: memcmp, memset */
+
+#define WIDTH 3840
+#define HEIGHT 2160
+
+static char const* const format_names[PIXEL_FORMATS] = {"rgba32", "gray8", "planar8"};
+
+struct pixel_case {
+    struct tasks* tasks;
+    struct pixel_variant const* variant;
+    union pixel* src;
+    size_t width, height;
+    struct pixel_image dst;
+};
+
+static void run_convert(void* ctx) {
+    struct pixel_case* c = ctx;
+
+    pixel_convert(c->tasks, c->variant, c->src, c->width * 3, c->width, c->height, &c->dst);
+    bench_consume(c->dst.planes[0][0]);
+}
+
+/* what callers wrote before: one pixel, one field at a time */
+static void run_fields(void* ctx) {
+    struct pixel_case* c = ctx;
+    unsigned char* out = c->dst.planes[0];
+    size_t i, n = c->width * c->height;
+
+    for( i = 0; i < n; i++ ) {
+        union pixel p = c->src[i];
+
+        out[4 * i] = p.named.a;
+        out[4 * i + 1] = p.named.b;
+        out[4 * i + 2] = p.named.c;
+        out[4 * i + 3] = 255;
+    }
+    bench_consume(out[0]);
+}
+
+static void target(struct pixel_image* dst, enum pixel_format format,
+                   unsigned char* planes, size_t width, size_t height) {
+    dst->format = format;
+    dst->stride = format == PIXEL_RGBA32 ? 4 * width : width;
+    dst->planes[0] = planes;
+    dst->planes[1] = format == PIXEL_PLANAR8 ? planes + width * height : NULL;
+    dst->planes[2] = format == PIXEL_PLANAR8 ? planes + 2 * width * height : NULL;
+}
+
+/* every variant against scalar, for widths with every tail length */
+static int check(union pixel* src, unsigned char* expected, unsigned char* got) {
+    struct pixel_variant const* scalar = pixel_variants();
+    struct pixel_image a, b;
+    size_t width;
+    int f;
+
+    while (scalar[1].name != NULL)
+        scalar++;
+    for( width = 1; width <= 100; width++ )
+        for( f = 0; f < PIXEL_FORMATS; f++ ) {
+            struct pixel_variant const* v;
+            size_t bytes = (f == PIXEL_RGBA32 ? 4 : f == PIXEL_PLANAR8 ? 3 : 1) * width * 7;
+
+            target(&a, (enum pixel_format)f, expected, width, 7);
+            target(&b, (enum pixel_format)f, got, width, 7);
+            pixel_convert(NULL, scalar, src, width * 3, width, 7, &a);
+            for( v = pixel_variants(); v->name != NULL; v++ ) {
+                if (!pixel_supported(v))
+                    continue;
+                memset(got, 0, bytes);
+                pixel_convert(NULL, v, src, width * 3, width, 7, &b);
+                if (memcmp(expected, got, bytes) != 0) {
+                    fprintf(stderr, "%s %s differs from scalar at width %zu\n",
+                            v->name, format_names[f], width);
+                    return 0;
+                }
+            }
+        }
+    return 1;
+}
+
+static void report(char const* name, bench_fn* run, struct pixel_case* c) {
+    double ns = bench_run(name, run, c, c->width * c->height, 3);
+
+    bench_rate(name, "MP/s", ns);
+}
+
+int main(void) {
+    size_t pixels = (size_t)WIDTH * HEIGHT, i;
+    union pixel* src = malloc(pixels * sizeof(union pixel));
+    /* filled as bytes, pixels are 3 packed bytes each */
+    unsigned char* bytes = (unsigned char*)src;
+    unsigned char* out = malloc(4 * pixels);
+    unsigned char* expected = malloc(4 * pixels);
+    struct pixel_variant const* v;
+    struct pixel_case c;
+    struct tasks tasks;
+    char name[96];
+    int f;
+
+    if (src == NULL || out == NULL || expected == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    for( i = 0; i < 3 * pixels; i++ )
+        bytes[i] = (unsigned char)(i * 2654435761u >> 13);
+    if (!check(src, expected, out))
+        return 1;
+
+    bench_init("pixel");
+    c.src = src;
+    c.tasks = NULL;
+    for( f = 0; f < PIXEL_FORMATS; f++ )
+        for( v = pixel_variants(); v->name != NULL; v++ ) {
+            if (!pixel_supported(v))
+                continue;
+            c.variant = v;
+            c.width = 1920;
+            c.height = 1;
+            target(&c.dst, (enum pixel_format)f, out, c.width, c.height);
+            snprintf(name, sizeof name, "%s/%s/row", format_names[f], v->name);
+            report(name, run_convert, &c);
+            c.width = WIDTH;
+            c.height = HEIGHT;
+            target(&c.dst, (enum pixel_format)f, out, c.width, c.height);
+            snprintf(name, sizeof name, "%s/%s/frame", format_names[f], v->name);
+            report(name, run_convert, &c);
+        }
+    bench_unpin();
+    if (tasks_init(&tasks, 0) != 0) {
+        fprintf(stderr, "Can not start workers\n");
+        return 1;
+    }
+    c.tasks = &tasks;
+    c.variant = NULL;
+    for( f = 0; f < PIXEL_FORMATS; f++ ) {
+        target(&c.dst, (enum pixel_format)f, out, c.width, c.height);
+        snprintf(name, sizeof name, "%s/best/frame/rows", format_names[f]);
+        report(name, run_convert, &c);
+    }
+    tasks_free(&tasks);
+    bench_pin();
+    target(&c.dst, PIXEL_RGBA32, out, c.width, c.height);
+    report("rgba32/union_fields/frame", run_fields, &c);
+
+    free(src);
+    free(out);
+    free(expected);
+    return bench_finish();
+}
@@ -0,0 +1,192 @@
+/*
+ * Reading BENCH_N (default 10M) 32-byte records of a file,
+ * from open to close, per record:
+ *   mmap/fields         record.h accessors over the mapping
+ *   mmap/fields_swapped same, file of other byte order
+ *   mmap/get            whole records by value (record_get)
+ *   fread/unpack        fread into buffer and unpack field by
+ *                       field into heap structs, then read them
+ * Files go to $TMPDIR (default /tmp) and are removed after.
+ */
+
+#include "bench.h"
+#include "record.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul */
+#include <stdio.h>
+/* for: fopen, fread, snprintf, remove */
+#include <string.h>
+/* for: memcpy */
+
+#define TRADE_FIELDS(F, S) \
+    F(S, uint64_t, time) F(S, uint32_t, id) F(S, int32_t, qty) \
+    F(S, double, price) F(S, uint16_t, venue) F(S, uint8_t, side) \
+    F(S, uint8_t, flags)
+DEFINE_RECORD(trade, 1, TRADE_FIELDS)
+
+struct record_case {
+    char native[4096];
+    char swapped[4096];
+    size_t count;
+};
+
+/* what every mode computes from a record */
+#define DIGEST(sum, qty, price, time) \
+    ((sum) += (uint64_t)(qty) + (uint64_t)(price) + ((time) & 0xff))
+
+static uint64_t sum_fields(char const* path) {
+    struct record_file file;
+    uint64_t sum = 0;
+    size_t i;
+
+    if (record_open(&file, path, &trade_schema) != 0) {
+        fprintf(stderr, "%s\n", file.error);
+        exit(1);
+    }
+    for( i = 0; i < file.count; i++ )
+        DIGEST(sum, trade_qty(&file, i), trade_price(&file, i), trade_time(&file, i));
+    record_close(&file);
+    return sum;
+}
+
+static void run_fields(void* ctx) {
+    struct record_case* c = ctx;
+
+    bench_consume(sum_fields(c->native));
+}
+
+static void run_fields_swapped(void* ctx) {
+    struct record_case* c = ctx;
+
+    bench_consume(sum_fields(c->swapped));
+}
+
+static uint64_t sum_get(char const* path) {
+    struct record_file file;
+    uint64_t sum = 0;
+    size_t i;
+
+    if (record_open(&file, path, &trade_schema) != 0) {
+        fprintf(stderr, "%s\n", file.error);
+        exit(1);
+    }
+    for( i = 0; i < file.count; i++ ) {
+        struct trade t = trade_get(&file, i);
+
+        DIGEST(sum, t.qty, t.price, t.time);
+    }
+    record_close(&file);
+    return sum;
+}
+
+static void run_get(void* ctx) {
+    struct record_case* c = ctx;
+
+    bench_consume(sum_get(c->native));
+}
+
+#define UNPACK(S, T, N) \
+    memcpy(&record->N, bytes + trade_fields[field++].offset, sizeof(T));
+
+/* ingest as it was: buffered reads, heap structs, then use */
+static uint64_t sum_unpacked(char const* path, size_t count) {
+    static unsigned char buffer[1 << 16];
+    struct trade* trades = malloc(count * sizeof(struct trade));
+    FILE* in = fopen(path, "rb");
+    size_t header = (size_t)record_data_offset(&trade_schema);
+    size_t offset = 0, got = 0, i;
+    uint64_t sum = 0;
+
+    /* header is skipped, not checked */
+    if (trades == NULL || in == NULL || fread(buffer, 1, header, in) != header) {
+        fprintf(stderr, "Can not read %s\n", path);
+        exit(1);
+    }
+    for( i = 0; i < count; i++ ) {
+        struct trade* record = &trades[i];
+        unsigned char const* bytes;
+        size_t field = 0;
+
+        if (offset == got) {
+            got = fread(buffer, sizeof(struct trade),
+                        sizeof buffer / sizeof(struct trade), in) * sizeof(struct trade);
+            offset = 0;
+            if (got == 0)
+                break;
+        }
+        bytes = buffer + offset;
+        TRADE_FIELDS(UNPACK, trade)
+        offset += sizeof(struct trade);
+    }
+    fclose(in);
+    for( i = 0; i < count; i++ )
+        DIGEST(sum, trades[i].qty, trades[i].price, trades[i].time);
+    free(trades);
+    return sum;
+}
+
+static void run_unpack(void* ctx) {
+    struct record_case* c = ctx;
+
+    bench_consume(sum_unpacked(c->native, c->count));
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    char const* dir = getenv("TMPDIR");
+    struct record_case c;
+    struct trade* trades;
+    uint64_t expected = 0;
+    size_t i;
+    static struct {
+        char const* name;
+        bench_fn* run;
+    } const modes[] = {
+        {"record/mmap/fields", run_fields},
+        {"record/mmap/fields_swapped", run_fields_swapped},
+        {"record/mmap/get", run_get},
+        {"record/fread/unpack", run_unpack}
+    };
+
+    c.count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)10000000;
+    if (dir == NULL)
+        dir = "/tmp";
+    snprintf(c.native, sizeof c.native, "%s/bench_record.bin", dir);
+    snprintf(c.swapped, sizeof c.swapped, "%s/bench_record_swapped.bin", dir);
+    trades = calloc(c.count, sizeof(struct trade));
+    if (trades == NULL) {
+        fprintf(stderr, "Not enough memory (lower BENCH_N)\n");
+        return 1;
+    }
+    for( i = 0; i < c.count; i++ ) {
+        trades[i].time = 1700000000000u + i;
+        trades[i].id = (uint32_t)i;
+        trades[i].qty = (int32_t)(i * 2654435761u % 1000);
+        trades[i].price = 100.0 + (double)(i % 512) / 4;
+        trades[i].venue = (uint16_t)(i % 16);
+        trades[i].side = (uint8_t)(i & 1);
+        DIGEST(expected, trades[i].qty, trades[i].price, trades[i].time);
+    }
+    if (record_write(c.native, &trade_schema, trades, c.count, false) != 0
+            || record_write(c.swapped, &trade_schema, trades, c.count, true) != 0) {
+        fprintf(stderr, "Can not write %s\n", c.native);
+        return 1;
+    }
+    free(trades);
+    if (sum_fields(c.native) != expected || sum_fields(c.swapped) != expected
+            || sum_get(c.native) != expected || sum_unpacked(c.native, c.count) != expected) {
+        fprintf(stderr, "Readers differ\n");
+        return 1;
+    }
+
+    bench_init("record");
+    for( i = 0; i < sizeof modes / sizeof modes[0]; i++ ) {
+        double ns = bench_run(modes[i].name, modes[i].run, &c, c.count, sizeof(struct trade));
+
+        bench_rate(modes[i].name, "M records/s", ns);
+    }
+
+    remove(c.native);
+    remove(c.swapped);
+    return bench_finish();
+}
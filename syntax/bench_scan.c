@@ -0,0 +1,104 @@
+/* 
+ * Benchmarks of scans and segmented sums (scan.h), against
+ * calling array_sum once per segment.
+ * BENCH_N sets element count (default 2^24).
+ */
+
+#include "bench.h"
+#include "scan.h"
+#include "array_sum.h"
+#include <stdlib.h>
+/* for: malloc, getenv, strtoul */
+#include <stdio.h>
+/* for: fprintf */
+
+struct scan_case {
+    int const* in;
+    int* out;
+    size_t count;
+    size_t const* offsets;
+    size_t segments;
+};
+
+static void run_inclusive(void* ctx) {
+    struct scan_case* c = ctx;
+
+    bench_consume((uint64_t)scan_inclusive(c->in, c->out, c->count));
+}
+
+static void run_exclusive(void* ctx) {
+    struct scan_case* c = ctx;
+
+    bench_consume((uint64_t)scan_exclusive(c->in, c->out, c->count));
+}
+
+static void run_parallel(void* ctx) {
+    struct scan_case* c = ctx;
+
+    bench_consume((uint64_t)scan_inclusive_parallel(c->in, c->out, c->count, 0));
+}
+
+static void run_segments(void* ctx) {
+    struct scan_case* c = ctx;
+
+    scan_segments(c->in, c->offsets, c->segments, c->out);
+    bench_consume((uint64_t)c->out[c->segments / 2]);
+}
+
+static void run_array_sum_loop(void* ctx) {
+    struct scan_case* c = ctx;
+    size_t k;
+
+    for( k = 0; k < c->segments; k++ )
+        c->out[k] = array_sum(
+            c->in + c->offsets[k], c->offsets[k + 1] - c->offsets[k]);
+    bench_consume((uint64_t)c->out[c->segments / 2]);
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)1 << 24;
+    int* in = malloc(count * sizeof(int));
+    int* out = malloc(count * sizeof(int));
+    size_t* offsets = malloc((count + 1) * sizeof(size_t));
+    struct scan_case c;
+    size_t i, k;
+
+    if (in == NULL || out == NULL || offsets == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    for( i = 0; i < count; i++ )
+        in[i] = (int)(i % 2001) - 1000;
+    c.in = in;
+    c.out = out;
+    c.count = count;
+    c.offsets = offsets;
+
+    bench_init("scan");
+    bench_run("scan_inclusive", run_inclusive, &c, count, 2 * sizeof(int));
+    bench_run("scan_exclusive", run_exclusive, &c, count, 2 * sizeof(int));
+    bench_unpin();
+    bench_run("scan_inclusive_parallel", run_parallel, &c, count, 2 * sizeof(int));
+    bench_pin();
+
+    /* tiny segments of 0..7 elements */
+    offsets[0] = 0;
+    for( k = 0; offsets[k] + k % 8 <= count; k++ )
+        offsets[k + 1] = offsets[k] + k % 8;
+    c.segments = k;
+    bench_run("scan_segments/tiny", run_segments, &c, c.segments, 0);
+    bench_run("array_sum_per_segment/tiny", run_array_sum_loop, &c, c.segments, 0);
+
+    /* long segments of 1000 elements */
+    for( k = 0; (k + 1) * 1000 <= count; k++ )
+        offsets[k + 1] = (k + 1) * 1000;
+    c.segments = k;
+    bench_run("scan_segments/1000", run_segments, &c, c.segments, 0);
+    bench_run("array_sum_per_segment/1000", run_array_sum_loop, &c, c.segments, 0);
+
+    free(in);
+    free(out);
+    free(offsets);
+    return bench_finish();
+}
@@ -0,0 +1,106 @@
+/*
+ * Reduction of one field (sum of qty) over records stored as
+ * array of structs (every 16-byte record is loaded for its
+ * 4 bytes) and as struct of arrays from soa.h (only the qty
+ * column is loaded), plus both bulk conversions.
+ * BENCH_N sets number of records (default 100M, 1.6 GB per
+ * layout).
+ */
+
+#include "bench.h"
+#include "soa.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul */
+#include <stdio.h>
+/* for: fprintf */
+#include <stdint.h>
+/* for: int64_t, uint64_t */
+
+#define TICK_FIELDS(F, S) \
+    F(S, float, price) F(S, int, qty) F(S, int, id) \
+    F(S, short, venue) F(S, char, side) F(S, char, flags)
+DEFINE_SOA(tick, TICK_FIELDS)
+
+struct soa_case {
+    struct tick* aos;
+    soa(tick) soa;
+    size_t count;
+};
+
+static void run_sum_aos(void* ctx) {
+    struct soa_case* c = ctx;
+    int64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        sum += c->aos[i].qty;
+    bench_consume((uint64_t)sum);
+}
+
+static void run_sum_soa(void* ctx) {
+    struct soa_case* c = ctx;
+    int const* qty = c->soa.qty;
+    int64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        sum += qty[i];
+    bench_consume((uint64_t)sum);
+}
+
+static void run_from_aos(void* ctx) {
+    struct soa_case* c = ctx;
+
+    c->soa.size = 0;
+    tick_soa_from_aos(&c->soa, c->aos, c->count);
+    bench_consume((uint64_t)c->soa.qty[c->count - 1]);
+}
+
+static void run_to_aos(void* ctx) {
+    struct soa_case* c = ctx;
+
+    tick_soa_to_aos(&c->soa, c->aos);
+    bench_consume((uint64_t)c->aos[c->count - 1].qty);
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)100000000;
+    struct soa_case c;
+    int64_t aos_sum = 0, soa_sum = 0;
+    size_t i;
+
+    c.count = count;
+    c.aos = malloc(count * sizeof(struct tick));
+    if (c.aos == NULL || count == 0 || !tick_soa_init(&c.soa, count)) {
+        fprintf(stderr, "Not enough memory (lower BENCH_N)\n");
+        return 1;
+    }
+    for( i = 0; i < count; i++ ) {
+        c.aos[i].price = (float)(i % 1000) / 8;
+        c.aos[i].qty = (int)(i * 2654435761u % 1000);
+        c.aos[i].id = (int)i;
+        c.aos[i].venue = (short)(i % 16);
+        c.aos[i].side = (char)(i & 1);
+        c.aos[i].flags = 0;
+    }
+    tick_soa_from_aos(&c.soa, c.aos, count);
+    for( i = 0; i < count; i++ ) {
+        aos_sum += c.aos[i].qty;
+        soa_sum += c.soa.qty[i];
+    }
+    if (aos_sum != soa_sum || tick_soa_get(&c.soa, count - 1).id != (int)(count - 1)) {
+        fprintf(stderr, "Layouts differ after conversion\n");
+        return 1;
+    }
+
+    bench_init("soa");
+    bench_run("sum_qty/aos", run_sum_aos, &c, count, sizeof(struct tick));
+    bench_run("sum_qty/soa", run_sum_soa, &c, count, sizeof(int));
+    bench_run("convert/aos_to_soa", run_from_aos, &c, count, 2 * sizeof(struct tick));
+    bench_run("convert/soa_to_aos", run_to_aos, &c, count, 2 * sizeof(struct tick));
+
+    tick_soa_free(&c.soa);
+    free(c.aos);
+    return bench_finish();
+}
@@ -0,0 +1,213 @@
+/*
+ * Building BENCH_N (default 10M) log lines like
+ *   2026-10-17T12:00:00Z INFO worker=17 request=2654435761 latency_ms=12.375 path=/api/items
+ * (line with one path in 8 is longer than STRBUF_SMALL), per line:
+ *   sprintf_strcat  fresh malloc buffer, numbers by sprintf into
+ *                   a temporary, every piece strcat-ed (each
+ *                   strcat scans the line for its end)
+ *   snprintf        one snprintf of whole line into stack buffer
+ *   strbuf          strbuf.h on stack (malloc for long lines)
+ *   strbuf_arena    every line appended to one strbuf over an
+ *                   arena, reset after STRBUF_BATCH lines
+ * First checks that all of them write the same text, and that
+ * strbuf keeps short lines on stack.
+ */
+
+#include "bench.h"
+#include "strbuf.h"
+#include "arena.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul */
+#include <stdio.h>
+/* for: sprintf, snprintf, fprintf */
+#include <string.h>
+/* for: strcat, strlen, strcmp, memcmp */
+#include <stdint.h>
+/* for: uint64_t */
+#include <stdbool.h>
+/* for: bool */
+
+#define LINE_MAX_SIZE 512
+#define STRBUF_BATCH 4096
+#define TIME "2026-10-17T12:00:00Z"
+
+static char const* const paths[8] = {
+    "/api/items", "/api/items/42", "/health", "/api/users/me",
+    "/api/orders?page=3", "/static/app.js", "/api/items/7/reviews",
+    "/api/search?q=string+builder&lang=c&sort=relevance&page=12&per_page=100&session=5f3a9c"
+};
+
+struct log_case {
+    size_t count;
+    struct arena arena;
+};
+
+/* values of line i */
+#define WORKER(i) ((int)((i) % 64))
+#define REQUEST(i) ((unsigned long long)(i) * 2654435761u)
+#define LATENCY(i) ((double)((i) % 10000) / 8)
+#define PATH(i) (paths[(i) % 8])
+
+static size_t line_strcat(char* line, size_t i) {
+    char number[32];
+
+    line[0] = '\0';
+    strcat(line, TIME);
+    strcat(line, " INFO worker=");
+    sprintf(number, "%d", WORKER(i));
+    strcat(line, number);
+    strcat(line, " request=");
+    sprintf(number, "%llu", REQUEST(i));
+    strcat(line, number);
+    strcat(line, " latency_ms=");
+    sprintf(number, "%g", LATENCY(i));
+    strcat(line, number);
+    strcat(line, " path=");
+    strcat(line, PATH(i));
+    strcat(line, "\n");
+    return strlen(line);
+}
+
+static size_t line_snprintf(char* line, size_t i) {
+    return (size_t)snprintf(line, LINE_MAX_SIZE, TIME " INFO worker=%d request=%llu latency_ms=%g path=%s\n",
+                            WORKER(i), REQUEST(i), LATENCY(i), PATH(i));
+}
+
+static bool line_strbuf(struct strbuf* s, size_t i) {
+    return strbuf_append_literal(s, TIME " INFO worker=")
+        && strbuf_print(s, WORKER(i))
+        && strbuf_append_literal(s, " request=")
+        && strbuf_print(s, REQUEST(i))
+        && strbuf_append_literal(s, " latency_ms=")
+        && strbuf_print_g(s, LATENCY(i), 6)
+        && strbuf_append_literal(s, " path=")
+        && strbuf_append_str(s, PATH(i))
+        && strbuf_append_char(s, '\n');
+}
+
+static void run_strcat(void* ctx) {
+    struct log_case* c = ctx;
+    uint64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ ) {
+        char* line = malloc(LINE_MAX_SIZE);
+
+        if (line == NULL)
+            exit(1);
+        sum += line_strcat(line, i) + (unsigned char)line[40];
+        free(line);
+    }
+    bench_consume(sum);
+}
+
+static void run_snprintf(void* ctx) {
+    struct log_case* c = ctx;
+    char line[LINE_MAX_SIZE];
+    uint64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ )
+        sum += line_snprintf(line, i) + (unsigned char)line[40];
+    bench_consume(sum);
+}
+
+static void run_strbuf(void* ctx) {
+    struct log_case* c = ctx;
+    uint64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ ) {
+        struct strbuf s;
+
+        strbuf_init(&s, allocator_malloc);
+        if (!line_strbuf(&s, i))
+            exit(1);
+        sum += strbuf_length(&s) + (unsigned char)strbuf_str(&s)[40];
+        strbuf_free(&s);
+    }
+    bench_consume(sum);
+}
+
+static void run_strbuf_arena(void* ctx) {
+    struct log_case* c = ctx;
+    struct strbuf s;
+    uint64_t sum = 0;
+    size_t i;
+
+    for( i = 0; i < c->count; i++ ) {
+        size_t start;
+
+        if (i % STRBUF_BATCH == 0) {
+            /* batch is handed on, e.g. written out, then memory reused */
+            arena_reset(&c->arena);
+            strbuf_init(&s, arena_allocator(&c->arena));
+        }
+        start = strbuf_length(&s);
+        if (!line_strbuf(&s, i))
+            exit(1);
+        sum += strbuf_length(&s) - start + (unsigned char)strbuf_str(&s)[start + 40];
+    }
+    bench_consume(sum);
+}
+
+/* same text from every builder, only long lines leave small */
+static bool check(struct log_case* c) {
+    char ours[LINE_MAX_SIZE], theirs[LINE_MAX_SIZE];
+    struct strbuf s, all;
+    size_t i, at = 0;
+    bool ok = true;
+
+    strbuf_init(&all, arena_allocator(&c->arena));
+    for( i = 0; ok && i < 1000; i++ ) {
+        size_t length = line_strcat(ours, i);
+
+        strbuf_init(&s, allocator_malloc);
+        ok = line_snprintf(theirs, i) == length && strcmp(ours, theirs) == 0
+             && line_strbuf(&s, i) && strbuf_length(&s) == length
+             && strcmp(strbuf_str(&s), ours) == 0
+             && (s.heap == NULL) == (i % 8 != 7)
+             && line_strbuf(&all, i) && strbuf_length(&all) == at + length
+             && memcmp(strbuf_str(&all) + at, ours, length + 1) == 0;
+        at += length;
+        if (!ok)
+            fprintf(stderr, "Line %u differs:\n%s%s", (unsigned)i, ours, strbuf_str(&s));
+        strbuf_free(&s);
+    }
+    arena_reset(&c->arena);
+    return ok;
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    struct log_case c;
+    size_t i;
+    static struct {
+        char const* name;
+        bench_fn* run;
+    } const modes[] = {
+        {"log/sprintf_strcat", run_strcat},
+        {"log/snprintf", run_snprintf},
+        {"log/strbuf", run_strbuf},
+        {"log/strbuf_arena", run_strbuf_arena}
+    };
+
+    c.count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)10000000;
+    /* batch of lines, doubling capacity may leave the old block behind */
+    if (!arena_init(&c.arena, (size_t)4 * STRBUF_BATCH * LINE_MAX_SIZE)) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+    if (!check(&c))
+        return 1;
+
+    bench_init("strbuf");
+    for( i = 0; i < sizeof modes / sizeof modes[0]; i++ ) {
+        double ns = bench_run(modes[i].name, modes[i].run, &c, c.count, 0);
+
+        bench_rate(modes[i].name, "M lines/s", ns);
+    }
+
+    arena_free(&c.arena);
+    return bench_finish();
+}
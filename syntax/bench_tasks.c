@@ -0,0 +1,202 @@
+/*
+ * Scheduler of tasks.h:
+ *   spawn/submitted   main thread spawns empty tasks, waits
+ *   spawn/worker      a task spawns empty tasks into its deque
+ *   spawn/fib         fork/join fib(FIB_N), one task per call
+ * (ns per task), then a memory-bound reduction, sum of
+ * BENCH_N int64 (default 2^25, 256 MB) with parallel_for on
+ * 1, 2, 4 ... workers, up to online CPUs, against a plain
+ * loop.
+ *
+ * Schedulers are started and run unpinned (bench_unpin), one
+ * at a time, each freed after its cases; only the plain loop
+ * is pinned. With more threads than CPUs, spawn
+ * times include waiting threads taking turns with workers.
+ */
+
+/* for sysconf */
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include "tasks.h"
+#include <stdlib.h>
+/* for: malloc, free, getenv, strtoul */
+#include <stdio.h>
+/* for: snprintf, fprintf */
+#include <unistd.h>
+/* for: sysconf */
+
+#define SPAWN_N 1000
+#define FIB_N 22
+#define MAX_SCHEDULERS 16
+
+struct spawn_case {
+    struct tasks* tasks;
+};
+
+static void nothing(void* arg) {
+    bench_consume((uint64_t)(uintptr_t)arg);
+}
+
+static void spawn_all(struct tasks* tasks) {
+    struct task_group group;
+    size_t i;
+
+    task_group_init(&group, tasks);
+    for( i = 0; i < SPAWN_N; i++ )
+        task_spawn(&group, nothing, NULL);
+    task_group_wait(&group);
+}
+
+static void run_submitted(void* ctx) {
+    struct spawn_case* c = ctx;
+
+    spawn_all(c->tasks);
+}
+
+static void spawn_from_task(void* arg) {
+    spawn_all(arg);
+}
+
+static void run_worker(void* ctx) {
+    struct spawn_case* c = ctx;
+    struct task_group group;
+
+    task_group_init(&group, c->tasks);
+    task_spawn(&group, spawn_from_task, c->tasks);
+    task_group_wait(&group);
+}
+
+struct fib {
+    struct tasks* tasks;
+    int n;
+    long result;
+};
+
+static void fib_task(void* arg) {
+    struct fib* f = arg;
+    struct fib left, right;
+    struct task_group group;
+
+    if (f->n < 2) {
+        f->result = f->n;
+        return;
+    }
+    left.tasks = right.tasks = f->tasks;
+    left.n = f->n - 1;
+    right.n = f->n - 2;
+    task_group_init(&group, f->tasks);
+    task_spawn(&group, fib_task, &left);
+    fib_task(&right);
+    task_group_wait(&group);
+    f->result = left.result + right.result;
+}
+
+/* tasks spawned by fib_task(n) */
+static size_t fib_spawns(int n) {
+    return n < 2 ? 0 : 1 + fib_spawns(n - 1) + fib_spawns(n - 2);
+}
+
+static void run_fib(void* ctx) {
+    struct spawn_case* c = ctx;
+    struct fib f;
+
+    f.tasks = c->tasks;
+    f.n = FIB_N;
+    fib_task(&f);
+    bench_consume((uint64_t)f.result);
+}
+
+struct sum_case {
+    struct tasks* tasks;
+    int64_t const* values;
+    size_t count;
+    _Atomic(int64_t) total;
+};
+
+static void sum_range(void* ctx, size_t begin, size_t end) {
+    struct sum_case* c = ctx;
+    int64_t sum = 0;
+    size_t i;
+
+    for( i = begin; i < end; i++ )
+        sum += c->values[i];
+    atomic_fetch_add_explicit(&c->total, sum, memory_order_relaxed);
+}
+
+static void run_sum_loop(void* ctx) {
+    struct sum_case* c = ctx;
+
+    atomic_store(&c->total, 0);
+    sum_range(c, 0, c->count);
+    bench_consume((uint64_t)atomic_load(&c->total));
+}
+
+static void run_sum_parallel(void* ctx) {
+    struct sum_case* c = ctx;
+
+    atomic_store(&c->total, 0);
+    parallel_for(c->tasks, 0, c->count, 0, sum_range, c);
+    bench_consume((uint64_t)atomic_load(&c->total));
+}
+
+int main(void) {
+    char const* n = getenv("BENCH_N");
+    size_t count = n != NULL ? (size_t)strtoul(n, NULL, 10) : (size_t)1 << 25;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    struct spawn_case spawn;
+    struct sum_case sum;
+    int64_t* values = malloc(count * sizeof(int64_t));
+    int64_t expected = 0;
+    size_t i;
+    char name[64];
+
+    if (values == NULL || count == 0) {
+        fprintf(stderr, "Not enough memory (lower BENCH_N)\n");
+        return 1;
+    }
+    for( i = 0; i < count; i++ ) {
+        values[i] = (int64_t)(i % 1000) - 500;
+        expected += values[i];
+    }
+    sum.values = values;
+    sum.count = count;
+    bench_init("tasks");
+    bench_run("sum_int64/loop", run_sum_loop, &sum, count, sizeof(int64_t));
+
+    bench_unpin();
+    /* 1, 2, 4 ... workers, at least up to 4 to see overhead */
+    for( i = 0; i < MAX_SCHEDULERS; i++ ) {
+        unsigned workers = 1u << i;
+        struct tasks tasks;
+
+        if (workers > 4 && workers > (unsigned)online)
+            break;
+        /* one scheduler at a time, so no idle workers of others around */
+        if (tasks_init(&tasks, workers) != 0) {
+            fprintf(stderr, "Can not start %u workers\n", workers);
+            return 1;
+        }
+        sum.tasks = &tasks;
+        run_sum_parallel(&sum);
+        if (atomic_load(&sum.total) != expected) {
+            fprintf(stderr, "parallel_for sum differs with %u workers\n", workers);
+            tasks_free(&tasks);
+            return 1;
+        }
+
+        spawn.tasks = &tasks;
+        snprintf(name, sizeof(name), "spawn/submitted/%u", workers);
+        bench_run(name, run_submitted, &spawn, SPAWN_N, 0);
+        snprintf(name, sizeof(name), "spawn/worker/%u", workers);
+        bench_run(name, run_worker, &spawn, SPAWN_N, 0);
+        snprintf(name, sizeof(name), "spawn/fib/%u", workers);
+        bench_run(name, run_fib, &spawn, fib_spawns(FIB_N), 0);
+        snprintf(name, sizeof(name), "sum_int64/parallel_for/%u", workers);
+        bench_run(name, run_sum_parallel, &sum, count, sizeof(int64_t));
+        tasks_free(&tasks);
+    }
+    bench_pin();
+    free(values);
+    return bench_finish();
+}
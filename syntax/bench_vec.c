@@ -0,0 +1,159 @@
+/* 
+ * Push throughput of DEFINE_VEC (vec.h) with malloc and arena
+ * allocators, against hand-rolled void* arrays: one which
+ * allocates and copies on every push, and one which doubles
+ * but copies elements through memcpy of runtime size.
+ */
+
+#include "bench.h"
+#include "vec.h"
+#include "arena.h"
+#include <stdlib.h>
+/* for: malloc, free */
+#include <stdio.h>
+/* for: fprintf, snprintf */
+
+DEFINE_VEC(int)
+
+struct vec_case {
+    size_t count;
+    struct arena arena;
+};
+
+static void run_vec_malloc(void* ctx) {
+    struct vec_case* c = ctx;
+    struct vec(int) v;
+    size_t i;
+
+    vec_int_init(&v, allocator_malloc);
+    for( i = 0; i < c->count; i++ )
+        vec_int_push(&v, (int)i);
+    bench_consume((uint64_t)v.data[c->count / 2]);
+    vec_int_free(&v);
+}
+
+static void run_vec_arena(void* ctx) {
+    struct vec_case* c = ctx;
+    struct vec(int) v;
+    size_t i;
+
+    arena_reset(&c->arena);
+    vec_int_init(&v, arena_allocator(&c->arena));
+    for( i = 0; i < c->count; i++ )
+        vec_int_push(&v, (int)i);
+    bench_consume((uint64_t)v.data[c->count / 2]);
+}
+
+static void run_vec_reserved(void* ctx) {
+    struct vec_case* c = ctx;
+    struct vec(int) v;
+    size_t i;
+
+    vec_int_init(&v, allocator_malloc);
+    vec_int_reserve(&v, c->count);
+    for( i = 0; i < c->count; i++ )
+        vec_int_push(&v, (int)i);
+    bench_consume((uint64_t)v.data[c->count / 2]);
+    vec_int_free(&v);
+}
+
+/* hand-rolled generic array */
+struct any_vec {
+    char* data;
+    size_t size;
+    size_t capacity;
+    size_t elem_size;
+};
+
+/* allocates and copies everything on every push */
+static void any_vec_push_copy(struct any_vec* v, void const* x) {
+    char* data = malloc((v->size + 1) * v->elem_size);
+
+    if (data == NULL)
+        return;
+    if (v->size != 0)
+        memcpy(data, v->data, v->size * v->elem_size);
+    memcpy(data + v->size * v->elem_size, x, v->elem_size);
+    free(v->data);
+    v->data = data;
+    v->size++;
+}
+
+/* doubles, but element copy has runtime size */
+static void any_vec_push_double(struct any_vec* v, void const* x) {
+    if (v->size == v->capacity) {
+        size_t capacity = v->capacity != 0 ? v->capacity * 2 : 16;
+        char* data = realloc(v->data, capacity * v->elem_size);
+
+        if (data == NULL)
+            return;
+        v->data = data;
+        v->capacity = capacity;
+    }
+    memcpy(v->data + v->size * v->elem_size, x, v->elem_size);
+    v->size++;
+}
+
+/* elem_size through volatile, as when it comes from caller */
+static size_t volatile int_size = sizeof(int);
+
+static void run_any_copy(void* ctx) {
+    struct vec_case* c = ctx;
+    struct any_vec v = {NULL, 0, 0, 0};
+    size_t i;
+
+    v.elem_size = int_size;
+    for( i = 0; i < c->count; i++ ) {
+        int x = (int)i;
+        any_vec_push_copy(&v, &x);
+    }
+    bench_consume((uint64_t)v.data[c->count / 2]);
+    free(v.data);
+}
+
+static void run_any_double(void* ctx) {
+    struct vec_case* c = ctx;
+    struct any_vec v = {NULL, 0, 0, 0};
+    size_t i;
+
+    v.elem_size = int_size;
+    for( i = 0; i < c->count; i++ ) {
+        int x = (int)i;
+        any_vec_push_double(&v, &x);
+    }
+    bench_consume((uint64_t)v.data[c->count / 2]);
+    free(v.data);
+}
+
+int main(void) {
+    struct vec_case c;
+    size_t const counts[] = {4096, 1 << 20};
+    size_t k;
+    char name[64];
+
+    /* room for all doublings of the biggest vector */
+    if (!arena_init(&c.arena, 4 * sizeof(int) << 20)) {
+        fprintf(stderr, "Not enough memory\n");
+        return 1;
+    }
+
+    bench_init("vec");
+    for( k = 0; k < 2; k++ ) {
+        c.count = counts[k];
+        snprintf(name, sizeof(name), "vec_int_push/malloc/%zu", c.count);
+        bench_run(name, run_vec_malloc, &c, c.count, sizeof(int));
+        snprintf(name, sizeof(name), "vec_int_push/arena/%zu", c.count);
+        bench_run(name, run_vec_arena, &c, c.count, sizeof(int));
+        snprintf(name, sizeof(name), "vec_int_push/reserved/%zu", c.count);
+        bench_run(name, run_vec_reserved, &c, c.count, sizeof(int));
+        snprintf(name, sizeof(name), "void*_push/doubling/%zu", c.count);
+        bench_run(name, run_any_double, &c, c.count, sizeof(int));
+    }
+    /* quadratic, small size only */
+    c.count = counts[0];
+    snprintf(name, sizeof(name), "void*_push/copy_each/%zu", c.count);
+    bench_run(name, run_any_copy, &c, c.count, sizeof(int));
+
+    arena_free(&c.arena);
+    return bench_finish();
+}
@@ -7,7 +7,7 @@ To disable nonstandard extensions:
 warnings -> errors
     -Werror
 To compile this:
-    $ gcc -o main -ansi -pedantic-errors -Werror c_synt.c
+    $ gcc -o main -std=c11 -pedantic-errors -Werror c_synt.c out.c fmt.c -pthread
  */
 
 /* 
@@ -49,6 +49,10 @@ To compile this:
 /* for crossplatfor types: uint8_t, int_64_t, etc... */
 #include <inttypes.h>
 /* for printf scanf with crossplatform types */
+#include "out.h"
+/* for: struct out, out_line, out_segment, out_flush (defined in out.c) */
+#include "fmt.h"
+/* for: fmt_int, fmt_hex, fmt_g, FMT_BUFFER_SIZE (defined in fmt.c) */
 
 /* 
  * Preprocessor output can be seen using:
@@ -291,6 +295,7 @@ void printf_patterns(void) {
     char ch = 'a';
     short sh = 2;
     long longie = 10;
+    char number[FMT_BUFFER_SIZE];
 
 #ifdef C99
     int64_t i64 = -10;
@@ -332,6 +337,17 @@ void printf_patterns(void) {
     printf("Double (6 digs prec, min 8 chars) = |%*.*g|\n", 8, 6, 3.14152111);
     printf("Double (6 digs prec, min 8 chars) = |%8.6g|\n", 3.14152111);
 
+    /* 
+     * Plain %d, %x and %g without format parsing (nor locale),
+     * by formatters of fmt.h; width, flags etc. stay printf's.
+     */
+    fmt_int(number, -1);
+    printf("Signed int (fmt_int)                = |%s|\n", number);
+    fmt_hex(number, 3);
+    printf("Unsigned int hex (fmt_hex)          = |%s|\n", number);
+    fmt_g(number, 3.14152, 6);
+    printf("Double smart (fmt_g)                = |%s|\n", number);
+
     printf("Null term string   = |%s|\n", nts);
 
 }
@@ -509,24 +525,43 @@ int main(int argc, char** argv)
 
     int x = 45;
     int arg_i = 0;
+    struct out out;
 
     which_standard_is_used();
 
+    /* 
+     * Lines below go through one buffer and one writev call
+     * (see out.h) instead of a puts per line. stdout has its
+     * own buffer, it is emptied first to keep lines in order.
+     * 1 is file descriptor of stdout.
+     */
+    fflush(stdout);
+    if (!out_init(&out, 1, 0)) {
+        puts("Not enough memory");
+        return 1;
+    }
 
-    puts("");
-    puts("******************************");
-    puts("Lets print system passed arguments:");
-    puts("******************************");
-    puts("");
+    out_line(&out, "");
+    out_line(&out, "******************************");
+    out_line(&out, "Lets print system passed arguments:");
+    out_line(&out, "******************************");
+    out_line(&out, "");
 
-    printf("System passed %i arguments:\n", argc);
-    /* iterate system passed arguments */
+    out_str(&out, "System passed ");
+    out_print(&out, argc);
+    out_line(&out, " arguments:");
+    /* 
+     * iterate system passed arguments, they live until exit,
+     * so they are written in place (gathered, not copied)
+     */
     arg_i = 0;
     while (arg_i < argc)
     {
-        puts(argv[arg_i]);
+        out_segment(&out, argv[arg_i], strlen(argv[arg_i]));
+        out_segment(&out, "\n", 1);
         arg_i = arg_i + 1;
     }
+    out_free(&out);
     
 
     printf_patterns();
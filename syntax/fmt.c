@@ -0,0 +1,606 @@
+/* 
+ * Number formatting declared in fmt.h.
+ *
+ * Integers: digits are counted first, then written from the
+ * end two at a time (one division by 100 per pair).
+ *
+ * Doubles: Grisu2 (Loitsch, "Printing floating-point numbers
+ * quickly and accurately with integers", 2010) finds short
+ * digits inside the rounding interval of x with 64-bit
+ * integer arithmetic and one cached power of ten. printf
+ * rounding to fewer digits rounds them, unless they are too
+ * close to a tie (or precision is above 15), then digits are
+ * made exactly from x as a ratio of big integers. Output is
+ * same as glibc, ties to even included.
+ */
+
+#include "fmt.h"
+#include <stdint.h>
+/* for: uint64_t, uint32_t */
+#include <stdbool.h>
+/* for: bool */
+#include <string.h>
+/* for: memcpy, memmove, memset */
+#include <float.h>
+/* for: DBL_MIN */
+
+
+static char const digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static int count_digits(unsigned long long x) {
+    int n = 1;
+
+    for( ; x >= 10000; x /= 10000 )
+        n += 4;
+    return n + (x >= 10) + (x >= 100) + (x >= 1000);
+}
+
+/* writes digits of x backwards, ending before end */
+static void put_digits(char* end, unsigned long long x) {
+    while (x >= 100) {
+        unsigned i = (unsigned)(x % 100) * 2;
+
+        x /= 100;
+        *--end = digit_pairs[i + 1];
+        *--end = digit_pairs[i];
+    }
+    if (x >= 10) {
+        *--end = digit_pairs[x * 2 + 1];
+        *--end = digit_pairs[x * 2];
+    } else
+        *--end = (char)('0' + x);
+}
+
+size_t fmt_ullong(char* buffer, unsigned long long x) {
+    int n = count_digits(x);
+
+    put_digits(buffer + n, x);
+    buffer[n] = '\0';
+    return (size_t)n;
+}
+
+size_t fmt_llong(char* buffer, long long x) {
+    if (x < 0) {
+        *buffer = '-';
+        /* negated as unsigned, so LLONG_MIN works too */
+        return 1 + fmt_ullong(buffer + 1, 0ull - (unsigned long long)x);
+    }
+    return fmt_ullong(buffer, (unsigned long long)x);
+}
+
+size_t fmt_int(char* buffer, int x) { return fmt_llong(buffer, x); }
+size_t fmt_long(char* buffer, long x) { return fmt_llong(buffer, x); }
+size_t fmt_uint(char* buffer, unsigned x) { return fmt_ullong(buffer, x); }
+size_t fmt_ulong(char* buffer, unsigned long x) { return fmt_ullong(buffer, x); }
+
+size_t fmt_hex(char* buffer, unsigned long long x) {
+    static char const hex_digits[16] = "0123456789abcdef";
+    int n = (64 - __builtin_clzll(x | 1) + 3) / 4;
+    int i;
+
+    for( i = n - 1; i >= 0; i--, x >>= 4 )
+        buffer[i] = hex_digits[x & 15];
+    buffer[n] = '\0';
+    return (size_t)n;
+}
+
+
+/* *********************************** */
+/* Doubles */
+/* *********************************** */
+
+#define HIDDEN_BIT ((uint64_t)1 << 52)
+#define MIN_EXPONENT (-1074)
+
+static uint64_t double_bits(double x) {
+    uint64_t bits;
+
+    memcpy(&bits, &x, sizeof bits);
+    return bits;
+}
+
+/* x = f * 2^e, x positive and finite */
+static void decompose(double x, uint64_t* f, int* e) {
+    uint64_t bits = double_bits(x);
+    int biased = (int)(bits >> 52 & 0x7ff);
+
+    *f = bits & (HIDDEN_BIT - 1);
+    if (biased != 0) {
+        *f += HIDDEN_BIT;
+        *e = biased - 1075;
+    } else
+        *e = MIN_EXPONENT;
+}
+
+/* 
+ * Writes sign, then nan, inf or 0 spelled as printf does.
+ * Returns true when x was one of them (text is done).
+ */
+static bool put_special(char** p, double x) {
+    uint64_t bits = double_bits(x);
+
+    if (bits >> 63)
+        *(*p)++ = '-';
+    if ((bits >> 52 & 0x7ff) == 0x7ff) {
+        memcpy(*p, bits << 12 ? "nan" : "inf", 4);
+        *p += 3;
+        return true;
+    }
+    if (bits << 1 == 0) {
+        memcpy(*p, "0", 2);
+        *p += 1;
+        return true;
+    }
+    return false;
+}
+
+/* 
+ * Writes digits (first one for 10^exponent) as %g does:
+ * plain for exponents -4..limit-1, otherwise d.ddde+XX.
+ * Trailing zeros are dropped.
+ */
+static char* put_general(char* p, char const* digits, int count, int exponent, int limit) {
+    int i;
+
+    while (count > 1 && digits[count - 1] == '0')
+        count--;
+    if (exponent < -4 || exponent >= limit) {
+        unsigned e = (unsigned)(exponent < 0 ? -exponent : exponent);
+
+        *p++ = digits[0];
+        if (count > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, (size_t)count - 1);
+            p += count - 1;
+        }
+        *p++ = 'e';
+        *p++ = exponent < 0 ? '-' : '+';
+        if (e >= 100) {
+            *p++ = (char)('0' + e / 100);
+            e %= 100;
+        }
+        *p++ = digit_pairs[e * 2];
+        *p++ = digit_pairs[e * 2 + 1];
+    } else if (exponent >= 0) {
+        for( i = 0; i <= exponent; i++ )
+            *p++ = i < count ? digits[i] : '0';
+        if (count > exponent + 1) {
+            *p++ = '.';
+            memcpy(p, digits + exponent + 1, (size_t)(count - exponent - 1));
+            p += count - exponent - 1;
+        }
+    } else {
+        *p++ = '0';
+        *p++ = '.';
+        for( i = -1; i > exponent; i-- )
+            *p++ = '0';
+        memcpy(p, digits, (size_t)count);
+        p += count;
+    }
+    *p = '\0';
+    return p;
+}
+
+
+/* Grisu2 */
+
+/* "do it yourself floating point", value f * 2^e */
+struct diy_fp {
+    uint64_t f;
+    int e;
+};
+
+/* upper 64 bits of 128-bit product, rounded */
+static struct diy_fp diy_multiply(struct diy_fp x, struct diy_fp y) {
+    uint64_t const M32 = 0xffffffffu;
+    uint64_t a = x.f >> 32, b = x.f & M32, c = y.f >> 32, d = y.f & M32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t middle = (bd >> 32) + (ad & M32) + (bc & M32) + ((uint64_t)1 << 31);
+    struct diy_fp product;
+
+    product.f = ac + (ad >> 32) + (bc >> 32) + (middle >> 32);
+    product.e = x.e + y.e + 64;
+    return product;
+}
+
+static struct diy_fp diy_normalize(struct diy_fp x) {
+    int shift = __builtin_clzll(x.f);
+
+    x.f <<= shift;
+    x.e -= shift;
+    return x;
+}
+
+/* 10^(-348 + 8 i) = cached_f[i] * 2^cached_e[i], f normalized and rounded */
+static uint64_t const cached_f[87] = {
+    0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull,
+    0xcf42894a5dce35eaull, 0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull,
+    0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full, 0xbe5691ef416bd60cull,
+    0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+    0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull,
+    0xc21094364dfb5637ull, 0x9096ea6f3848984full, 0xd77485cb25823ac7ull,
+    0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull, 0xb23867fb2a35b28eull,
+    0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+    0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull,
+    0xb5b5ada8aaff80b8ull, 0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull,
+    0x964e858c91ba2655ull, 0xdff9772470297ebdull, 0xa6dfbd9fb8e5b88full,
+    0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+    0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull,
+    0xaa242499697392d3ull, 0xfd87b5f28300ca0eull, 0xbce5086492111aebull,
+    0x8cbccc096f5088ccull, 0xd1b71758e219652cull, 0x9c40000000000000ull,
+    0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+    0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull,
+    0x9f4f2726179a2245ull, 0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull,
+    0x83c7088e1aab65dbull, 0xc45d1df942711d9aull, 0x924d692ca61be758ull,
+    0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+    0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull,
+    0x952ab45cfa97a0b3ull, 0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull,
+    0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull, 0x88fcf317f22241e2ull,
+    0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+    0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull,
+    0x8bab8eefb6409c1aull, 0xd01fef10a657842cull, 0x9b10a4e5e9913129ull,
+    0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull, 0x80444b5e7aa7cf85ull,
+    0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+    0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull
+};
+
+static short const cached_e[87] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static uint64_t const pow10_u64[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+    10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+    100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull,
+    10000000000000000000ull
+};
+
+/* 
+ * Cached power c = 10^-k, so that product with number of
+ * binary exponent e has binary exponent in -60..-32.
+ */
+static struct diy_fp cached_power(int e, int* k) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = (int)dk;
+    int index;
+    struct diy_fp c;
+
+    if (dk - ik > 0.0)
+        ik++;
+    index = (ik >> 3) + 1;
+    *k = -(-348 + index * 8);
+    c.f = cached_f[index];
+    c.e = cached_e[index];
+    return c;
+}
+
+/* moves last digit down while it gets closer to w */
+static void grisu_round(
+    char* digits, int count, uint64_t delta, uint64_t rest,
+    uint64_t ten_kappa, uint64_t distance
+) {
+    while (rest < distance && delta - rest >= ten_kappa
+           && (rest + ten_kappa < distance
+               || distance - rest > rest + ten_kappa - distance)) {
+        digits[count - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+/* 
+ * Generates digits of upper bound high, stops as soon as rest
+ * is below delta (width of rounding interval).
+ */
+static int digit_gen(
+    struct diy_fp w, struct diy_fp high, uint64_t delta,
+    char* digits, int* k
+) {
+    int shift = -high.e;
+    uint64_t one = (uint64_t)1 << shift;
+    uint64_t distance = high.f - w.f;
+    uint32_t p1 = (uint32_t)(high.f >> shift);
+    uint64_t p2 = high.f & (one - 1);
+    int kappa = count_digits(p1);
+    int count = 0;
+
+    while (kappa > 0) {
+        uint32_t d = p1 / (uint32_t)pow10_u64[kappa - 1];
+        uint64_t rest;
+
+        p1 %= (uint32_t)pow10_u64[kappa - 1];
+        if (d != 0 || count != 0)
+            digits[count++] = (char)('0' + d);
+        kappa--;
+        rest = ((uint64_t)p1 << shift) + p2;
+        if (rest <= delta) {
+            *k += kappa;
+            grisu_round(digits, count, delta, rest, pow10_u64[kappa] << shift, distance);
+            return count;
+        }
+    }
+    for( ;; ) {
+        char d;
+
+        p2 *= 10;
+        delta *= 10;
+        d = (char)(p2 >> shift);
+        if (d != 0 || count != 0)
+            digits[count++] = (char)('0' + d);
+        p2 &= one - 1;
+        kappa--;
+        if (p2 < delta) {
+            *k += kappa;
+            grisu_round(digits, count, delta, p2, one,
+                        -kappa < 20 ? distance * pow10_u64[-kappa] : 0);
+            return count;
+        }
+    }
+}
+
+/* 
+ * Short digits of x (positive, finite, not 0), x is about
+ * digits * 10^k. Returns count of digits (at most 17).
+ */
+static int grisu2(double x, char* digits, int* k) {
+    struct diy_fp v, w, high, low, c;
+
+    decompose(x, &v.f, &v.e);
+    /* rounding interval of x is (low, high) */
+    high.f = (v.f << 1) + 1;
+    high.e = v.e - 1;
+    high = diy_normalize(high);
+    if (v.f == HIDDEN_BIT && v.e > MIN_EXPONENT) {
+        /* power of 2, lower neighbour is closer */
+        low.f = (v.f << 2) - 1;
+        low.e = v.e - 2;
+    } else {
+        low.f = (v.f << 1) - 1;
+        low.e = v.e - 1;
+    }
+    low.f <<= low.e - high.e;
+    low.e = high.e;
+
+    c = cached_power(high.e, k);
+    w = diy_multiply(diy_normalize(v), c);
+    high = diy_multiply(high, c);
+    low = diy_multiply(low, c);
+    /* products are off by up to 1 ulp, stay inside */
+    low.f++;
+    high.f--;
+    return digit_gen(w, high, high.f - low.f, digits, k);
+}
+
+
+/* 
+ * Rounds short digits of x (count of them, x about digits
+ * * 10^k) to precision digits. x is less than half ulp away
+ * from them, so it rounds the same unless rest of digits is
+ * that close to half of last kept digit. Returns false then.
+ */
+static bool round_short(char* digits, int count, int precision, int* k) {
+    double rest = 0, window = 1.2e-16 * (double)pow10_u64[precision] + 1e-15;
+    int i;
+
+    for( i = count - 1; i >= precision; i-- )
+        rest = (rest + (digits[i] - '0')) / 10;
+    if (rest > 0.5 - window && rest < 0.5 + window)
+        return false;
+    *k += count - precision;
+    if (rest > 0.5) {
+        for( i = precision - 1; i >= 0 && digits[i] == '9'; i-- )
+            digits[i] = '0';
+        if (i < 0) {
+            digits[0] = '1';
+            ++*k;
+        } else
+            digits[i]++;
+    }
+    return true;
+}
+
+
+/* Exact digits (big integers) */
+
+/* enough for 2^1074 and 2^53 * 10^325 */
+#define BIG_WORDS 40
+
+struct big {
+    uint32_t word[BIG_WORDS];   /* little endian */
+    int size;
+};
+
+static void big_set(struct big* b, uint64_t x) {
+    b->word[0] = (uint32_t)x;
+    b->word[1] = (uint32_t)(x >> 32);
+    b->size = b->word[1] != 0 ? 2 : 1;
+}
+
+static void big_multiply(struct big* b, uint32_t m) {
+    uint64_t carry = 0;
+    int i;
+
+    for( i = 0; i < b->size; i++ ) {
+        carry += (uint64_t)b->word[i] * m;
+        b->word[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    if (carry != 0)
+        b->word[b->size++] = (uint32_t)carry;
+}
+
+static void big_multiply_pow10(struct big* b, int k) {
+    for( ; k >= 9; k -= 9 )
+        big_multiply(b, 1000000000u);
+    if (k > 0)
+        big_multiply(b, (uint32_t)pow10_u64[k]);
+}
+
+static void big_shift(struct big* b, int bits) {
+    int words = bits / 32, i;
+
+    bits %= 32;
+    if (bits != 0) {
+        b->word[b->size] = 0;
+        for( i = b->size; i > 0; i-- )
+            b->word[i] = b->word[i] << bits | b->word[i - 1] >> (32 - bits);
+        b->word[0] <<= bits;
+        if (b->word[b->size] != 0)
+            b->size++;
+    }
+    if (words != 0) {
+        memmove(b->word + words, b->word, (size_t)b->size * sizeof *b->word);
+        memset(b->word, 0, (size_t)words * sizeof *b->word);
+        b->size += words;
+    }
+}
+
+static int big_compare(struct big const* a, struct big const* b) {
+    int i;
+
+    if (a->size != b->size)
+        return a->size < b->size ? -1 : 1;
+    for( i = a->size - 1; i >= 0; i-- )
+        if (a->word[i] != b->word[i])
+            return a->word[i] < b->word[i] ? -1 : 1;
+    return 0;
+}
+
+/* a -= b, a >= b */
+static void big_subtract(struct big* a, struct big const* b) {
+    int64_t borrow = 0;
+    int i;
+
+    for( i = 0; i < a->size; i++ ) {
+        borrow += (int64_t)a->word[i] - (i < b->size ? b->word[i] : 0);
+        a->word[i] = (uint32_t)borrow;
+        borrow = borrow < 0 ? -1 : 0;
+    }
+    while (a->size > 1 && a->word[a->size - 1] == 0)
+        a->size--;
+}
+
+/* 
+ * First count digits of x (positive, finite, not 0) rounded
+ * half to even, as num / den scaled into [1, 10).
+ * Returns decimal exponent of first digit.
+ */
+static int exact_digits(double x, char* digits, int count) {
+    struct big num, den, ten_den;
+    uint64_t f;
+    int e, k, i, side;
+    double estimate;
+
+    decompose(x, &f, &e);
+    big_set(&num, f);
+    big_set(&den, 1);
+    if (e > 0)
+        big_shift(&num, e);
+    else
+        big_shift(&den, -e);
+
+    /* 10^k <= x, maybe one too small */
+    estimate = (e + 63 - __builtin_clzll(f)) * 0.30102999566398114;
+    k = (int)estimate;
+    if (estimate < k)
+        k--;
+    if (k > 0)
+        big_multiply_pow10(&den, k);
+    else
+        big_multiply_pow10(&num, -k);
+    for( ;; ) {
+        ten_den = den;
+        big_multiply(&ten_den, 10);
+        if (big_compare(&num, &ten_den) < 0)
+            break;
+        den = ten_den;
+        k++;
+    }
+
+    for( i = 0; i < count; i++ ) {
+        int d = 0;
+
+        if (i != 0)
+            big_multiply(&num, 10);
+        while (big_compare(&num, &den) >= 0) {
+            big_subtract(&num, &den);
+            d++;
+        }
+        digits[i] = (char)('0' + d);
+    }
+
+    /* rest num / den compared with 1/2 */
+    big_shift(&num, 1);
+    side = big_compare(&num, &den);
+    if (side > 0 || (side == 0 && (digits[count - 1] - '0') % 2 != 0)) {
+        for( i = count - 1; i >= 0 && digits[i] == '9'; i-- )
+            digits[i] = '0';
+        if (i < 0) {
+            digits[0] = '1';
+            k++;
+        } else
+            digits[i]++;
+    }
+    return k;
+}
+
+
+size_t fmt_double(char* buffer, double x) {
+    char digits[20];
+    char* p = buffer;
+    int count, k;
+
+    if (put_special(&p, x))
+        return (size_t)(p - buffer);
+    count = grisu2(x < 0 ? -x : x, digits, &k);
+    return (size_t)(put_general(p, digits, count, count - 1 + k, 16) - buffer);
+}
+
+size_t fmt_g(char* buffer, double x, int precision) {
+    char digits[FMT_MAX_PRECISION + 20];
+    char* p = buffer;
+    int count = 0, k, exponent;
+
+    if (put_special(&p, x))
+        return (size_t)(p - buffer);
+    if (precision < 0)
+        precision = 6;
+    else if (precision == 0)
+        precision = 1;
+    else if (precision > FMT_MAX_PRECISION)
+        precision = FMT_MAX_PRECISION;
+    x = x < 0 ? -x : x;
+
+    /* 
+     * Up to 15 digits, rounding x or its short round trip
+     * digits is the same (half a unit in 15th digit is above
+     * ulp of a normal double) unless they end close to half
+     * a unit. Short ones are much cheaper than exact ones.
+     */
+    if (precision <= 15 && x >= DBL_MIN) {
+        count = grisu2(x, digits, &k);
+        if (count > precision)
+            count = round_short(digits, count, precision, &k) ? precision : 0;
+    }
+    if (count != 0)
+        exponent = count - 1 + k;
+    else {
+        count = precision;
+        exponent = exact_digits(x, digits, count);
+    }
+    return (size_t)(put_general(p, digits, count, exponent, precision) - buffer);
+}
@@ -0,0 +1,60 @@
+/*
+ * Locale-free number formatting into caller buffer.
+ *
+ * Integers are written two digits at a time from a table of
+ * digit pairs, doubles either as shortest text which reads
+ * back to the same double (Grisu2 over cached powers of ten)
+ * or like printf "%.*g". No locale, no format string parsing,
+ * no stdio locking.
+ *
+ * Every function NUL-terminates and returns length, buffer
+ * must hold FMT_BUFFER_SIZE chars. Output is same as printf
+ * with "%d", "%ld", "%lld", "%u", "%lu", "%llu", "%llx",
+ * "%.*g", nan and inf included.
+ */
+#ifndef FMT_H
+#define FMT_H
+
+#include <stddef.h>
+/* for: size_t */
+
+#define FMT_BUFFER_SIZE 64
+/* bigger %g precision is clamped to it */
+#define FMT_MAX_PRECISION 40
+
+size_t fmt_int(char* buffer, int x);
+size_t fmt_long(char* buffer, long x);
+size_t fmt_llong(char* buffer, long long x);
+size_t fmt_uint(char* buffer, unsigned x);
+size_t fmt_ulong(char* buffer, unsigned long x);
+size_t fmt_ullong(char* buffer, unsigned long long x);
+/* lower case, no prefix, like "%llx" */
+size_t fmt_hex(char* buffer, unsigned long long x);
+
+/*
+ * Shortest digits which read back to x, plain notation
+ * for exponents -4..15, otherwise like 1.5e+16 (as repr
+ * in Python). Not always the shortest possible (Grisu2),
+ * but always round trips.
+ */
+size_t fmt_double(char* buffer, double x);
+/* Same as snprintf(buffer, size, "%.*g", precision, x). */
+size_t fmt_g(char* buffer, double x, int precision);
+
+/*
+ * Dispatch like print_formatter in polymorphisms.c, for
+ * every integer type: int64_t is long or long long, so both
+ * are listed.
+ */
+#define fmt(buffer, x) (_Generic( (x), \
+            int: fmt_int, \
+            long: fmt_long, \
+            long long: fmt_llong, \
+            unsigned: fmt_uint, \
+            unsigned long: fmt_ulong, \
+            unsigned long long: fmt_ullong, \
+            float: fmt_double, \
+            double: fmt_double, \
+            default: fmt_hex)((buffer), (x)))
+
+#endif /* FMT_H */
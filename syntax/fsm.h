@@ -0,0 +1,168 @@
+/*
+ * Finite state machines from lists of states, events and
+ * transitions, like enum light of data_unions (c_synt.c) with
+ * its transitions written down once:
+ *
+ *   #define LIGHT_STATES(X, P) \
+ *       X(P, RED) X(P, RED_AND_YELLOW) X(P, GREEN) X(P, YELLOW)
+ *   #define LIGHT_EVENTS(X, P) X(P, TICK) X(P, FAULT)
+ *   #define LIGHT_TRANSITIONS(X, P) \
+ *       X(P, RED, TICK, RED_AND_YELLOW, fsm_none) \
+ *       X(P, GREEN, FAULT, RED, count_fault) ...
+ *   DEFINE_FSM(light, LIGHT, LIGHT_STATES, LIGHT_EVENTS, LIGHT_TRANSITIONS)
+ *
+ * A transition is from, event, to and action, a function
+ * void action(void* ctx) called when it is taken (fsm_none does
+ * nothing). Every (state, event) pair not listed goes to the
+ * first state without action, so make it the reset state.
+ *
+ * gives:
+ *   enum light_state          LIGHT_RED, LIGHT_RED_AND_YELLOW ...
+ *   enum light_event          LIGHT_TICK, LIGHT_FAULT
+ *   light_states, light_events, light_transitions   counts
+ *   light_state_names[s], light_event_names[e]
+ *   light_next[s][e]          dense transition table
+ *   light_run_table           next state and action from tables,
+ *                             action by pointer
+ *   light_run_switch          one switch on state and event,
+ *                             actions inlined in cases
+ *   light_run_goto            computed goto (GCC, clang): code
+ *                             block per state, each with its own
+ *                             indirect jump
+ *
+ * light_run_*(state, events, n, ctx) feeds n events (each less
+ * than light_events, not checked) and returns the last state.
+ *
+ * Backends differ in branches, not in work. Table has no branch
+ * on events but one indirect call per event; switch has one
+ * indirect jump shared by all states, so its predictor sees
+ * every state mixed; goto copies the jump into every state,
+ * each then predicts the events usual in that state (the
+ * threaded interpreter dispatch).
+ */
+#ifndef FSM_H
+#define FSM_H
+
+#include <stddef.h>
+/* for: size_t */
+
+/* action taken on a transition */
+typedef void (fsm_action)(void* ctx);
+
+static inline void fsm_none(void* ctx) {
+    (void)ctx;
+}
+
+#if defined(__GNUC__)
+#define FSM_GOTO 1
+/* goto *address, labels as values are GNU C */
+#define FSM_JUMP(ADDRESS) \
+    _Pragma("GCC diagnostic push") \
+    _Pragma("GCC diagnostic ignored \"-Wpedantic\"") \
+    goto *(ADDRESS); \
+    _Pragma("GCC diagnostic pop")
+#else
+#define FSM_GOTO 0
+#endif
+
+/* pieces expanded once per list entry, P is prefix of names */
+#define FSM_ENUMERATOR(P, N) P##_##N,
+#define FSM_NAME(P, N) #N,
+#define FSM_COUNT(P, N) + 1
+#define FSM_COUNT_TRANSITION(P, F, E, T, A) + 1
+#define FSM_TRANSITION(P, F, E, T, A) P##_on_##F##_##E,
+#define FSM_NEXT(P, F, E, T, A) [P##_##F][P##_##E] = P##_##T,
+#define FSM_INDEX(P, F, E, T, A) [P##_##F][P##_##E] = P##_on_##F##_##E,
+#define FSM_ACTION(P, F, E, T, A) A,
+#define FSM_CASE(P, F, E, T, A) \
+    case P##_##F * P##_events_ + P##_##E: \
+        A(ctx); \
+        state = P##_##T; \
+        break;
+#define FSM_LABEL(P, F, E, T, A) __extension__ &&fsm_##F##_##E,
+#define FSM_STATE_LABEL(P, N) __extension__ &&fsm_state_##N,
+#define FSM_STATE_BLOCK(P, N) \
+    fsm_state_##N: \
+        if (i == n) \
+            return P##_##N; \
+        FSM_JUMP(go[P##_index_[P##_##N][events[i++]]])
+#define FSM_TRANSITION_BLOCK(P, F, E, T, A) \
+    fsm_##F##_##E: \
+        A(ctx); \
+        goto fsm_state_##T;
+
+#if FSM_GOTO
+#define FSM_DEFINE_GOTO(NAME, P, STATES, TRANSITIONS) \
+    static inline enum NAME##_state NAME##_run_goto( \
+            enum NAME##_state state, unsigned char const* events, size_t n, void* ctx) { \
+        static void* const at[] = { STATES(FSM_STATE_LABEL, P) }; \
+        static void* const go[] = { \
+            __extension__ &&fsm_unlisted, TRANSITIONS(FSM_LABEL, P) \
+        }; \
+        size_t i = 0; \
+        \
+        FSM_JUMP(at[state]) \
+    fsm_unlisted: \
+        FSM_JUMP(at[0]) \
+        TRANSITIONS(FSM_TRANSITION_BLOCK, P) \
+        STATES(FSM_STATE_BLOCK, P) \
+    }
+#else
+#define FSM_DEFINE_GOTO(NAME, P, STATES, TRANSITIONS)
+#endif
+
+#define DEFINE_FSM(NAME, P, STATES, EVENTS, TRANSITIONS) \
+    enum NAME##_state { STATES(FSM_ENUMERATOR, P) }; \
+    enum NAME##_event { EVENTS(FSM_ENUMERATOR, P) }; \
+    /* transition numbers, 0 is every unlisted pair */ \
+    enum NAME##_transition { P##_unlisted_, TRANSITIONS(FSM_TRANSITION, P) }; \
+    enum { \
+        NAME##_states = 0 STATES(FSM_COUNT, P), \
+        NAME##_events = 0 EVENTS(FSM_COUNT, P), \
+        NAME##_transitions = 0 TRANSITIONS(FSM_COUNT_TRANSITION, P), \
+        P##_events_ = NAME##_events \
+    }; \
+    _Static_assert(NAME##_states <= 256 && NAME##_events <= 256 \
+                   && NAME##_transitions < 256, #NAME " tables hold bytes"); \
+    \
+    static char const* const NAME##_state_names[] = { STATES(FSM_NAME, P) }; \
+    static char const* const NAME##_event_names[] = { EVENTS(FSM_NAME, P) }; \
+    static unsigned char const NAME##_next[NAME##_states][NAME##_events] = { \
+        TRANSITIONS(FSM_NEXT, P) \
+    }; \
+    static unsigned char const P##_index_[NAME##_states][NAME##_events] = { \
+        TRANSITIONS(FSM_INDEX, P) \
+    }; \
+    static fsm_action* const NAME##_actions[] = { fsm_none, TRANSITIONS(FSM_ACTION, P) }; \
+    \
+    static inline enum NAME##_state NAME##_run_table( \
+            enum NAME##_state state, unsigned char const* events, size_t n, void* ctx) { \
+        unsigned s = state; \
+        size_t i; \
+        \
+        for( i = 0; i < n; i++ ) { \
+            unsigned char const event = events[i]; \
+            \
+            NAME##_actions[P##_index_[s][event]](ctx); \
+            s = NAME##_next[s][event]; \
+        } \
+        return (enum NAME##_state)s; \
+    } \
+    \
+    static inline enum NAME##_state NAME##_run_switch( \
+            enum NAME##_state state, unsigned char const* events, size_t n, void* ctx) { \
+        size_t i; \
+        \
+        for( i = 0; i < n; i++ ) \
+            switch (state * P##_events_ + events[i]) { \
+            TRANSITIONS(FSM_CASE, P) \
+            default: \
+                state = (enum NAME##_state)0; \
+                break; \
+            } \
+        return state; \
+    } \
+    \
+    FSM_DEFINE_GOTO(NAME, P, STATES, TRANSITIONS)
+
+#endif /* FSM_H */
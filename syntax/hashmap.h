@@ -0,0 +1,276 @@
+/* 
+ * Open addressing hash tables, generated like DEFINE_PAIR
+ * (polymorphisms.c) and DEFINE_VEC (vec.h):
+ *
+ *   DEFINE_HASHMAP(NAME, K, V, HASH, EQ)
+ *
+ * defines struct hashmap(NAME) mapping K to V, and functions
+ * hashmap_NAME_init, _free, _reserve, _find, _insert, _erase
+ * and _next (iteration). HASH(key) -> uint64_t and
+ * EQ(a, b) -> bool are macros (or inline functions), expanded
+ * in place, so no call goes through a function pointer.
+ *
+ * Layout is "Swiss table" like: one control byte per slot
+ * (EMPTY, DELETED, or 7 low bits of hash for full slots) kept
+ * apart from the slots. Lookups compare 16 control bytes at
+ * once (SSE2, one compare and movemask), and touch a slot only
+ * when its 7 hash bits match, so a lookup costs about one
+ * cache miss for control bytes and one for the slot, with no
+ * pointer chasing. Groups are probed in triangular order, the
+ * table keeps at most 7/8 of slots used (tombstones included).
+ */
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdint.h>
+/* for: uint8_t, uint64_t */
+#include <stdbool.h>
+/* for: bool */
+#include <string.h>
+/* for: memset */
+#include <stdalign.h>
+/* for: alignof */
+#include "allocator.h"
+/* for: struct allocator */
+
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
+#define HASHMAP_GROUP 16
+#define HASHMAP_EMPTY ((uint8_t)0x80)    /* never used, stops probing */
+#define HASHMAP_DELETED ((uint8_t)0xFE)  /* erased, probing goes on */
+/* full slots hold 0x00..0x7F, high bit clear */
+
+/* Mixes all bits of x into all bits of result (murmur3 finalizer). */
+static inline uint64_t hashmap_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+/* bit i set when group[i] == h2 */
+static inline unsigned hashmap_match(uint8_t const* group, uint8_t h2) {
+#if defined(__SSE2__)
+    __m128i ctrl = _mm_load_si128((__m128i const*)group);
+    return (unsigned)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
+#else
+    unsigned mask = 0;
+    int i;
+    for( i = 0; i < HASHMAP_GROUP; i++ )
+        mask |= (unsigned)(group[i] == h2) << i;
+    return mask;
+#endif
+}
+
+/* bit i set when group[i] is EMPTY or DELETED (high bit set) */
+static inline unsigned hashmap_match_free(uint8_t const* group) {
+#if defined(__SSE2__)
+    return (unsigned)_mm_movemask_epi8(
+        _mm_load_si128((__m128i const*)group));
+#else
+    unsigned mask = 0;
+    int i;
+    for( i = 0; i < HASHMAP_GROUP; i++ )
+        mask |= (unsigned)(group[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+/* Smallest capacity (power of 2, >= 16) holding n at 7/8 load. */
+static inline size_t hashmap_capacity_for(size_t n) {
+    size_t capacity = HASHMAP_GROUP;
+    while (capacity / 8 * 7 < n)
+        capacity *= 2;
+    return capacity;
+}
+
+#define hashmap(NAME) hashmap_##NAME
+/* e.g. NAME = int_int -> hashmap_int_int */
+#define DEFINE_HASHMAP(NAME, K, V, HASH, EQ) \
+struct hashmap_##NAME##_slot {\
+    K key;\
+    V value;\
+};\
+struct hashmap(NAME) {\
+    uint8_t* ctrl;                        /* capacity control bytes */\
+    struct hashmap_##NAME##_slot* slots;  /* same block, after ctrl */\
+    size_t capacity;                      /* 0 or power of 2, >= 16 */\
+    size_t size;\
+    size_t growth_left;                   /* EMPTY slots usable */\
+    struct allocator alloc;\
+};\
+static inline size_t hashmap_##NAME##_slots_offset(size_t capacity) {\
+    size_t align = alignof(struct hashmap_##NAME##_slot);\
+    return (capacity + align - 1) / align * align;\
+}\
+static inline size_t hashmap_##NAME##_bytes(size_t capacity) {\
+    return hashmap_##NAME##_slots_offset(capacity)\
+         + capacity * sizeof(struct hashmap_##NAME##_slot);\
+}\
+static inline size_t hashmap_##NAME##_align(void) {\
+    return alignof(struct hashmap_##NAME##_slot) > HASHMAP_GROUP\
+         ? alignof(struct hashmap_##NAME##_slot) : HASHMAP_GROUP;\
+}\
+static inline void hashmap_##NAME##_init(\
+    struct hashmap(NAME)* m, struct allocator alloc\
+) {\
+    m->ctrl = NULL;\
+    m->slots = NULL;\
+    m->capacity = m->size = m->growth_left = 0;\
+    m->alloc = alloc;\
+}\
+static inline void hashmap_##NAME##_free(struct hashmap(NAME)* m) {\
+    if (m->ctrl != NULL)\
+        m->alloc.resize(m->alloc.ctx, m->ctrl,\
+            hashmap_##NAME##_bytes(m->capacity), 0, hashmap_##NAME##_align());\
+    hashmap_##NAME##_init(m, m->alloc);\
+}\
+/* first EMPTY or DELETED slot on probe path of hash */\
+static inline size_t hashmap_##NAME##_free_slot(\
+    struct hashmap(NAME) const* m, uint64_t hash\
+) {\
+    size_t mask = m->capacity / HASHMAP_GROUP - 1;\
+    size_t g = (size_t)(hash >> 7) & mask;\
+    size_t step = 0;\
+    unsigned match;\
+    while ((match = hashmap_match_free(m->ctrl + g * HASHMAP_GROUP)) == 0)\
+        g = (g + ++step) & mask;\
+    return g * HASHMAP_GROUP + (size_t)__builtin_ctz(match);\
+}\
+/* index of key, or capacity when missing */\
+static inline size_t hashmap_##NAME##_index(\
+    struct hashmap(NAME) const* m, K key, uint64_t hash\
+) {\
+    size_t mask = m->capacity / HASHMAP_GROUP - 1;\
+    size_t g = (size_t)(hash >> 7) & mask;\
+    size_t step = 0;\
+    uint8_t h2 = (uint8_t)(hash & 0x7F);\
+    if (m->capacity == 0)\
+        return 0;\
+    for(;;) {\
+        uint8_t const* group = m->ctrl + g * HASHMAP_GROUP;\
+        unsigned match = hashmap_match(group, h2);\
+        while (match != 0) {\
+            size_t i = g * HASHMAP_GROUP + (size_t)__builtin_ctz(match);\
+            if (EQ(m->slots[i].key, key))\
+                return i;\
+            match &= match - 1;\
+        }\
+        if (hashmap_match(group, HASHMAP_EMPTY) != 0)\
+            return m->capacity;\
+        g = (g + ++step) & mask;\
+    }\
+}\
+/* moves all entries to a fresh table of capacity slots */\
+static inline bool hashmap_##NAME##_rehash(\
+    struct hashmap(NAME)* m, size_t capacity\
+) {\
+    struct hashmap(NAME) fresh;\
+    size_t i;\
+    fresh.alloc = m->alloc;\
+    fresh.ctrl = m->alloc.resize(m->alloc.ctx, NULL, 0,\
+        hashmap_##NAME##_bytes(capacity), hashmap_##NAME##_align());\
+    if (fresh.ctrl == NULL)\
+        return false;\
+    fresh.slots = (struct hashmap_##NAME##_slot*)\
+        (fresh.ctrl + hashmap_##NAME##_slots_offset(capacity));\
+    fresh.capacity = capacity;\
+    fresh.size = m->size;\
+    fresh.growth_left = capacity / 8 * 7 - m->size;\
+    memset(fresh.ctrl, HASHMAP_EMPTY, capacity);\
+    for( i = 0; i < m->capacity; i++ ) {\
+        if (m->ctrl[i] < 0x80) {\
+            uint64_t hash = HASH(m->slots[i].key);\
+            size_t at = hashmap_##NAME##_free_slot(&fresh, hash);\
+            fresh.ctrl[at] = (uint8_t)(hash & 0x7F);\
+            fresh.slots[at] = m->slots[i];\
+        }\
+    }\
+    hashmap_##NAME##_free(m);\
+    *m = fresh;\
+    return true;\
+}\
+static inline bool hashmap_##NAME##_reserve(struct hashmap(NAME)* m, size_t n) {\
+    size_t capacity = hashmap_capacity_for(n);\
+    return capacity <= m->capacity || hashmap_##NAME##_rehash(m, capacity);\
+}\
+static inline V* hashmap_##NAME##_find(struct hashmap(NAME) const* m, K key) {\
+    size_t i;\
+    if (m->size == 0)\
+        return NULL;\
+    i = hashmap_##NAME##_index(m, key, HASH(key));\
+    return i != m->capacity ? &m->slots[i].value : NULL;\
+}\
+/* inserts or overwrites, false if out of memory */\
+static inline bool hashmap_##NAME##_insert(struct hashmap(NAME)* m, K key, V value) {\
+    uint64_t hash = HASH(key);\
+    size_t i = m->capacity == 0 ? 0 : hashmap_##NAME##_index(m, key, hash);\
+    if (i != m->capacity) {\
+        m->slots[i].value = value;\
+        return true;\
+    }\
+    i = m->capacity == 0 ? 0 : hashmap_##NAME##_free_slot(m, hash);\
+    if (m->capacity == 0 || (m->ctrl[i] == HASHMAP_EMPTY && m->growth_left == 0)) {\
+        /* out of EMPTY slots: drop tombstones, or grow when still full */\
+        size_t capacity = hashmap_capacity_for(m->size + 1);\
+        if (capacity < m->capacity)\
+            capacity = m->capacity;\
+        if (capacity == m->capacity && (m->size + 1) * 32 > capacity * 25)\
+            capacity *= 2;\
+        if (!hashmap_##NAME##_rehash(m, capacity))\
+            return false;\
+        i = hashmap_##NAME##_free_slot(m, hash);\
+    }\
+    if (m->ctrl[i] == HASHMAP_EMPTY)\
+        m->growth_left--;\
+    m->ctrl[i] = (uint8_t)(hash & 0x7F);\
+    m->slots[i].key = key;\
+    m->slots[i].value = value;\
+    m->size++;\
+    return true;\
+}\
+static inline bool hashmap_##NAME##_erase(struct hashmap(NAME)* m, K key) {\
+    uint8_t* group;\
+    size_t i;\
+    if (m->size == 0)\
+        return false;\
+    i = hashmap_##NAME##_index(m, key, HASH(key));\
+    if (i == m->capacity)\
+        return false;\
+    /* group with an EMPTY slot ends every probe, no tombstone needed */\
+    group = m->ctrl + i / HASHMAP_GROUP * HASHMAP_GROUP;\
+    if (hashmap_match(group, HASHMAP_EMPTY) != 0) {\
+        m->ctrl[i] = HASHMAP_EMPTY;\
+        m->growth_left++;\
+    } else {\
+        m->ctrl[i] = HASHMAP_DELETED;\
+    }\
+    m->size--;\
+    return true;\
+}\
+/* iteration: slot at or after *i, NULL at end; start with *i = 0 */\
+static inline struct hashmap_##NAME##_slot* hashmap_##NAME##_next(\
+    struct hashmap(NAME) const* m, size_t* i\
+) {\
+    for( ; *i < m->capacity; (*i)++ )\
+        if (m->ctrl[*i] < 0x80)\
+            return &m->slots[(*i)++];\
+    return NULL;\
+}
+/* 
+ * For NAME = int_int, K = V = int ->:
+ * struct hashmap_int_int_slot { int key; int value; };
+ * struct hashmap_int_int { uint8_t* ctrl; ... };
+ * static inline int* hashmap_int_int_find(struct hashmap_int_int const* m, int key)
+ * ...
+ * with HASH(key) and EQ(a, b) expanded inside.
+ */
+
+#endif /* HASHMAP_H */
@@ -0,0 +1,97 @@
+/*
+ * Struct layout analysis declared in layout.h.
+ */
+
+#include "layout.h"
+
+static size_t round_up(size_t at, size_t align) {
+    return (at + align - 1) / align * align;
+}
+
+/* alignof type, or alignas shown by offset (see layout.h) */
+static size_t field_align(struct layout const* layout, size_t i) {
+    struct layout_field const* f = &layout->fields[i];
+    size_t end = i > 0 ? layout->fields[i - 1].offset + layout->fields[i - 1].size : 0;
+    size_t align;
+
+    if (f->offset <= round_up(end, f->align))
+        return f->align;
+    align = f->offset & (0 - f->offset);
+    return align < layout->align ? align : layout->align;
+}
+
+size_t layout_padding(struct layout const* layout) {
+    size_t i, used = 0;
+
+    for( i = 0; i < layout->count; i++ )
+        used += layout->fields[i].size;
+    return layout->size - used;
+}
+
+size_t layout_reorder(struct layout const* layout, size_t* order) {
+    size_t i, j, at = 0;
+
+    /* insertion sort, stable, fields are few */
+    for( i = 0; i < layout->count; i++ ) {
+        size_t align = field_align(layout, i);
+
+        for( j = i; j > 0 && field_align(layout, order[j - 1]) < align; j-- )
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+    for( i = 0; i < layout->count; i++ ) {
+        at = round_up(at, field_align(layout, order[i]));
+        at += layout->fields[order[i]].size;
+    }
+    return round_up(at, layout->align);
+}
+
+static void print_hole(FILE* out, size_t offset, size_t size, char const* where) {
+    fprintf(out, "  %6zu %6zu         -- %zu byte%s padding%s\n",
+            offset, size, size, size == 1 ? "" : "s", where);
+}
+
+int layout_report(FILE* out, struct layout const* layout, size_t instances) {
+    size_t order[LAYOUT_MAX_FIELDS];
+    size_t i, end = 0, padding = layout_padding(layout), reordered;
+
+    if (layout->count > LAYOUT_MAX_FIELDS)
+        return -1;
+    fprintf(out, "%s: size %zu, align %zu, padding %zu (%.1f%%), %zu cache line%s\n",
+            layout->name, layout->size, layout->align, padding,
+            100.0 * (double)padding / (double)layout->size,
+            round_up(layout->size, LAYOUT_CACHE_LINE) / LAYOUT_CACHE_LINE,
+            layout->size > LAYOUT_CACHE_LINE ? "s" : "");
+    fprintf(out, "  %6s %6s %5s  %s\n", "offset", "size", "align", "field");
+    for( i = 0; i < layout->count; i++ ) {
+        struct layout_field const* f = &layout->fields[i];
+
+        if (f->offset > end)
+            print_hole(out, end, f->offset - end, "");
+        fprintf(out, "  %6zu %6zu %5zu  %s %s", f->offset, f->size,
+                field_align(layout, i), f->type, f->name);
+        /* field fitting in a line, but split between two lines */
+        if (f->size > 0 && f->size <= LAYOUT_CACHE_LINE
+                && f->offset / LAYOUT_CACHE_LINE
+                   != (f->offset + f->size - 1) / LAYOUT_CACHE_LINE)
+            fprintf(out, "  <- straddles cache line %zu",
+                    (f->offset + f->size - 1) / LAYOUT_CACHE_LINE);
+        fputc('\n', out);
+        end = f->offset + f->size;
+    }
+    if (layout->size > end)
+        print_hole(out, end, layout->size - end, " (end)");
+
+    reordered = layout_reorder(layout, order);
+    if (reordered < layout->size) {
+        fprintf(out, "  suggested order:");
+        for( i = 0; i < layout->count; i++ )
+            fprintf(out, " %s", layout->fields[order[i]].name);
+        fprintf(out, " -> size %zu\n", reordered);
+    } else
+        fprintf(out, "  no order is smaller\n");
+    fprintf(out, "  %zu instances: %zu bytes, reordered %zu, saved %zu\n",
+            instances, instances * layout->size, instances * reordered,
+            instances * (layout->size - reordered));
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Struct layout analyzer.
+ *
+ * Fields of a struct are listed once, X-macro style, as
+ * F(S, type, name) calls of a list macro taking (F, S):
+ *
+ *   #define MIXED_FIELDS(F, S) \
+ *       F(S, char, data1) F(S, short, data2) F(S, int, data3)
+ *
+ * LAYOUT_STRUCT declares the struct from the list (or an
+ * existing struct is listed as it is declared), and
+ * DEFINE_LAYOUT records what the compiler did with it:
+ * offsets and sizes by offsetof/sizeof, so nothing is worked
+ * out by hand. layout_report then prints field offsets,
+ * padding holes, cache line straddles, an order without
+ * interior padding and memory it saves for N instances.
+ *
+ * Array members need a typedef (type must be one token
+ * sequence before name). Alignment of a member is alignof
+ * of its type, unless its offset shows a bigger alignas,
+ * then it is the biggest power of two dividing the offset.
+ */
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <stddef.h>
+/* for: size_t, offsetof */
+#include <stdio.h>
+/* for: FILE */
+#include <stdalign.h>
+/* for: alignof */
+
+#define LAYOUT_CACHE_LINE 64
+#define LAYOUT_MAX_FIELDS 256
+
+struct layout_field {
+    char const* name;
+    char const* type;
+    size_t offset;
+    size_t size;
+    size_t align;       /* of type, see above for alignas */
+};
+
+struct layout {
+    char const* name;
+    size_t size;
+    size_t align;
+    struct layout_field const* fields;  /* in declaration order */
+    size_t count;
+};
+
+#define LAYOUT_MEMBER(S, T, N) T N;
+#define LAYOUT_FIELD(S, T, N) \
+    {#N, #T, offsetof(S, N), sizeof(((S*)0)->N), alignof(T)},
+
+/* struct TAG { fields }; */
+#define LAYOUT_STRUCT(TAG, FIELDS) \
+    struct TAG { FIELDS(LAYOUT_MEMBER, struct TAG) };
+
+/* struct layout NAME##_layout describing type S */
+#define DEFINE_LAYOUT(NAME, S, FIELDS) \
+    static struct layout_field const NAME##_layout_fields[] = { \
+        FIELDS(LAYOUT_FIELD, S) \
+    }; \
+    static struct layout const NAME##_layout = { \
+        #S, sizeof(S), alignof(S), NAME##_layout_fields, \
+        sizeof NAME##_layout_fields / sizeof *NAME##_layout_fields \
+    };
+
+/* Bytes of padding, between fields and at the end. */
+size_t layout_padding(struct layout const* layout);
+/*
+ * Field indexes in order of decreasing alignment (stable),
+ * which leaves no padding between fields (sizes are
+ * multiples of alignments). Returns size of struct in that
+ * order, order must hold layout->count indexes.
+ */
+size_t layout_reorder(struct layout const* layout, size_t* order);
+/*
+ * Prints table of fields with holes and cache line
+ * straddles, suggested order and bytes saved for
+ * instances objects. -1 if struct has too many fields.
+ */
+int layout_report(FILE* out, struct layout const* layout, size_t instances);
+
+#endif /* LAYOUT_H */
@@ -0,0 +1,83 @@
+/* 
+ * Type bucketing and batch dispatch declared in object.h.
+ */
+
+#include "object.h"
+#include <stdlib.h>
+/* for: malloc, free */
+
+bool object_buckets_init(
+    struct object_buckets* buckets, struct parent const* const* objects, size_t n
+) {
+    size_t at[OBJECT_MAX_TYPES];
+    size_t i;
+    unsigned t;
+
+    for( t = 0; t <= OBJECT_MAX_TYPES; t++ )
+        buckets->start[t] = 0;
+    buckets->count = n;
+    if (n == 0) {
+        /* malloc(0) may give NULL, which is not out of memory */
+        buckets->objects = NULL;
+        buckets->index = NULL;
+        return true;
+    }
+    buckets->objects = malloc(n * sizeof(*buckets->objects));
+    buckets->index = malloc(n * sizeof(*buckets->index));
+    if (buckets->objects == NULL || buckets->index == NULL) {
+        object_buckets_free(buckets);
+        return false;
+    }
+
+    /* count objects of every type */
+    for( i = 0; i < n; i++ ) {
+        unsigned id = objects[i]->vtable->type_id;
+        if (id >= OBJECT_MAX_TYPES) {
+            object_buckets_free(buckets);
+            return false;
+        }
+        buckets->start[id + 1]++;
+    }
+    for( t = 0; t < OBJECT_MAX_TYPES; t++ ) {
+        buckets->start[t + 1] += buckets->start[t];
+        at[t] = buckets->start[t];
+    }
+    /* place them, keeping original order inside bucket */
+    for( i = 0; i < n; i++ ) {
+        size_t to = at[objects[i]->vtable->type_id]++;
+        buckets->objects[to] = objects[i];
+        buckets->index[to] = i;
+    }
+    return true;
+}
+
+void object_buckets_free(struct object_buckets* buckets) {
+    free(buckets->objects);
+    free(buckets->index);
+    buckets->objects = NULL;
+    buckets->index = NULL;
+    buckets->count = 0;
+}
+
+void object_buckets_area(struct object_buckets const* buckets, double* out) {
+    unsigned t;
+
+    for( t = 0; t < OBJECT_MAX_TYPES; t++ ) {
+        size_t begin = buckets->start[t];
+        size_t n = buckets->start[t + 1] - begin;
+        struct parent_vtable const* vtable;
+
+        if (n == 0)
+            continue;
+        vtable = buckets->objects[begin]->vtable;
+        if (vtable->area_batch != NULL) {
+            /* one indirect call per type */
+            vtable->area_batch(
+                buckets->objects + begin, buckets->index + begin, n, out);
+        } else if (vtable->area != NULL) {
+            size_t i;
+            for( i = begin; i < begin + n; i++ )
+                out[buckets->index[i]] = vtable->area(buckets->objects[i]);
+        }
+    }
+}
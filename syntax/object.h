@@ -0,0 +1,83 @@
+/* 
+ * Inclusion polymorphism (see polymorphisms.c) with virtual
+ * methods: struct parent starts with a pointer to a table of
+ * functions of its concrete type (vtable), every "class"
+ * embeds struct parent as first member.
+ *
+ * Calling a method per object (o->vtable->area(o)) over a
+ * mixed array is an indirect call whose target changes from
+ * object to object, so it is often mispredicted and never
+ * inlined. struct object_buckets groups objects by concrete
+ * type once, then every method call is one call per type of a
+ * monomorphic loop (DEFINE_OBJECT_BATCH) with the method
+ * called directly, inlined.
+ */
+#ifndef OBJECT_H
+#define OBJECT_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+
+/* type_id of every vtable must be below this */
+#define OBJECT_MAX_TYPES 64
+
+struct parent;
+
+/* Result of method for objects[i] goes to out[index[i]]. */
+typedef void (object_batch)(
+    struct parent const* const* objects, size_t const* index, 
+    size_t n, double* out);
+
+struct parent_vtable {
+    char const* type_name;
+    unsigned type_id;   /* dense small number, for bucketing */
+    void (*print)(struct parent const* this);
+    double (*area)(struct parent const* this);
+    object_batch* area_batch;
+    /* methods may be NULL when type has none */
+};
+
+struct parent {
+    struct parent_vtable const* vtable;
+    const char* field_parent;
+};
+struct child {
+    struct parent base;
+    const char* field_child;
+};
+
+/* 
+ * Defines static TYPE_METHOD_batch (object_batch) calling
+ * TYPE_METHOD(struct TYPE const*) directly, e.g. for
+ * TYPE = circle, METHOD = area: circle_area_batch calling
+ * circle_area for every object.
+ */
+#define DEFINE_OBJECT_BATCH(TYPE, METHOD) \
+static void TYPE##_##METHOD##_batch(\
+    struct parent const* const* objects, size_t const* index,\
+    size_t n, double* out\
+) {\
+    size_t i;\
+    for( i = 0; i < n; i++ )\
+        out[index[i]] = TYPE##_##METHOD((struct TYPE const*)objects[i]);\
+}
+
+/* Objects grouped by concrete type (stable counting sort). */
+struct object_buckets {
+    struct parent const** objects;  /* grouped by type_id */
+    size_t* index;                  /* position in original array */
+    size_t start[OBJECT_MAX_TYPES + 1];
+    size_t count;
+};
+
+/* false if out of memory or some type_id is too big */
+bool object_buckets_init(
+    struct object_buckets* buckets, struct parent const* const* objects, size_t n);
+void object_buckets_free(struct object_buckets* buckets);
+
+/* out[i] = area of objects[i] of object_buckets_init */
+void object_buckets_area(struct object_buckets const* buckets, double* out);
+
+#endif /* OBJECT_H */
@@ -0,0 +1,138 @@
+/*
+ * Batched output declared in out.h.
+ *
+ * Buffer is never moved, so bytes buffered before a segment
+ * are gathered as an iovec pointing into it; flush writes
+ * them all, in order, with writev (resumed after partial
+ * writes and interrupts).
+ */
+
+/* for writev */
+#define _POSIX_C_SOURCE 200809L
+
+#include "out.h"
+#include <stdlib.h>
+/* for: malloc, free */
+#include <errno.h>
+/* for: errno, EINTR */
+#include <sys/uio.h>
+/* for: writev */
+
+/* out_reserve must always fit a formatted number */
+#define OUT_MIN_CAPACITY 256
+
+bool out_init(struct out* out, int fd, size_t capacity) {
+    if (capacity == 0)
+        capacity = OUT_CAPACITY;
+    if (capacity < OUT_MIN_CAPACITY)
+        capacity = OUT_MIN_CAPACITY;
+    out->fd = fd;
+    out->shared = NULL;
+    out->buffer = malloc(capacity);
+    out->capacity = capacity;
+    out->used = 0;
+    out->gathered = 0;
+    out->segments = 0;
+    out->failed = false;
+    return out->buffer != NULL;
+}
+
+bool out_init_shared(struct out* out, struct out_shared* shared, size_t capacity) {
+    bool ok = out_init(out, shared->fd, capacity);
+
+    out->shared = shared;
+    return ok;
+}
+
+int out_free(struct out* out) {
+    int result = out_flush(out);
+
+    free(out->buffer);
+    out->buffer = NULL;
+    out->capacity = 0;
+    return result;
+}
+
+bool out_shared_init(struct out_shared* shared, int fd) {
+    shared->fd = fd;
+    return mtx_init(&shared->lock, mtx_plain) == thrd_success;
+}
+
+void out_shared_free(struct out_shared* shared) {
+    mtx_destroy(&shared->lock);
+}
+
+/* buffered bytes not yet in a segment become one */
+static void gather(struct out* out) {
+    if (out->used > out->gathered) {
+        out->segment[out->segments].iov_base = out->buffer + out->gathered;
+        out->segment[out->segments].iov_len = out->used - out->gathered;
+        out->segments++;
+        out->gathered = out->used;
+    }
+}
+
+static int write_segments(int fd, struct iovec* segment, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, segment, count);
+
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        /* skip written segments, advance into partly written one */
+        while (count > 0 && (size_t)written >= segment->iov_len) {
+            written -= (ssize_t)segment->iov_len;
+            segment++;
+            count--;
+        }
+        if (count > 0) {
+            segment->iov_base = (char*)segment->iov_base + written;
+            segment->iov_len -= (size_t)written;
+        }
+    }
+    return 0;
+}
+
+int out_flush(struct out* out) {
+    gather(out);
+    if (out->segments > 0 && !out->failed) {
+        int result;
+
+        if (out->shared != NULL)
+            mtx_lock(&out->shared->lock);
+        result = write_segments(out->fd, out->segment, out->segments);
+        if (out->shared != NULL)
+            mtx_unlock(&out->shared->lock);
+        out->failed = result != 0;
+    }
+    out->used = 0;
+    out->gathered = 0;
+    out->segments = 0;
+    return out->failed ? -1 : 0;
+}
+
+int out_write(struct out* out, void const* data, size_t size) {
+    if (size > out->capacity - out->used) {
+        if (out_flush(out) != 0)
+            return -1;
+        /* would not fit even in empty buffer, written in place now */
+        if (size > out->capacity)
+            return out_segment(out, data, size) | out_flush(out);
+    }
+    memcpy(out->buffer + out->used, data, size);
+    out->used += size;
+    return 0;
+}
+
+int out_segment(struct out* out, void const* data, size_t size) {
+    /* room for buffered bytes, data and bytes buffered after it */
+    if (out->segments + 3 > OUT_SEGMENTS && out_flush(out) != 0)
+        return -1;
+    gather(out);
+    out->segment[out->segments].iov_base = (void*)data;
+    out->segment[out->segments].iov_len = size;
+    out->segments++;
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Batched output to a file descriptor.
+ *
+ * Text is copied into one big user-space buffer and written
+ * by out_flush (or when buffer is full) with a single writev,
+ * instead of a locked stdio call (and maybe a syscall) per
+ * line. Long pre-formatted text can be passed by reference
+ * with out_segment, it is gathered by writev without copy.
+ *
+ * A struct out is not locked, it belongs to one thread.
+ * Concurrent writers use one struct out each, bound to a
+ * struct out_shared: buffers are then written whole under
+ * the shared lock, so lines of threads never interleave.
+ *
+ * Functions returning int give 0, or -1 when write failed
+ * (out->failed stays set, later output is dropped).
+ */
+#ifndef OUT_H
+#define OUT_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include <string.h>
+/* for: strlen, memcpy */
+#include <threads.h>
+/* for: mtx_t */
+#include <sys/uio.h>
+/* for: struct iovec */
+#include "fmt.h"
+/* for: fmt(buffer, x), FMT_BUFFER_SIZE */
+
+#define OUT_CAPACITY ((size_t)1 << 16)
+/* iovecs per writev, far below IOV_MAX */
+#define OUT_SEGMENTS 64
+
+struct out_shared {
+    int fd;
+    mtx_t lock;
+};
+
+struct out {
+    int fd;
+    struct out_shared* shared;  /* NULL: single writer */
+    char* buffer;
+    size_t capacity;
+    size_t used;
+    size_t gathered;            /* buffer bytes already in segment */
+    struct iovec segment[OUT_SEGMENTS];
+    int segments;
+    bool failed;
+};
+
+/*
+ * Writer of one thread to fd, buffer of capacity bytes
+ * (0 -> OUT_CAPACITY). false if out of memory.
+ */
+bool out_init(struct out* out, int fd, size_t capacity);
+/* Same, buffer is flushed under lock of shared. */
+bool out_init_shared(struct out* out, struct out_shared* shared, size_t capacity);
+/* Flushes, then frees buffer. */
+int out_free(struct out* out);
+
+/* Writes everything buffered (and gathered). */
+int out_flush(struct out* out);
+
+int out_write(struct out* out, void const* data, size_t size);
+/*
+ * data is written in place by next flush, caller keeps
+ * it unchanged until then.
+ */
+int out_segment(struct out* out, void const* data, size_t size);
+
+/* false if out of memory for lock */
+bool out_shared_init(struct out_shared* shared, int fd);
+void out_shared_free(struct out_shared* shared);
+
+/* free space in buffer, flushed first when below size */
+static inline char* out_reserve(struct out* out, size_t size) {
+    if (out->capacity - out->used < size && out_flush(out) != 0)
+        return NULL;
+    return out->buffer + out->used;
+}
+
+static inline int out_str(struct out* out, char const* text) {
+    return out_write(out, text, strlen(text));
+}
+
+/* puts */
+static inline int out_line(struct out* out, char const* text) {
+    size_t size = strlen(text);
+    char* p;
+
+    if (size >= out->capacity)
+        return out_write(out, text, size) | out_write(out, "\n", 1);
+    p = out_reserve(out, size + 1);
+    if (p == NULL)
+        return -1;
+    memcpy(p, text, size);
+    p[size] = '\n';
+    out->used += size + 1;
+    return 0;
+}
+
+/* Number x formatted by fmt (fmt.h) straight into buffer. */
+#define out_print(out, x) \
+    (out_reserve((out), FMT_BUFFER_SIZE) == NULL ? -1 \
+     : ((out)->used += fmt((out)->buffer + (out)->used, (x)), 0))
+
+#endif /* OUT_H */
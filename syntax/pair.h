@@ -0,0 +1,34 @@
+/* 
+ * Parametric pair type of "Parametric Polymorphism" in
+ * polymorphisms.c (which keeps its own, as notes), for
+ * benchmarks.
+ */
+#ifndef PAIR_H
+#define PAIR_H
+
+#include <stdbool.h>
+/* for: bool */
+
+#define pair(T) pair_##T
+/* e.g. T = int -> pair_int */
+#define any(T) pair_##T##_any
+/* e.g. T = int -> pair_int_any */
+#define DEFINE_PAIR(T) struct pair(T) {\
+    T fst;\
+    T snd;\
+};\
+bool any(T)(struct pair(T) pair, bool (*predicate)(T)) {\
+    return predicate(pair.fst) || predicate(pair.snd); \
+}
+/* 
+ * For T = int ->:
+ * struct pair_int {
+ *      int fst;
+ *      int snd;
+ * };
+ * bool pair_int_any(struct pair_int pair, bool (*predicate)(int)) {
+ *      return predicate(pair.fst) || predicate(pair.snd);
+ * }
+ */
+
+#endif /* PAIR_H */
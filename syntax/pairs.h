@@ -0,0 +1,116 @@
+/* 
+ * Pairs of T as struct of arrays, for struct pair_T
+ * {T fst; T snd;} made by DEFINE_PAIR(T) (see "Parametric
+ * Polymorphism" in polymorphisms.c), which comes first.
+ */
+#ifndef PAIRS_H
+#define PAIRS_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdint.h>
+/* for: uint64_t */
+
+#define pairs(T) pairs_##T
+/* e.g. T = int -> pairs_int */
+#define DEFINE_PAIRS(T) struct pairs(T) {\
+    T* fst;\
+    T* snd;\
+    size_t size;\
+};\
+static inline void pairs_##T##_scatter(\
+    struct pairs(T)* to, struct pair_##T const* from, size_t n\
+) {\
+    size_t i;\
+    for( i = 0; i < n; i++ ) {\
+        to->fst[to->size + i] = from[i].fst;\
+        to->snd[to->size + i] = from[i].snd;\
+    }\
+    to->size += n;\
+}
+/* 
+ * For T = int ->:
+ * struct pairs_int {      (struct of arrays, arrays owned by caller)
+ *      int* fst;
+ *      int* snd;
+ *      size_t size;
+ * };
+ * static inline void pairs_int_scatter(...)   (appends array of pairs)
+ */
+
+/* 
+ * Batch operations over struct pairs(T) with predicate P given
+ * as macro argument (function-like macro or inline function),
+ * so it is expanded in the loop body instead of called through
+ * a pointer, and the loops can be vectorized. For T = int,
+ * P = is_positive it defines:
+ *
+ * uint64_t pairs_int_is_positive_any(struct pairs_int const*, size_t at)
+ * uint64_t pairs_int_is_positive_all(struct pairs_int const*, size_t at)
+ *      bit i: P holds for any / all of pair at + i,
+ *      for a batch of up to 64 pairs starting at at
+ *      (0 when at is past the last pair)
+ * size_t pairs_int_is_positive_count_any(struct pairs_int const*)
+ * size_t pairs_int_is_positive_count_all(struct pairs_int const*)
+ *      number of such pairs in the whole container
+ *
+ * Both sides are always evaluated (| and &, not || and &&),
+ * so P must not have side effects.
+ */
+#define PAIRS_BATCH 64
+
+/* 
+ * Packs 64 flag bytes (0 or 1) into 64 bits: flags are
+ * computed in a loop which vectorizes, then every 8 bytes are
+ * gathered into 8 bits by one multiply (each byte's bit is
+ * shifted to its own place in the top byte).
+ */
+static inline uint64_t pairs_pack(unsigned char const* flags) {
+    uint64_t mask = 0;
+    int j, k;
+
+    for( j = 0; j < PAIRS_BATCH / 8; j++ ) {
+        uint64_t w = 0;
+        for( k = 0; k < 8; k++ )
+            w |= (uint64_t)flags[8 * j + k] << (8 * k);
+        mask |= (w * 0x0102040810204080ull >> 56) << (8 * j);
+    }
+    return mask;
+}
+
+/* pairs of a batch at at, none when at is past size */
+static inline size_t pairs_batch_size(size_t size, size_t at) {
+    if (at >= size)
+        return 0;
+    return size - at < PAIRS_BATCH ? size - at : PAIRS_BATCH;
+}
+
+#define DEFINE_PAIRS_PREDICATE(T, P) \
+static inline uint64_t pairs_##T##_##P##_any(struct pairs(T) const* p, size_t at) {\
+    unsigned char flags[PAIRS_BATCH] = {0};\
+    size_t i, n = pairs_batch_size(p->size, at);\
+    for( i = 0; i < n; i++ )\
+        flags[i] = (P(p->fst[at + i]) != 0) | (P(p->snd[at + i]) != 0);\
+    return pairs_pack(flags);\
+}\
+static inline uint64_t pairs_##T##_##P##_all(struct pairs(T) const* p, size_t at) {\
+    unsigned char flags[PAIRS_BATCH] = {0};\
+    size_t i, n = pairs_batch_size(p->size, at);\
+    for( i = 0; i < n; i++ )\
+        flags[i] = (P(p->fst[at + i]) != 0) & (P(p->snd[at + i]) != 0);\
+    return pairs_pack(flags);\
+}\
+static inline size_t pairs_##T##_##P##_count_any(struct pairs(T) const* p) {\
+    size_t i, count = 0;\
+    for( i = 0; i < p->size; i++ )\
+        count += (P(p->fst[i]) != 0) | (P(p->snd[i]) != 0);\
+    return count;\
+}\
+static inline size_t pairs_##T##_##P##_count_all(struct pairs(T) const* p) {\
+    size_t i, count = 0;\
+    for( i = 0; i < p->size; i++ )\
+        count += (P(p->fst[i]) != 0) & (P(p->snd[i]) != 0);\
+    return count;\
+}
+
+#endif /* PAIRS_H */
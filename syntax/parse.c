@@ -0,0 +1,468 @@
+/*
+ * Integer parsing declared in parse.h.
+ *
+ * Digits of a token are right aligned in a vector by pshufb
+ * (zeros before them), then
+ *   pmaddubsw  x 10, 1      8 lanes of 2 digits
+ *   pmaddwd    x 100, 1     4 lanes of 4 digits
+ *   packusdw, pmaddwd x 10000, 1   2 lanes of 8 digits
+ * and value is high lane * 10^8 + low lane, exact in 64 bits
+ * for the 10 digits an int has, so overflow is one compare.
+ *
+ * parse_fd buffers keep PARSE_TOKEN_MAX bytes before the read
+ * area: the unfinished token at end of a chunk is copied there
+ * in the other buffer and parsed with the rest of its chars.
+ */
+
+/* for read */
+#define _POSIX_C_SOURCE 200809L
+
+#include "parse.h"
+#include <limits.h>
+/* for: INT_MAX */
+#include <stdlib.h>
+/* for: malloc, free */
+#include <string.h>
+/* for: memcpy */
+#include <errno.h>
+/* for: errno, EINTR */
+#include <threads.h>
+/* for: thrd_create, thrd_join, mtx_t, cnd_t */
+#include <unistd.h>
+/* for: read */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define PARSE_X86 1
+#   include <immintrin.h>
+#endif
+
+static unsigned char const space[256] = {
+    [' '] = 1, ['\t'] = 1, ['\n'] = 1, ['\v'] = 1, ['\f'] = 1, ['\r'] = 1
+};
+
+#define SPACE(c) (space[(unsigned char)(c)])
+
+
+/*
+ * Token at *text (not white space) to *value, *text moved
+ * past it and its delimiter. false with *status set on error.
+ */
+static bool token_scalar(char const** text, int* value, enum parse_status* status) {
+    char const* p = *text;
+    bool negative = *p == '-';
+    uint64_t limit = (uint64_t)INT_MAX + negative;
+    uint64_t x = 0;
+    size_t sign = *p == '-' || *p == '+';
+    size_t length;
+
+    for( length = sign; (unsigned)(p[length] - '0') < 10; length++ ) {
+        if (length == PARSE_TOKEN_MAX) {
+            *status = PARSE_INVALID;
+            return false;
+        }
+        x = x * 10 + (unsigned)(p[length] - '0');
+        if (x > limit) {
+            *status = PARSE_OVERFLOW;
+            return false;
+        }
+    }
+    if (length == sign || !SPACE(p[length])) {
+        *status = PARSE_INVALID;
+        return false;
+    }
+    *value = (int)(negative ? -(int64_t)x : (int64_t)x);
+    *text = p + length + 1;
+    return true;
+}
+
+static size_t parse_scalar(
+    char const** text, char const* end, int* out, size_t capacity,
+    enum parse_status* status
+) {
+    char const* p = *text;
+    size_t count = 0;
+
+    while (count < capacity) {
+        while (p < end && SPACE(*p))
+            p++;
+        if (p >= end || !token_scalar(&p, &out[count], status))
+            break;
+        count++;
+    }
+    *text = p < end ? p : end;
+    return count;
+}
+
+#ifdef PARSE_X86
+
+/* bytes 16 - n .. 15 of window at n are indices 0 .. n - 1 */
+static signed char const right_align[32] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+};
+
+/* mask of white space bytes of 16 at p */
+__attribute__((target("sse4.1")))
+static uint64_t spaces16(char const* p) {
+    __m128i v = _mm_loadu_si128((__m128i const*)p);
+    __m128i controls = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+    /* '\t' .. '\r' are 5 consecutive codes */
+    __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(controls, _mm_set1_epi8(4)), controls);
+    __m128i is_blank = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+
+    return (uint64_t)(unsigned)_mm_movemask_epi8(_mm_or_si128(is_control, is_blank));
+}
+
+__attribute__((target("sse4.1")))
+static uint64_t spaces64(char const* p) {
+    return spaces16(p) | spaces16(p + 16) << 16 | spaces16(p + 32) << 32 | spaces16(p + 48) << 48;
+}
+
+/*
+ * Tokens are found from white space masks of 64-byte blocks
+ * (a token starts at non space after space), not by walking
+ * the text, so the next token is known before this one is
+ * converted and conversions of tokens overlap in the CPU.
+ */
+__attribute__((target("sse4.1")))
+static size_t parse_sse41(
+    char const** text, char const* end, int* out, size_t capacity,
+    enum parse_status* status
+) {
+    __m128i const zero_char = _mm_set1_epi8('0');
+    __m128i const nine = _mm_set1_epi8(9);
+    __m128i const tens = _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1);
+    __m128i const hundreds = _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1);
+    __m128i const ten_thousands = _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1);
+    char const* block;
+    uint64_t after_space = 1;   /* text starts after white space */
+    size_t count = 0;
+
+    for( block = *text; block < end; block += 64 ) {
+        uint64_t spaces = spaces64(block);
+        uint64_t starts;
+
+        /* past end is padding (or next token), not for this call */
+        if (end - block < 64)
+            spaces |= ~(uint64_t)0 << (end - block);
+        starts = ~spaces & (spaces << 1 | after_space);
+        after_space = spaces >> 63;
+
+        for( ; starts != 0; starts &= starts - 1 ) {
+            char const* token = block + __builtin_ctzll(starts);
+            int negative = *token == '-';
+            char const* digits = token + (negative | (*token == '+'));
+            __m128i d = _mm_sub_epi8(_mm_loadu_si128((__m128i const*)digits), zero_char);
+            unsigned length = (unsigned)__builtin_ctz(~(unsigned)_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d)));
+            uint64_t x;
+
+            if (count == capacity) {
+                *text = token;
+                return count;
+            }
+            /* no digit, more than 10 (zeros first?), or bad delimiter */
+            if (length - 1 >= 10 || !SPACE(digits[length])) {
+                char const* p = token;
+
+                if (!token_scalar(&p, &out[count], status)) {
+                    *text = token;
+                    return count;
+                }
+                count++;
+                continue;
+            }
+            d = _mm_shuffle_epi8(d, _mm_loadu_si128((__m128i const*)(right_align + length)));
+            d = _mm_madd_epi16(_mm_maddubs_epi16(d, tens), hundreds);
+            d = _mm_madd_epi16(_mm_packus_epi32(d, d), ten_thousands);
+            x = (uint64_t)(uint32_t)_mm_cvtsi128_si32(d) * 100000000
+              + (uint32_t)_mm_extract_epi32(d, 1);
+            if (x > (uint64_t)INT_MAX + (unsigned)negative) {
+                *status = PARSE_OVERFLOW;
+                *text = token;
+                return count;
+            }
+            out[count++] = (int)(negative ? -(int64_t)x : (int64_t)x);
+        }
+    }
+    *text = end;
+    return count;
+}
+
+#else
+#define parse_sse41 parse_scalar
+#endif
+
+
+bool parse_supported(struct parse_variant const* variant) {
+#ifdef PARSE_X86
+    __builtin_cpu_init();
+    if (variant->isa == PARSE_ISA_SSE41)
+        return __builtin_cpu_supports("sse4.1");
+#endif
+    return variant->isa == PARSE_ISA_C;
+}
+
+struct parse_variant const* parse_variants(void) {
+    static struct parse_variant const all[] = {
+        {"sse4.1", PARSE_ISA_SSE41, parse_sse41},
+        {"c",      PARSE_ISA_C,     parse_scalar},
+        {NULL,     PARSE_ISA_C,     NULL}
+    };
+    return all;
+}
+
+struct parse_variant const* parse_best(void) {
+    struct parse_variant const* v;
+
+    for( v = parse_variants(); v->name != NULL; v++ )
+        if (parse_supported(v))
+            return v;
+    return v - 1;
+}
+
+char const* parse_status_name(enum parse_status status) {
+    static char const* const names[] = {
+        "ok", "invalid token", "int overflow", "stopped by sink",
+        "read error", "not enough memory"
+    };
+    return names[status];
+}
+
+
+struct parse_state {
+    parse_kernel* parse;
+    parse_sink* sink;
+    void* ctx;
+    struct parse_result result;
+    int values[PARSE_BATCH];
+};
+
+static void state_init(
+    struct parse_state* s, struct parse_variant const* variant,
+    parse_sink* sink, void* ctx
+) {
+    s->parse = (variant != NULL ? variant : parse_best())->parse;
+    s->sink = sink;
+    s->ctx = ctx;
+    s->result.status = PARSE_OK;
+    s->result.count = 0;
+    s->result.offset = 0;
+}
+
+/*
+ * Parses [begin, end), which ends with white space and has
+ * padding after; offset is position of begin in input.
+ */
+static bool feed(struct parse_state* s, char const* begin, char const* end, uint64_t offset) {
+    char const* p = begin;
+
+    while (p < end) {
+        size_t count = s->parse(&p, end, s->values, PARSE_BATCH, &s->result.status);
+
+        s->result.count += count;
+        s->result.offset = offset + (uint64_t)(p - begin);
+        if (count != 0 && !s->sink(s->ctx, s->values, count))
+            s->result.status = PARSE_STOPPED;
+        if (s->result.status != PARSE_OK)
+            return false;
+    }
+    s->result.offset = offset + (uint64_t)(end - begin);
+    return true;
+}
+
+/* length of text up to its last white space */
+static size_t delimited(char const* text, size_t size) {
+    while (size > 0 && !SPACE(text[size - 1]))
+        size--;
+    return size;
+}
+
+struct parse_result parse_text(
+    struct parse_variant const* variant, char const* text, size_t size,
+    parse_sink* sink, void* ctx
+) {
+    struct parse_state* s = malloc(sizeof *s);
+    struct parse_result result = {PARSE_NO_MEMORY, 0, 0};
+    size_t head = 0, tail;
+    char* copy;
+
+    if (s == NULL)
+        return result;
+    state_init(s, variant, sink, ctx);
+    /* in place while loads stay inside text, rest from a padded copy */
+    if (size > PARSE_PADDING)
+        head = delimited(text, size - PARSE_PADDING);
+    tail = size - head;
+    copy = malloc(tail + 1 + PARSE_PADDING);
+    if (copy == NULL) {
+        free(s);
+        return result;
+    }
+    memcpy(copy, text + head, tail);
+    copy[tail] = '\n';
+    if (feed(s, text, text + head, 0))
+        feed(s, copy, copy + tail + 1, head);
+    if (s->result.status == PARSE_OK)
+        s->result.offset = size;
+    result = s->result;
+    free(copy);
+    free(s);
+    return result;
+}
+
+
+struct parse_buffer {
+    char* data;         /* PARSE_TOKEN_MAX, PARSE_CHUNK, PARSE_PADDING */
+    size_t size;        /* bytes read into chunk */
+    bool full;
+    bool last;          /* end of input (or read error) */
+    bool failed;
+};
+
+struct parse_reader {
+    int fd;
+    struct parse_buffer buffers[2];
+    mtx_t lock;
+    cnd_t changed;
+    bool stop;
+};
+
+static int read_chunks(void* arg) {
+    struct parse_reader* r = arg;
+    int i;
+
+    for( i = 0; ; i ^= 1 ) {
+        struct parse_buffer* b = &r->buffers[i];
+        char* chunk = b->data + PARSE_TOKEN_MAX;
+        size_t size = 0;
+        bool last = false, failed = false, stop;
+
+        mtx_lock(&r->lock);
+        while (b->full && !r->stop)
+            cnd_wait(&r->changed, &r->lock);
+        stop = r->stop;
+        mtx_unlock(&r->lock);
+        if (stop)
+            return 0;
+
+        while (size < PARSE_CHUNK && !last) {
+            ssize_t got = read(r->fd, chunk + size, PARSE_CHUNK - size);
+
+            if (got > 0)
+                size += (size_t)got;
+            else if (got == 0 || errno != EINTR) {
+                last = true;
+                failed = got < 0;
+            }
+        }
+
+        mtx_lock(&r->lock);
+        b->size = size;
+        b->last = last;
+        b->failed = failed;
+        b->full = true;
+        cnd_broadcast(&r->changed);
+        mtx_unlock(&r->lock);
+        if (last)
+            return 0;
+    }
+}
+
+struct parse_result parse_fd(
+    struct parse_variant const* variant, int fd, parse_sink* sink, void* ctx
+) {
+    struct parse_state* s = malloc(sizeof *s);
+    struct parse_result result = {PARSE_NO_MEMORY, 0, 0};
+    struct parse_reader r;
+    uint64_t offset = 0;    /* of chunk in input */
+    size_t carry = 0;       /* unfinished token before chunk */
+    thrd_t reader;
+    bool started;
+    int i;
+
+    r.fd = fd;
+    r.stop = false;
+    for( i = 0; i < 2; i++ ) {
+        r.buffers[i].data = malloc(PARSE_TOKEN_MAX + PARSE_CHUNK + PARSE_PADDING);
+        r.buffers[i].full = false;
+    }
+    if (s == NULL || r.buffers[0].data == NULL || r.buffers[1].data == NULL
+            || mtx_init(&r.lock, mtx_plain) != thrd_success) {
+        free(r.buffers[0].data);
+        free(r.buffers[1].data);
+        free(s);
+        return result;
+    }
+    if (cnd_init(&r.changed) != thrd_success) {
+        mtx_destroy(&r.lock);
+        free(r.buffers[0].data);
+        free(r.buffers[1].data);
+        free(s);
+        return result;
+    }
+    state_init(s, variant, sink, ctx);
+    started = thrd_create(&reader, read_chunks, &r) == thrd_success;
+    if (!started)
+        s->result.status = PARSE_NO_MEMORY;
+
+    for( i = 0; started; i ^= 1 ) {
+        struct parse_buffer* b = &r.buffers[i];
+        char* chunk = b->data + PARSE_TOKEN_MAX;
+        char const* begin = chunk - carry;
+        uint64_t start = offset - carry;
+        size_t size;
+
+        mtx_lock(&r.lock);
+        while (!b->full)
+            cnd_wait(&r.changed, &r.lock);
+        mtx_unlock(&r.lock);
+
+        if (b->failed) {
+            s->result.status = PARSE_READ_ERROR;
+            s->result.offset = offset + b->size;
+            break;
+        }
+        if (b->last) {
+            chunk[b->size] = '\n';
+            size = carry + b->size + 1;
+        } else {
+            size = delimited(begin, carry + b->size);
+            carry = carry + b->size - size;
+            if (carry > PARSE_TOKEN_MAX) {
+                s->result.status = PARSE_INVALID;
+                s->result.offset = start + size;
+                break;
+            }
+        }
+        if (!feed(s, begin, begin + size, start))
+            break;
+        offset += b->size;
+        if (b->last) {
+            s->result.offset = offset;
+            break;
+        }
+        /* next chunk starts with the rest of this one */
+        memcpy(r.buffers[i ^ 1].data + PARSE_TOKEN_MAX - carry, begin + size, carry);
+
+        mtx_lock(&r.lock);
+        b->full = false;
+        cnd_broadcast(&r.changed);
+        mtx_unlock(&r.lock);
+    }
+
+    if (started) {
+        mtx_lock(&r.lock);
+        r.stop = true;
+        cnd_broadcast(&r.changed);
+        mtx_unlock(&r.lock);
+        thrd_join(reader, NULL);
+    }
+    result = s->result;
+    cnd_destroy(&r.changed);
+    mtx_destroy(&r.lock);
+    free(r.buffers[0].data);
+    free(r.buffers[1].data);
+    free(s);
+    return result;
+}
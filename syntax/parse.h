@@ -0,0 +1,106 @@
+/*
+ * Decimal ints from text: optional sign and digits, separated
+ * by white space (as printf("%d\n") writes them), e.g. input
+ * of array_sum_example.
+ *
+ * The SSE4.1 kernel finds token starts from white space masks
+ * of 64-byte blocks, loads 16 bytes at each token, finds its
+ * end by a movemask of digit bytes and converts up to 10
+ * digits at once with multiply-adds (digit pairs, then groups
+ * of 4 and 8), so the only branches are on rare cases: long
+ * tokens, bad delimiter, overflow. The C kernel goes char by
+ * char.
+ *
+ * Values outside int range give PARSE_OVERFLOW, tokens with
+ * other chars (or longer than PARSE_TOKEN_MAX, leading zeros
+ * included) PARSE_INVALID, both at offset of the token.
+ *
+ * Parsed values go to a sink in batches of PARSE_BATCH, e.g.
+ * an array_sum kernel carrying the sum (array_sum.h); sink
+ * returning false stops parsing (PARSE_STOPPED).
+ */
+#ifndef PARSE_H
+#define PARSE_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include <stdint.h>
+/* for: uint64_t */
+
+/* read by parse_fd at once, one chunk read while other is parsed */
+#define PARSE_CHUNK ((size_t)1 << 20)
+/* longest token, with sign */
+#define PARSE_TOKEN_MAX 64
+/* readable bytes after end of text, kernels load past tokens */
+#define PARSE_PADDING 64
+#define PARSE_BATCH 4096
+
+enum parse_status {
+    PARSE_OK,
+    PARSE_INVALID,
+    PARSE_OVERFLOW,
+    PARSE_STOPPED,
+    PARSE_READ_ERROR,
+    PARSE_NO_MEMORY
+};
+
+struct parse_result {
+    enum parse_status status;
+    uint64_t count;     /* values given to sink */
+    uint64_t offset;    /* of token which failed, or where stopped */
+};
+
+/* takes count values, false stops parsing */
+typedef bool (parse_sink)(void* ctx, int const* values, size_t count);
+
+/*
+ * Parses text from *text up to end into out, at most capacity
+ * values, moves *text past them and returns their count. Stops
+ * early on a bad token, *text then points at it and *status
+ * tells why (it is left unchanged otherwise).
+ * Text must end with white space and PARSE_PADDING bytes after
+ * end must be readable.
+ */
+typedef size_t (parse_kernel)(
+    char const** text, char const* end, int* out, size_t capacity,
+    enum parse_status* status);
+
+/* instruction set a kernel needs */
+enum parse_isa {
+    PARSE_ISA_C,
+    PARSE_ISA_SSE41
+};
+struct parse_variant {
+    char const* name;
+    enum parse_isa isa;
+    parse_kernel* parse;
+};
+/*
+ * All kernels in order of preference, NULL name terminated.
+ * Before calling a kernel check it with parse_supported.
+ */
+struct parse_variant const* parse_variants(void);
+bool parse_supported(struct parse_variant const* variant);
+/* Best variant supported by running CPU (by CPUID). */
+struct parse_variant const* parse_best(void);
+
+/*
+ * Whole text of size bytes (no padding needed) with variant
+ * (NULL -> parse_best).
+ */
+struct parse_result parse_text(
+    struct parse_variant const* variant, char const* text, size_t size,
+    parse_sink* sink, void* ctx);
+/*
+ * fd read to its end (file, pipe, stdin) in PARSE_CHUNK
+ * chunks by a second thread, double buffered, so reading of
+ * next chunk overlaps parsing of this one.
+ */
+struct parse_result parse_fd(
+    struct parse_variant const* variant, int fd, parse_sink* sink, void* ctx);
+
+char const* parse_status_name(enum parse_status status);
+
+#endif /* PARSE_H */
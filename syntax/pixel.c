@@ -0,0 +1,380 @@
+/*
+ * Kernels declared in pixel.h.
+ *
+ * 16 pixels are 48 bytes, three 16-byte vectors. Channel c of
+ * pixel k is byte 3k + c, so each output vector of one channel
+ * gathers bytes from all three inputs: one pshufb per input
+ * (index -1 gives zero) and two ORs. AVX2 kernels do the same
+ * in both 128-bit lanes, for 16 pixels in each.
+ *
+ * Gray is computed in 16-bit lanes: 77 r + 150 g + 29 b + 128
+ * is at most 65408, so it fits unsigned 16 bits and logical
+ * shift by 8 gives the scalar result exactly.
+ */
+
+#include "pixel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define PIXEL_X86 1
+#   include <immintrin.h>
+#endif
+
+/* rows are read as bytes, 3 per pixel */
+_Static_assert(sizeof(union pixel) == 3, "union pixel must be packed");
+
+#define GRAY_R 77
+#define GRAY_G 150
+#define GRAY_B 29
+
+
+static void rgba_scalar(union pixel const* src, unsigned char* const dst[3], size_t n) {
+    unsigned char* out = dst[0];
+    size_t i;
+
+    /* pixel read whole before writes, which might alias it */
+    for( i = 0; i < n; i++ ) {
+        union pixel p = src[i];
+
+        out[4 * i] = p.named.a;
+        out[4 * i + 1] = p.named.b;
+        out[4 * i + 2] = p.named.c;
+        out[4 * i + 3] = 255;
+    }
+}
+
+static void gray_scalar(union pixel const* src, unsigned char* const dst[3], size_t n) {
+    unsigned char* out = dst[0];
+    size_t i;
+
+    for( i = 0; i < n; i++ ) {
+        union pixel p = src[i];
+
+        out[i] = (unsigned char)((GRAY_R * p.named.a + GRAY_G * p.named.b
+                                  + GRAY_B * p.named.c + 128) >> 8);
+    }
+}
+
+static void planar_scalar(union pixel const* src, unsigned char* const dst[3], size_t n) {
+    unsigned char* r = dst[0];
+    unsigned char* g = dst[1];
+    unsigned char* b = dst[2];
+    size_t i;
+
+    for( i = 0; i < n; i++ ) {
+        union pixel p = src[i];
+
+        r[i] = p.named.a;
+        g[i] = p.named.b;
+        b[i] = p.named.c;
+    }
+}
+
+/* rest of a row after SIMD part, done pixels skipped */
+static void tail(pixel_row* scalar, size_t bytes, union pixel const* src,
+                 unsigned char* const dst[3], size_t done, size_t n) {
+    unsigned char* rest[3];
+
+    rest[0] = dst[0] + done * bytes;
+    rest[1] = dst[1] != NULL ? dst[1] + done : NULL;
+    rest[2] = dst[2] != NULL ? dst[2] + done : NULL;
+    scalar(src + done, rest, n - done);
+}
+
+
+#ifdef PIXEL_X86
+
+/* shuffles gathering channel c (row) from input vector v (column) */
+static signed char const split[3][3][16] = {
+    {
+        {0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+        {-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1},
+        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13}
+    },
+    {
+        {1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+        {-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1},
+        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14}
+    },
+    {
+        {2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+        {-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1},
+        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15}
+    }
+};
+
+/* 3 bytes of a pixel to 4, per 16-byte lane, 4 pixels */
+#define RGBA_SHUFFLE 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1
+
+__attribute__((target("ssse3")))
+static __m128i channel_ssse3(int c, __m128i a, __m128i b, __m128i d) {
+    return _mm_or_si128(
+        _mm_or_si128(
+            _mm_shuffle_epi8(a, _mm_loadu_si128((__m128i const*)split[c][0])),
+            _mm_shuffle_epi8(b, _mm_loadu_si128((__m128i const*)split[c][1]))),
+        _mm_shuffle_epi8(d, _mm_loadu_si128((__m128i const*)split[c][2])));
+}
+
+__attribute__((target("ssse3")))
+static void rgba_ssse3(union pixel const* src, unsigned char* const dst[3], size_t n) {
+    __m128i const shuffle = _mm_setr_epi8(RGBA_SHUFFLE);
+    __m128i const alpha = _mm_set1_epi32((int)0xff000000u);
+    unsigned char const* in = src->at;
+    unsigned char* out = dst[0];
+    size_t i;
+
+    for( i = 0; i + 16 <= n; i += 16 ) {
+        __m128i a = _mm_loadu_si128((__m128i const*)(in + 3 * i));
+        __m128i b = _mm_loadu_si128((__m128i const*)(in + 3 * i + 16));
+        __m128i c = _mm_loadu_si128((__m128i const*)(in + 3 * i + 32));
+
+        _mm_storeu_si128((__m128i*)(out + 4 * i),
+            _mm_or_si128(_mm_shuffle_epi8(a, shuffle), alpha));
+        _mm_storeu_si128((__m128i*)(out + 4 * i + 16),
+            _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuffle), alpha));
+        _mm_storeu_si128((__m128i*)(out + 4 * i + 32),
+            _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuffle), alpha));
+        _mm_storeu_si128((__m128i*)(out + 4 * i + 48),
+            _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(c, 4), shuffle), alpha));
+    }
+    tail(rgba_scalar, 4, src, dst, i, n);
+}
+
+/* gray of 8 pixels, channels zero extended to 16 bits */
+__attribute__((target("ssse3")))
+static __m128i gray_lanes_ssse3(__m128i r, __m128i g, __m128i b) {
+    __m128i sum = _mm_add_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(GRAY_R)),
+                      _mm_mullo_epi16(g, _mm_set1_epi16(GRAY_G))),
+        _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(GRAY_B)),
+                      _mm_set1_epi16(128)));
+
+    return _mm_srli_epi16(sum, 8);
+}
+
+__attribute__((target("ssse3")))
+static void gray_ssse3(union pixel const* src, unsigned char* const dst[3], size_t n) {
+    __m128i const zero = _mm_setzero_si128();
+    unsigned char const* in = src->at;
+    unsigned char* out = dst[0];
+    size_t i;
+
+    for( i = 0; i + 16 <= n; i += 16 ) {
+        __m128i a = _mm_loadu_si128((__m128i const*)(in + 3 * i));
+        __m128i b = _mm_loadu_si128((__m128i const*)(in + 3 * i + 16));
+        __m128i c = _mm_loadu_si128((__m128i const*)(in + 3 * i + 32));
+        __m128i r = channel_ssse3(0, a, b, c);
+        __m128i g = channel_ssse3(1, a, b, c);
+        __m128i l = channel_ssse3(2, a, b, c);
+        __m128i low = gray_lanes_ssse3(_mm_unpacklo_epi8(r, zero),
+            _mm_unpacklo_epi8(g, zero), _mm_unpacklo_epi8(l, zero));
+        __m128i high = gray_lanes_ssse3(_mm_unpackhi_epi8(r, zero),
+            _mm_unpackhi_epi8(g, zero), _mm_unpackhi_epi8(l, zero));
+
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi16(low, high));
+    }
+    tail(gray_scalar, 1, src, dst, i, n);
+}
+
+__attribute__((target("ssse3")))
+static void planar_ssse3(union pixel const* src, unsigned char* const dst[3], size_t n) {
+    unsigned char const* in = src->at;
+    size_t i;
+
+    for( i = 0; i + 16 <= n; i += 16 ) {
+        __m128i a = _mm_loadu_si128((__m128i const*)(in + 3 * i));
+        __m128i b = _mm_loadu_si128((__m128i const*)(in + 3 * i + 16));
+        __m128i c = _mm_loadu_si128((__m128i const*)(in + 3 * i + 32));
+
+        _mm_storeu_si128((__m128i*)(dst[0] + i), channel_ssse3(0, a, b, c));
+        _mm_storeu_si128((__m128i*)(dst[1] + i), channel_ssse3(1, a, b, c));
+        _mm_storeu_si128((__m128i*)(dst[2] + i), channel_ssse3(2, a, b, c));
+    }
+    tail(planar_scalar, 1, src, dst, i, n);
+}
+
+/* 16 pixels per lane: lane 0 from first 48 bytes, lane 1 from next 48 */
+__attribute__((target("avx2")))
+static void load_avx2(unsigned char const* in, __m256i* a, __m256i* b, __m256i* c) {
+    *a = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128((__m128i const*)in)), _mm_loadu_si128((__m128i const*)(in + 48)), 1);
+    *b = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128((__m128i const*)(in + 16))), _mm_loadu_si128((__m128i const*)(in + 64)), 1);
+    *c = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128((__m128i const*)(in + 32))), _mm_loadu_si128((__m128i const*)(in + 80)), 1);
+}
+
+__attribute__((target("avx2")))
+static __m256i channel_avx2(int c, __m256i a, __m256i b, __m256i d) {
+    return _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_shuffle_epi8(a, _mm256_broadcastsi128_si256(
+                _mm_loadu_si128((__m128i const*)split[c][0]))),
+            _mm256_shuffle_epi8(b, _mm256_broadcastsi128_si256(
+                _mm_loadu_si128((__m128i const*)split[c][1])))),
+        _mm256_shuffle_epi8(d, _mm256_broadcastsi128_si256(
+            _mm_loadu_si128((__m128i const*)split[c][2]))));
+}
+
+__attribute__((target("avx2")))
+static void rgba_avx2(union pixel const* src, unsigned char* const dst[3], size_t n) {
+    __m256i const shuffle = _mm256_setr_epi8(RGBA_SHUFFLE, RGBA_SHUFFLE);
+    __m256i const alpha = _mm256_set1_epi32((int)0xff000000u);
+    unsigned char const* in = src->at;
+    unsigned char* out = dst[0];
+    size_t i, j;
+
+    /*
+     * pixels 0-3 to lane 0, 4-7 to lane 1, by two 16-byte loads
+     * (no lane crossing shuffle); last one reads 4 bytes past
+     * pixel 7, so 10 pixels must remain
+     */
+    for( i = 0; i + 32 + 2 <= n; i += 32 )
+        for( j = i; j < i + 32; j += 8 ) {
+            __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(
+                _mm_loadu_si128((__m128i const*)(in + 3 * j))),
+                _mm_loadu_si128((__m128i const*)(in + 3 * j + 12)), 1);
+
+            v = _mm256_shuffle_epi8(v, shuffle);
+            _mm256_storeu_si256((__m256i*)(out + 4 * j), _mm256_or_si256(v, alpha));
+        }
+    tail(rgba_scalar, 4, src, dst, i, n);
+}
+
+__attribute__((target("avx2")))
+static __m256i gray_lanes_avx2(__m256i r, __m256i g, __m256i b) {
+    __m256i sum = _mm256_add_epi16(
+        _mm256_add_epi16(_mm256_mullo_epi16(r, _mm256_set1_epi16(GRAY_R)),
+                         _mm256_mullo_epi16(g, _mm256_set1_epi16(GRAY_G))),
+        _mm256_add_epi16(_mm256_mullo_epi16(b, _mm256_set1_epi16(GRAY_B)),
+                         _mm256_set1_epi16(128)));
+
+    return _mm256_srli_epi16(sum, 8);
+}
+
+__attribute__((target("avx2")))
+static void gray_avx2(union pixel const* src, unsigned char* const dst[3], size_t n) {
+    __m256i const zero = _mm256_setzero_si256();
+    unsigned char const* in = src->at;
+    unsigned char* out = dst[0];
+    size_t i;
+
+    for( i = 0; i + 32 <= n; i += 32 ) {
+        __m256i a, b, c, r, g, l, low, high;
+
+        load_avx2(in + 3 * i, &a, &b, &c);
+        r = channel_avx2(0, a, b, c);
+        g = channel_avx2(1, a, b, c);
+        l = channel_avx2(2, a, b, c);
+        /* unpack and pack both work per lane, so order comes back */
+        low = gray_lanes_avx2(_mm256_unpacklo_epi8(r, zero),
+            _mm256_unpacklo_epi8(g, zero), _mm256_unpacklo_epi8(l, zero));
+        high = gray_lanes_avx2(_mm256_unpackhi_epi8(r, zero),
+            _mm256_unpackhi_epi8(g, zero), _mm256_unpackhi_epi8(l, zero));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_packus_epi16(low, high));
+    }
+    tail(gray_scalar, 1, src, dst, i, n);
+}
+
+__attribute__((target("avx2")))
+static void planar_avx2(union pixel const* src, unsigned char* const dst[3], size_t n) {
+    unsigned char const* in = src->at;
+    size_t i;
+
+    for( i = 0; i + 32 <= n; i += 32 ) {
+        __m256i a, b, c;
+
+        load_avx2(in + 3 * i, &a, &b, &c);
+        _mm256_storeu_si256((__m256i*)(dst[0] + i), channel_avx2(0, a, b, c));
+        _mm256_storeu_si256((__m256i*)(dst[1] + i), channel_avx2(1, a, b, c));
+        _mm256_storeu_si256((__m256i*)(dst[2] + i), channel_avx2(2, a, b, c));
+    }
+    tail(planar_scalar, 1, src, dst, i, n);
+}
+
+#else /* no x86 SIMD, every variant is the scalar one */
+
+#   define rgba_ssse3   rgba_scalar
+#   define gray_ssse3   gray_scalar
+#   define planar_ssse3 planar_scalar
+#   define rgba_avx2    rgba_scalar
+#   define gray_avx2    gray_scalar
+#   define planar_avx2  planar_scalar
+
+#endif /* PIXEL_X86 */
+
+
+bool pixel_supported(struct pixel_variant const* variant) {
+#ifdef PIXEL_X86
+    __builtin_cpu_init();
+    switch (variant->isa) {
+        case PIXEL_ISA_SSSE3: return __builtin_cpu_supports("ssse3");
+        case PIXEL_ISA_AVX2:  return __builtin_cpu_supports("avx2");
+        default: break;
+    }
+#endif
+    return variant->isa == PIXEL_ISA_C;
+}
+
+struct pixel_variant const* pixel_variants(void) {
+    static struct pixel_variant const all[] = {
+        {"avx2",  PIXEL_ISA_AVX2,  {rgba_avx2, gray_avx2, planar_avx2}},
+        {"ssse3", PIXEL_ISA_SSSE3, {rgba_ssse3, gray_ssse3, planar_ssse3}},
+        {"c",     PIXEL_ISA_C,     {rgba_scalar, gray_scalar, planar_scalar}},
+        {NULL,    PIXEL_ISA_C,     {NULL, NULL, NULL}}
+    };
+    return all;
+}
+
+struct pixel_variant const* pixel_best(void) {
+    struct pixel_variant const* v;
+
+    for( v = pixel_variants(); v->name != NULL; v++ )
+        if (pixel_supported(v))
+            return v;
+    return v - 1;
+}
+
+
+struct convert_job {
+    pixel_row* row;
+    unsigned char const* src;
+    size_t src_stride;
+    size_t width;
+    struct pixel_image const* dst;
+};
+
+static void convert_rows(void* ctx, size_t begin, size_t end) {
+    struct convert_job const* job = ctx;
+    unsigned char* planes[3];
+    size_t y;
+
+    for( y = begin; y < end; y++ ) {
+        union pixel const* src = (union pixel const*)(job->src + y * job->src_stride);
+        size_t at = y * job->dst->stride;
+
+        planes[0] = job->dst->planes[0] + at;
+        planes[1] = job->dst->planes[1] != NULL ? job->dst->planes[1] + at : NULL;
+        planes[2] = job->dst->planes[2] != NULL ? job->dst->planes[2] + at : NULL;
+        job->row(src, planes, job->width);
+    }
+}
+
+void pixel_convert(
+    struct tasks* tasks, struct pixel_variant const* variant,
+    union pixel const* src, size_t src_stride, size_t width, size_t height,
+    struct pixel_image const* dst
+) {
+    struct convert_job job;
+
+    if (variant == NULL)
+        variant = pixel_best();
+    job.row = variant->row[dst->format];
+    job.src = src->at;
+    job.src_stride = src_stride;
+    job.width = width;
+    job.dst = dst;
+    if (tasks == NULL || width * height < PIXEL_PARALLEL_MIN)
+        convert_rows(&job, 0, height);
+    else
+        parallel_for(tasks, 0, height, 0, convert_rows, &job);
+}
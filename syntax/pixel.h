@@ -0,0 +1,86 @@
+/*
+ * Conversions of packed 3-byte RGB pixels (union pixel of
+ * data_unions in c_synt.c) to:
+ *   PIXEL_RGBA32   4 bytes per pixel, alpha 255
+ *   PIXEL_GRAY8    (77 r + 150 g + 29 b + 128) >> 8, BT.601
+ *                  weights in 8-bit fixed point
+ *   PIXEL_PLANAR8  r, g and b in three separate planes
+ *
+ * Kernels convert one row. SIMD ones move 16 (SSSE3) or 32
+ * (AVX2) pixels at once with byte shuffles and leave the tail
+ * to the scalar kernel; every kernel gives the same bytes as
+ * the scalar one (integer arithmetic only).
+ *
+ * pixel_convert runs a kernel over the rows of an image, rows
+ * spread over workers of a tasks.h scheduler for big images.
+ */
+#ifndef PIXEL_H
+#define PIXEL_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include "tasks.h"
+/* for: struct tasks, parallel_for */
+
+/* same views as in data_unions, bytes unsigned */
+union pixel {
+    struct {
+        unsigned char a, b, c;  /* r, g, b */
+    } named;
+    unsigned char at[3];
+};
+
+enum pixel_format {
+    PIXEL_RGBA32,
+    PIXEL_GRAY8,
+    PIXEL_PLANAR8,
+    PIXEL_FORMATS
+};
+
+/* images smaller than this (pixels) are converted by one thread */
+#define PIXEL_PARALLEL_MIN ((size_t)1 << 16)
+
+/* converts n pixels of a row, dst[0] (and dst[1], dst[2] if planar) */
+typedef void (pixel_row)(union pixel const* src, unsigned char* const dst[3], size_t n);
+
+/* instruction set a kernel needs */
+enum pixel_isa {
+    PIXEL_ISA_C,
+    PIXEL_ISA_SSSE3,
+    PIXEL_ISA_AVX2
+};
+struct pixel_variant {
+    char const* name;
+    enum pixel_isa isa;
+    pixel_row* row[PIXEL_FORMATS];
+};
+/*
+ * All kernels in order of preference, NULL name terminated.
+ * Before calling a kernel check it with pixel_supported.
+ */
+struct pixel_variant const* pixel_variants(void);
+bool pixel_supported(struct pixel_variant const* variant);
+/* Best variant supported by running CPU (by CPUID). */
+struct pixel_variant const* pixel_best(void);
+
+/* destination image */
+struct pixel_image {
+    enum pixel_format format;
+    unsigned char* planes[3];   /* r, g, b planes, or planes[0] and NULLs */
+    size_t stride;              /* bytes between rows, every plane */
+};
+
+/*
+ * Converts width x height pixels, rows src_stride bytes apart,
+ * with variant (NULL -> pixel_best). With tasks (may be NULL)
+ * images of PIXEL_PARALLEL_MIN pixels or more are split by
+ * rows between its workers.
+ */
+void pixel_convert(
+    struct tasks* tasks, struct pixel_variant const* variant,
+    union pixel const* src, size_t src_stride, size_t width, size_t height,
+    struct pixel_image const* dst);
+
+#endif /* PIXEL_H */
@@ -1,10 +1,22 @@
-/* $ gcc -o polymorphisms -pedantic-errors -Werror polymorphisms.c */
+/* $ gcc -o polymorphisms -std=c11 -pedantic-errors -Werror polymorphisms.c arena.c fmt.c */
 /* run with: */
 /* ./polymorphisms */
 
 
 #include<stdio.h>
 #include <stdbool.h>
+#include "pairs.h"
+/* for: pairs(T), DEFINE_PAIRS(T), DEFINE_PAIRS_PREDICATE(T, P) */
+#include "vec.h"
+/* for: vec(T), DEFINE_VEC(T) */
+#include "arena.h"
+/* for: arena_allocator */
+#include "object.h"
+/* for: struct parent, struct child, struct parent_vtable */
+#include "fmt.h"
+/* for: fmt_int, fmt_double, fmt_hex, FMT_BUFFER_SIZE */
+#include "soa.h"
+/* for: soa(NAME), DEFINE_SOA(NAME, FIELDS) */
 
 /* *********************************** */
 /* Parametric Polymorphism */
@@ -77,6 +89,22 @@ bool any(T)(struct pair(T) pair, bool (*predicate)(T)) {\
 DEFINE_PAIR(int)
 bool is_positive( int x ) { return x > 0; }
 
+/* Batch any/all/count with predicate inlined (see pairs.h) */
+DEFINE_PAIRS(int)
+DEFINE_PAIRS_PREDICATE(int, is_positive)
+
+/* Same pattern, growable array of T (see vec.h) */
+DEFINE_VEC(int)
+bool keep_positive( int const* x, void* ctx ) { return *x > 0; }
+
+/* 
+ * One field list gives struct particle (record), struct
+ * particle_soa (column per field) and conversions (soa.h).
+ */
+#define PARTICLE_FIELDS(F, S) \
+    F(S, float, x) F(S, float, y) F(S, float, mass) F(S, int, id)
+DEFINE_SOA(particle, PARTICLE_FIELDS)
+
 
 void parametric_polymorphism(void) {
     puts(res(mystr));
@@ -87,6 +115,47 @@ void parametric_polymorphism(void) {
     obj.snd = -1;
     printf("%d\n", any(int)(obj, is_positive) );
 
+    /* same question for a batch of pairs, stored as two arrays */
+    struct pair(int) objs[3] = {{1, -1}, {-2, -3}, {4, 5}};
+    int fsts[3], snds[3];
+    struct pairs(int) batch = {fsts, snds, 0};
+    pairs_int_scatter(&batch, objs, 3);
+    printf(
+        "any mask %#llx, all mask %#llx, any count %zu\n",
+        (unsigned long long)pairs_int_is_positive_any(&batch, 0),
+        (unsigned long long)pairs_int_is_positive_all(&batch, 0),
+        pairs_int_is_positive_count_any(&batch)
+    );
+
+    /* vector in an arena over stack buffer, no malloc at all */
+    char buffer[1024];
+    struct arena arena;
+    struct vec(int) v;
+    int const more[] = {-3, 4, -5};
+    int i;
+    arena_init_buffer(&arena, buffer, sizeof(buffer));
+    vec_int_init(&v, arena_allocator(&arena));
+    for( i = -10; i < 10; i++ )
+        vec_int_push(&v, i);
+    vec_int_append(&v, more, 3);
+    vec_int_filter(&v, keep_positive, NULL);
+    printf("%zu positive, last %d\n", v.size, v.data[v.size - 1]);
+    vec_int_free(&v);
+
+    /* records to columns, scan of one column, and back */
+    struct particle records[4] = {
+        {0, 0, 1.5f, 1}, {1, 0, 2.5f, 2}, {0, 1, 0.5f, 3}, {1, 1, 4.0f, 4}};
+    soa(particle) columns;
+    float mass = 0;
+    if (particle_soa_init(&columns, 4)) {
+        particle_soa_from_aos(&columns, records, 4);
+        for( i = 0; i < (int)columns.size; i++ )
+            mass += columns.mass[i];
+        particle_soa_to_aos(&columns, records);
+        printf("total mass %g, last id %d\n", mass, records[3].id);
+        particle_soa_free(&columns);
+    }
+
     return ;
 }
 
@@ -101,23 +170,31 @@ void parametric_polymorphism(void) {
  * and pointer casts (or void*).
  */
 
-struct parent {
-    const char* field_parent;
-};
-struct child {
-    struct parent base;
-    const char* field_child;
-};
+/* 
+ * struct parent and struct child are defined in object.h,
+ * parent begins with pointer to table of virtual methods
+ * (vtable) of the concrete type.
+ */
 void parent_print( struct parent* this ) {
     printf( "%s\n", this->field_parent );
 }
 
+/* virtual print of child, "overrides" parent_print */
+void child_print( struct parent const* this ) {
+    struct child const* c = (struct child const*) this;
+    printf( "%s, %s\n", c->base.field_parent, c->field_child );
+}
+struct parent_vtable const child_vtable = {"child", 0, child_print, NULL, NULL};
+
 
 void inclusion_polymorphism(void) {
     struct child c;
+    c.base.vtable = &child_vtable;
     c.base.field_parent = "parent";
     c.field_child = "child";
     parent_print( (struct parent*) &c );
+    /* virtual call, resolved by object at run time */
+    c.base.vtable->print( &c.base );
 
     return ;
 }
@@ -149,13 +226,29 @@ void inclusion_polymorphism(void) {
             int: "%d",\
             double: "%f",\
             default: "%x"))
-#define print(x) printf( print_fmt(x), x ); puts("");
+#define print_printf(x) printf( print_fmt(x), x ); puts("");
+/* 
+ * Same dispatch selecting a formatter (see fmt.h) instead of
+ * a format string, which is locale-free and much faster than
+ * printf. Doubles are printed shortest, 42.42 rather than
+ * 42.420000.
+ */
+#define print_formatter(x) (_Generic( (x), \
+            int: fmt_int,\
+            double: fmt_double,\
+            default: fmt_hex))
+#define print(x) { \
+            char print_buffer[FMT_BUFFER_SIZE]; \
+            print_formatter(x)(print_buffer, x); \
+            puts(print_buffer); }
 
 void overloading_polymorphism(void) {
     int x = 101;
     double y = 42.42;
     print(x);
     print(y);
+    print_printf(x);
+    print_printf(y);
 
     return;
 }
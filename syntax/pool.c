@@ -0,0 +1,137 @@
+/*
+ * Pool declared in pool.h.
+ *
+ * First slot of every slab links the slabs (for pool_free),
+ * the other slots are objects. A new slab gives POOL_BATCH
+ * objects to the cache which asked, the rest go to the shared
+ * free list, so other threads can use them too.
+ */
+
+#include "pool.h"
+#include <stdlib.h>
+/* for: aligned_alloc, free */
+
+bool pool_init(struct pool* pool, size_t size, size_t align) {
+    if (align < alignof(struct pool_node))
+        align = alignof(struct pool_node);
+    if (size < sizeof(struct pool_node))
+        size = sizeof(struct pool_node);
+    pool->align = align;
+    pool->size = (size + align - 1) / align * align;
+    pool->slab_size = POOL_SLAB_SIZE / pool->size;
+    if (pool->slab_size < POOL_BATCH + 1)
+        pool->slab_size = POOL_BATCH + 1;
+    pool->slab_size *= pool->size;
+    pool->free = NULL;
+    pool->slabs = NULL;
+    pool->slab_count = 0;
+    return mtx_init(&pool->lock, mtx_plain) == thrd_success;
+}
+
+void pool_free(struct pool* pool) {
+    while (pool->slabs != NULL) {
+        struct pool_node* next = pool->slabs->next;
+
+        free(pool->slabs);
+        pool->slabs = next;
+    }
+    pool->free = NULL;
+    pool->slab_count = 0;
+    mtx_destroy(&pool->lock);
+}
+
+size_t pool_reserved(struct pool* pool) {
+    size_t bytes;
+
+    mtx_lock(&pool->lock);
+    bytes = pool->slab_count * pool->slab_size;
+    mtx_unlock(&pool->lock);
+    return bytes;
+}
+
+void pool_cache_init(struct pool_cache* cache, struct pool* pool) {
+    cache->pool = pool;
+    cache->free = NULL;
+    cache->count = 0;
+}
+
+/* links objects of new slab, first POOL_BATCH to cache */
+static bool add_slab(struct pool* pool, struct pool_cache* cache) {
+    char* slab = aligned_alloc(pool->align, pool->slab_size);
+    size_t at;
+
+    if (slab == NULL)
+        return false;
+    ((struct pool_node*)slab)->next = pool->slabs;
+    pool->slabs = (struct pool_node*)slab;
+    pool->slab_count++;
+
+    /* backwards, so objects are handed out in address order */
+    for( at = pool->slab_size - pool->size; at > 0; at -= pool->size ) {
+        struct pool_node* node = (struct pool_node*)(slab + at);
+
+        if (at > POOL_BATCH * pool->size) {
+            node->next = pool->free;
+            pool->free = node;
+        } else {
+            node->next = cache->free;
+            cache->free = node;
+            cache->count++;
+        }
+    }
+    return true;
+}
+
+void* pool_refill(struct pool_cache* cache) {
+    struct pool* pool = cache->pool;
+    size_t moved;
+
+    mtx_lock(&pool->lock);
+    for( moved = 0; moved < POOL_BATCH && pool->free != NULL; moved++ ) {
+        struct pool_node* node = pool->free;
+
+        pool->free = node->next;
+        node->next = cache->free;
+        cache->free = node;
+    }
+    cache->count += moved;
+    if (moved == 0 && !add_slab(pool, cache)) {
+        mtx_unlock(&pool->lock);
+        return NULL;
+    }
+    mtx_unlock(&pool->lock);
+    return pool_get(cache);
+}
+
+/* moves list of objects from first to last to pool */
+static void give_back(struct pool* pool, struct pool_node* first, struct pool_node* last) {
+    mtx_lock(&pool->lock);
+    last->next = pool->free;
+    pool->free = first;
+    mtx_unlock(&pool->lock);
+}
+
+void pool_drain(struct pool_cache* cache) {
+    struct pool_node* first = cache->free;
+    struct pool_node* last = first;
+    size_t i;
+
+    /* list is walked before lock is taken */
+    for( i = 1; i < POOL_BATCH; i++ )
+        last = last->next;
+    cache->free = last->next;
+    cache->count -= POOL_BATCH;
+    give_back(cache->pool, first, last);
+}
+
+void pool_cache_flush(struct pool_cache* cache) {
+    struct pool_node* last = cache->free;
+
+    if (last == NULL)
+        return;
+    while (last->next != NULL)
+        last = last->next;
+    give_back(cache->pool, cache->free, last);
+    cache->free = NULL;
+    cache->count = 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Pool of fixed-size objects, honoring any alignment.
+ *
+ * Objects are carved from big slabs taken with aligned_alloc,
+ * so over-aligned types (struct data of alignment.h, aligned
+ * to 128) come out aligned, unlike from malloc.
+ *
+ * Every thread gets and puts objects through its own struct
+ * pool_cache, a free list touched without locks. Only when it
+ * runs empty (or holds too many) POOL_BATCH objects move
+ * between it and the shared list of the pool, under lock.
+ * Objects may be put back by another thread than the one
+ * which got them.
+ */
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include <stdalign.h>
+/* for: alignof */
+#include <threads.h>
+/* for: mtx_t */
+
+/* objects moved at once between a cache and pool */
+#define POOL_BATCH 32
+#define POOL_SLAB_SIZE ((size_t)64 << 10)
+
+/* free object is a list node */
+struct pool_node {
+    struct pool_node* next;
+};
+
+struct pool {
+    size_t size;                /* object stride, multiple of align */
+    size_t align;
+    size_t slab_size;
+    mtx_t lock;                 /* guards fields below */
+    struct pool_node* free;     /* objects given back by caches */
+    struct pool_node* slabs;    /* first slot of every slab */
+    size_t slab_count;
+};
+
+struct pool_cache {
+    struct pool* pool;
+    struct pool_node* free;
+    size_t count;
+};
+
+/*
+ * Pool of objects of size bytes aligned to align (power of
+ * two), false if out of memory for lock.
+ */
+bool pool_init(struct pool* pool, size_t size, size_t align);
+#define pool_init_type(pool, T) pool_init((pool), sizeof(T), alignof(T))
+/* Frees all objects at once, caches must be flushed or unused. */
+void pool_free(struct pool* pool);
+/* bytes taken from malloc */
+size_t pool_reserved(struct pool* pool);
+
+void pool_cache_init(struct pool_cache* cache, struct pool* pool);
+/* Gives all cached objects back to pool (e.g. at thread exit). */
+void pool_cache_flush(struct pool_cache* cache);
+
+/* slow paths of pool_get and pool_put */
+void* pool_refill(struct pool_cache* cache);
+void pool_drain(struct pool_cache* cache);
+
+/* NULL when out of memory. */
+static inline void* pool_get(struct pool_cache* cache) {
+    struct pool_node* node = cache->free;
+
+    if (node == NULL)
+        return pool_refill(cache);
+    cache->free = node->next;
+    cache->count--;
+    return node;
+}
+
+static inline void pool_put(struct pool_cache* cache, void* object) {
+    struct pool_node* node = object;
+
+    node->next = cache->free;
+    cache->free = node;
+    if (++cache->count > 2 * POOL_BATCH)
+        pool_drain(cache);
+}
+
+#endif /* POOL_H */
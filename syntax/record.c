@@ -0,0 +1,245 @@
+/*
+ * Record files declared in record.h.
+ *
+ * Header and schema are copied out of the mapping (they are
+ * read once), records are not: accessors read the mapping.
+ */
+
+/* for mmap, madvise */
+#define _DEFAULT_SOURCE
+
+#include "record.h"
+#include <stdio.h>
+/* for: fopen, fwrite, snprintf */
+#include <string.h>
+/* for: memcpy, memcmp, memset, strlen, strncmp */
+#include <fcntl.h>
+/* for: open */
+#include <sys/mman.h>
+/* for: mmap, munmap, madvise */
+#include <sys/stat.h>
+/* for: fstat */
+#include <unistd.h>
+/* for: close */
+
+/* on disk, in byte order of the writer */
+struct record_header {
+    char magic[8];
+    uint32_t byte_order;        /* RECORD_BYTE_ORDER */
+    uint32_t version;
+    uint32_t size;              /* of one record */
+    uint32_t field_count;
+    uint64_t count;             /* of records */
+    uint64_t data_offset;       /* multiple of RECORD_ALIGN */
+    char name[RECORD_NAME_SIZE];
+};
+
+struct record_header_field {
+    char name[RECORD_NAME_SIZE];
+    uint32_t offset;
+    uint32_t size;
+};
+
+static void swap_header(struct record_header* header) {
+    record_swap(&header->version, sizeof header->version);
+    record_swap(&header->size, sizeof header->size);
+    record_swap(&header->field_count, sizeof header->field_count);
+    record_swap(&header->count, sizeof header->count);
+    record_swap(&header->data_offset, sizeof header->data_offset);
+}
+
+/* name cut to RECORD_NAME_SIZE, rest of dst stays zero */
+static void copy_name(char* dst, char const* src) {
+    size_t length = strlen(src);
+
+    memcpy(dst, src, length < RECORD_NAME_SIZE ? length : RECORD_NAME_SIZE);
+}
+
+static uint64_t data_offset(uint32_t field_count) {
+    uint64_t end = sizeof(struct record_header)
+                 + (uint64_t)field_count * sizeof(struct record_header_field);
+
+    return (end + RECORD_ALIGN - 1) / RECORD_ALIGN * RECORD_ALIGN;
+}
+
+/* header and schema of mapped file against compiled schema */
+static int check(struct record_file* file, struct record_schema const* schema) {
+    unsigned char const* map = file->map;
+    struct record_header header;
+    struct record_header_field field;
+    uint32_t i;
+
+    if (file->map_size < sizeof header) {
+        snprintf(file->error, sizeof file->error, "file too short for header");
+        return -1;
+    }
+    memcpy(&header, map, sizeof header);
+    if (memcmp(header.magic, RECORD_MAGIC, sizeof header.magic) != 0) {
+        snprintf(file->error, sizeof file->error, "not a record file");
+        return -1;
+    }
+    if (header.byte_order == RECORD_BYTE_ORDER)
+        file->swap = false;
+    else {
+        record_swap(&header.byte_order, sizeof header.byte_order);
+        if (header.byte_order != RECORD_BYTE_ORDER) {
+            snprintf(file->error, sizeof file->error, "unknown byte order");
+            return -1;
+        }
+        file->swap = true;
+        swap_header(&header);
+    }
+
+    if (strncmp(header.name, schema->name, sizeof header.name) != 0
+            || header.version != schema->version) {
+        snprintf(file->error, sizeof file->error, "records %.32s version %u, expected %s version %u",
+                 header.name, (unsigned)header.version, schema->name, (unsigned)schema->version);
+        return -1;
+    }
+    if (header.size != schema->size || header.field_count != schema->count
+            || header.data_offset < data_offset(header.field_count)
+            || header.data_offset > file->map_size) {
+        snprintf(file->error, sizeof file->error, "layout of %s differs", schema->name);
+        return -1;
+    }
+    for( i = 0; i < header.field_count; i++ ) {
+        memcpy(&field, map + sizeof header + i * sizeof field, sizeof field);
+        if (file->swap) {
+            record_swap(&field.offset, sizeof field.offset);
+            record_swap(&field.size, sizeof field.size);
+        }
+        if (strncmp(field.name, schema->fields[i].name, sizeof field.name) != 0
+                || field.offset != schema->fields[i].offset
+                || field.size != schema->fields[i].size) {
+            snprintf(file->error, sizeof file->error, "field %u of %s differs: %.32s",
+                     (unsigned)i, schema->name, field.name);
+            return -1;
+        }
+    }
+
+    if (header.count > (file->map_size - header.data_offset) / header.size
+            || header.data_offset + header.count * header.size != file->map_size) {
+        snprintf(file->error, sizeof file->error, "file length does not match %llu records",
+                 (unsigned long long)header.count);
+        return -1;
+    }
+    file->records = map + header.data_offset;
+    if ((uintptr_t)file->records % schema->align != 0) {
+        snprintf(file->error, sizeof file->error, "records not aligned to %u",
+                 (unsigned)schema->align);
+        return -1;
+    }
+    file->count = (size_t)header.count;
+    file->size = header.size;
+    return 0;
+}
+
+uint64_t record_data_offset(struct record_schema const* schema) {
+    return data_offset(schema->count);
+}
+
+int record_open(struct record_file* file, char const* path,
+                struct record_schema const* schema) {
+    struct stat st;
+    int fd;
+
+    file->map = NULL;
+    file->map_size = 0;
+    file->records = NULL;
+    file->count = 0;
+    file->error[0] = '\0';
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        snprintf(file->error, sizeof file->error, "can not open %s", path);
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        snprintf(file->error, sizeof file->error, "%s is empty or not a file", path);
+        close(fd);
+        return -1;
+    }
+    file->map_size = (size_t)st.st_size;
+    file->map = mmap(NULL, file->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    /* mapping stays valid after close */
+    close(fd);
+    if (file->map == MAP_FAILED) {
+        file->map = NULL;
+        snprintf(file->error, sizeof file->error, "can not map %s", path);
+        return -1;
+    }
+    if (check(file, schema) != 0) {
+        record_close(file);
+        return -1;
+    }
+    madvise(file->map, file->map_size, MADV_SEQUENTIAL);
+    return 0;
+}
+
+void record_close(struct record_file* file) {
+    if (file->map != NULL)
+        munmap(file->map, file->map_size);
+    file->map = NULL;
+    file->records = NULL;
+    file->count = 0;
+}
+
+int record_write(char const* path, struct record_schema const* schema,
+                 void const* records, size_t count, bool swapped) {
+    static unsigned char const zeros[RECORD_ALIGN];
+    unsigned char buffer[4096];
+    struct record_header header;
+    struct record_header_field field;
+    unsigned char const* record = records;
+    uint64_t written;
+    size_t i, j;
+    FILE* out;
+    int ok;
+
+    if (schema->size > sizeof buffer)
+        return -1;
+    memset(&header, 0, sizeof header);
+    memcpy(header.magic, RECORD_MAGIC, sizeof header.magic);
+    copy_name(header.name, schema->name);
+    header.byte_order = RECORD_BYTE_ORDER;
+    header.version = schema->version;
+    header.size = schema->size;
+    header.field_count = schema->count;
+    header.count = count;
+    header.data_offset = data_offset(schema->count);
+    if (swapped) {
+        record_swap(&header.byte_order, sizeof header.byte_order);
+        swap_header(&header);
+    }
+
+    out = fopen(path, "wb");
+    if (out == NULL)
+        return -1;
+    ok = fwrite(&header, sizeof header, 1, out) == 1;
+    written = sizeof header;
+    for( i = 0; ok && i < schema->count; i++ ) {
+        memset(&field, 0, sizeof field);
+        copy_name(field.name, schema->fields[i].name);
+        field.offset = schema->fields[i].offset;
+        field.size = schema->fields[i].size;
+        if (swapped) {
+            record_swap(&field.offset, sizeof field.offset);
+            record_swap(&field.size, sizeof field.size);
+        }
+        ok = fwrite(&field, sizeof field, 1, out) == 1;
+        written += sizeof field;
+    }
+    if (ok && written < data_offset(schema->count))
+        ok = fwrite(zeros, (size_t)(data_offset(schema->count) - written), 1, out) == 1;
+
+    if (!swapped)
+        ok = ok && (count == 0 || fwrite(records, schema->size, count, out) == count);
+    for( i = 0; swapped && ok && i < count; i++, record += schema->size ) {
+        memcpy(buffer, record, schema->size);
+        for( j = 0; j < schema->count; j++ )
+            record_swap(buffer + schema->fields[j].offset, schema->fields[j].size);
+        ok = fwrite(buffer, schema->size, 1, out) == 1;
+    }
+    if (fclose(out) != 0)
+        ok = 0;
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,172 @@
+/*
+ * Binary record files read in place from mmap, the union
+ * views of data_unions (c_synt.c) made a file format.
+ *
+ * A record type is listed once, F(S, type, name) as in
+ * layout.h, with fixed width types:
+ *
+ *   #define TRADE_FIELDS(F, S) \
+ *       F(S, uint64_t, time) F(S, int32_t, qty) F(S, double, price)
+ *   DEFINE_RECORD(trade, 1, TRADE_FIELDS)
+ *
+ * gives:
+ *   struct trade              the record
+ *   union trade_view          record and its raw bytes, one
+ *                             mapped slot of the file
+ *   trade_schema              name, version, size, fields
+ *   trade_time(file, i) ...   typed accessor of every field
+ *   trade_get(file, i)        whole record, by value
+ *   trade_at(file, i)         pointer into the mapping (zero
+ *                             copy), NULL if bytes need a swap
+ *
+ * File: header (magic, byte order mark, version, record size,
+ * count, offset of records), schema (name, offset and size of
+ * every field), then records at a 64-byte aligned offset, all
+ * in byte order of the writer. record_open checks file against
+ * compiled schema (version, sizes, offsets, names, length)
+ * and that records are aligned for their type, so accessors
+ * read mapped memory directly. A file of other byte order is
+ * accepted too: then accessors swap each value they return,
+ * nothing is converted up front and native files pay one
+ * predictable branch.
+ */
+#ifndef RECORD_H
+#define RECORD_H
+
+#include <stddef.h>
+/* for: size_t, offsetof */
+#include <stdbool.h>
+/* for: bool */
+#include <stdint.h>
+/* for: uint32_t, uint64_t, int32_t ... */
+#include <stdalign.h>
+/* for: alignof */
+#include <string.h>
+/* for: memcpy */
+
+#define RECORD_MAGIC "CRECORD"
+#define RECORD_BYTE_ORDER 0x01020304u
+#define RECORD_NAME_SIZE 32
+#define RECORD_ALIGN 64
+
+struct record_field {
+    char const* name;
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct record_schema {
+    char const* name;
+    uint32_t version;
+    uint32_t size;
+    uint32_t align;
+    struct record_field const* fields;
+    uint32_t count;
+};
+
+struct record_file {
+    void* map;
+    size_t map_size;
+    unsigned char const* records;
+    size_t count;
+    size_t size;            /* of one record */
+    bool swap;              /* file of other byte order */
+    char error[128];
+};
+
+/*
+ * Maps file at path and checks it against schema. 0, or -1
+ * with reason in file->error.
+ */
+int record_open(struct record_file* file, char const* path,
+                struct record_schema const* schema);
+void record_close(struct record_file* file);
+/*
+ * Writes count records in host byte order, or swapped to the
+ * other one (files of big-endian writers, tests). 0 or -1.
+ */
+int record_write(char const* path, struct record_schema const* schema,
+                 void const* records, size_t count, bool swapped);
+
+/* where records start in files of schema (header size) */
+uint64_t record_data_offset(struct record_schema const* schema);
+
+/* reverses bytes of a value, size 1, 2, 4 or 8 */
+static inline void record_swap(void* value, size_t size) {
+    unsigned char* bytes = value;
+    size_t i;
+
+#if defined(__GNUC__)
+    /* one instruction each (the loop is not always matched) */
+    if (size == 8) {
+        uint64_t word;
+
+        memcpy(&word, value, 8);
+        word = __builtin_bswap64(word);
+        memcpy(value, &word, 8);
+        return;
+    }
+    if (size == 4) {
+        uint32_t word;
+
+        memcpy(&word, value, 4);
+        word = __builtin_bswap32(word);
+        memcpy(value, &word, 4);
+        return;
+    }
+#endif
+    for( i = 0; i < size / 2; i++ ) {
+        unsigned char byte = bytes[i];
+
+        bytes[i] = bytes[size - 1 - i];
+        bytes[size - 1 - i] = byte;
+    }
+}
+
+#define RECORD_MEMBER(S, T, N) T N;
+#define RECORD_FIELD(S, T, N) \
+    {#N, (uint32_t)offsetof(struct S, N), (uint32_t)sizeof(T)},
+#define RECORD_COUNT(S, T, N) + 1
+#define RECORD_SWAP(S, T, N) record_swap(&record.N, sizeof(T));
+#define RECORD_ACCESSOR(S, T, N) \
+    static inline T S##_##N(struct record_file const* file, size_t i) { \
+        union S##_view const* view = (union S##_view const*)file->records + i; \
+        T value = view->record.N; \
+        \
+        if (file->swap) \
+            record_swap(&value, sizeof(T)); \
+        return value; \
+    }
+
+#define DEFINE_RECORD(NAME, VERSION, FIELDS) \
+    struct NAME { FIELDS(RECORD_MEMBER, NAME) }; \
+    \
+    union NAME##_view { \
+        struct NAME record; \
+        unsigned char bytes[sizeof(struct NAME)]; \
+    }; \
+    \
+    static struct record_field const NAME##_fields[] = { \
+        FIELDS(RECORD_FIELD, NAME) \
+    }; \
+    static struct record_schema const NAME##_schema = { \
+        #NAME, VERSION, sizeof(struct NAME), alignof(struct NAME), \
+        NAME##_fields, 0 FIELDS(RECORD_COUNT, NAME) \
+    }; \
+    \
+    FIELDS(RECORD_ACCESSOR, NAME) \
+    \
+    static inline struct NAME NAME##_get(struct record_file const* file, size_t i) { \
+        struct NAME record = ((union NAME##_view const*)file->records)[i].record; \
+        \
+        if (file->swap) { \
+            FIELDS(RECORD_SWAP, NAME) \
+        } \
+        return record; \
+    } \
+    \
+    static inline struct NAME const* NAME##_at(struct record_file const* file, size_t i) { \
+        return file->swap ? NULL : &((union NAME##_view const*)file->records)[i].record; \
+    }
+
+#endif /* RECORD_H */
@@ -0,0 +1,279 @@
+/* 
+ * Scans declared in scan.h.
+ *
+ * Scans run block by block. Bounds of block prefix sums come
+ * from array_sum_summarize; when they fit in int with the
+ * running sum, the block is scanned in registers with plain
+ * (wrapping) 32-bit adds, which can not overflow there.
+ * Otherwise block is scanned element by element with checks.
+ */
+
+/* for sysconf */
+#define _POSIX_C_SOURCE 200809L
+
+#include "scan.h"
+#include "array_sum.h"
+/* for: array_sum_summarize, array_sum_acc_summary */
+#include <limits.h>
+/* for: INT_MAX, INT_MIN */
+#include <stdlib.h>
+/* for: malloc, free */
+#include <threads.h>
+/* for: thrd_create, thrd_join */
+#include <unistd.h>
+/* for: sysconf */
+
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
+#define SCAN_BLOCK 1024
+/* below this many elements per thread, threads cost more than they save */
+#define SCAN_MIN_CHUNK (64 * 1024)
+/* segments at least this long go to SIMD array_sum kernel */
+#define SCAN_LONG_SEGMENT 256
+
+
+/* Checked scan, element by element, same checks as array_sum. */
+static bool scan_checked(
+    int const* in, int* out, size_t n, int* sum, bool exclusive
+) {
+    size_t i;
+    int s = *sum;
+
+    for( i = 0; i < n; i++ ) {
+        int x = in[i];
+
+        if (
+            (x > 0 && s > INT_MAX - x) ||
+            (x < 0 && s < INT_MIN - x)
+        )
+            return false; /* overflow or underflow */
+        out[i] = exclusive ? s : s + x;
+        s = s + x;
+    }
+    *sum = s;
+    return true;
+}
+
+/* 
+ * Scan of a block known not to overflow, starting at sum.
+ * SSE2: log2(4) shift-and-add steps per 4 elements, then
+ * the running sum is broadcast from the last lane.
+ */
+static int scan_unchecked(
+    int const* in, int* out, size_t n, int sum, bool exclusive
+) {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    __m128i carry = _mm_set1_epi32(sum);
+
+    for( ; i + 4 <= n; i += 4 ) {
+        __m128i v = _mm_loadu_si128((__m128i const*)(in + i));
+        __m128i x = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+        carry = _mm_shuffle_epi32(x, 0xFF);
+        _mm_storeu_si128((__m128i*)(out + i), 
+            exclusive ? _mm_sub_epi32(x, v) : x);
+    }
+    sum = _mm_cvtsi128_si32(carry);
+#endif
+    for( ; i < n; i++ ) {
+        int x = in[i];
+
+        out[i] = exclusive ? sum : sum + x;
+        sum = sum + x;
+    }
+    return sum;
+}
+
+static bool scan_acc(
+    int const* in, int* out, size_t count, int* sum, bool exclusive
+) {
+    size_t i, n;
+
+    for( i = 0; i < count; i += n ) {
+        struct array_sum_summary bounds;
+        int64_t s = *sum;
+
+        n = count - i < SCAN_BLOCK ? count - i : SCAN_BLOCK;
+        array_sum_summarize(in + i, n, &bounds);
+
+        if (!bounds.overflows
+                && s + bounds.high <= INT_MAX && s + bounds.low >= INT_MIN)
+            *sum = scan_unchecked(in + i, out + i, n, *sum, exclusive);
+        else if (!scan_checked(in + i, out + i, n, sum, exclusive))
+            return false;
+    }
+    return true;
+}
+
+static int scan(int const* in, int* out, size_t count, bool exclusive) {
+    int sum = 0;
+
+    if (in == NULL || (out == NULL && count > 0))
+        return -1; /* wrong (null) array pointer */
+    if (!scan_acc(in, out, count, &sum, exclusive))
+        return -1; /* overflow or underflow */
+    return sum;
+}
+
+int scan_inclusive(int const* in, int* out, size_t count) {
+    return scan(in, out, count, false);
+}
+
+int scan_exclusive(int const* in, int* out, size_t count) {
+    return scan(in, out, count, true);
+}
+
+
+struct scan_chunk {
+    int const* in;
+    int* out;
+    size_t count;
+    struct array_sum_summary summary;
+    int offset;     /* sum of elements before chunk */
+    bool exclusive;
+};
+
+static int summarize_chunk(void* arg) {
+    struct scan_chunk* c = arg;
+
+    array_sum_summarize(c->in, c->count, &c->summary);
+    return 0;
+}
+
+static int scan_chunk(void* arg) {
+    struct scan_chunk* c = arg;
+    int sum = c->offset;
+
+    /* whole array was checked by the reduce pass, can not fail */
+    scan_acc(c->in, c->out, c->count, &sum, c->exclusive);
+    return 0;
+}
+
+/* Runs fn over every chunk, calling thread takes chunk 0. */
+static void run_chunks(
+    thrd_start_t fn, struct scan_chunk* chunks, thrd_t* ids, size_t threads
+) {
+    size_t i, started;
+
+    /* failed starts run inline */
+    for( started = 1; started < threads; started++ )
+        if (thrd_create(&ids[started], fn, &chunks[started]) != thrd_success)
+            break;
+    fn(&chunks[0]);
+    for( i = started; i < threads; i++ )
+        fn(&chunks[i]);
+    for( i = 1; i < started; i++ )
+        thrd_join(ids[i], NULL);
+}
+
+static int scan_parallel(
+    int const* in, int* out, size_t count, unsigned threads, bool exclusive
+) {
+    struct scan_chunk* chunks;
+    thrd_t* ids;
+    size_t i;
+    int sum = 0;
+    bool ok = true;
+
+    if (in == NULL || (out == NULL && count > 0))
+        return -1; /* wrong (null) array pointer */
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned)online : 1;
+    }
+    if (threads > count / SCAN_MIN_CHUNK)
+        threads = (unsigned)(count / SCAN_MIN_CHUNK);
+    if (threads <= 1)
+        return scan(in, out, count, exclusive);
+
+    chunks = malloc(threads * sizeof(*chunks));
+    ids = malloc(threads * sizeof(*ids));
+    if (chunks == NULL || ids == NULL) {
+        free(chunks);
+        free(ids);
+        return scan(in, out, count, exclusive);
+    }
+
+    for( i = 0; i < threads; i++ ) {
+        size_t begin = count / threads * i;
+        size_t end = i + 1 == threads ? count : count / threads * (i + 1);
+
+        chunks[i].in = in + begin;
+        chunks[i].out = out + begin;
+        chunks[i].count = end - begin;
+        chunks[i].exclusive = exclusive;
+    }
+
+    /* pass 1: reduce, offsets merged in order with exact overflow check */
+    run_chunks(summarize_chunk, chunks, ids, threads);
+    for( i = 0; i < threads && ok; i++ ) {
+        chunks[i].offset = sum;
+        ok = array_sum_acc_summary(
+            chunks[i].in, chunks[i].count, &chunks[i].summary, &sum);
+    }
+    /* pass 2: scan */
+    if (ok)
+        run_chunks(scan_chunk, chunks, ids, threads);
+
+    free(chunks);
+    free(ids);
+    return ok ? sum : -1; /* -1 on overflow or underflow */
+}
+
+int scan_inclusive_parallel(int const* in, int* out, size_t count, unsigned threads) {
+    return scan_parallel(in, out, count, threads, false);
+}
+
+int scan_exclusive_parallel(int const* in, int* out, size_t count, unsigned threads) {
+    return scan_parallel(in, out, count, threads, true);
+}
+
+
+/* 
+ * Short segments: 64-bit running sum, flag raised when any
+ * prefix leaves int range. No branches inside the segment
+ * (64-bit sum of < 2^32 ints can not overflow itself).
+ */
+static int segment_sum(int const* in, size_t n) {
+    size_t i;
+    int64_t s = 0;
+    bool out_of_range = false;
+
+    for( i = 0; i < n; i++ ) {
+        s += in[i];
+        out_of_range |= s > INT_MAX || s < INT_MIN;
+    }
+    return out_of_range ? -1 : (int)s;
+}
+
+int scan_segments(
+    int const* in, size_t const* offsets, size_t segments, int* sums
+) {
+    array_sum_kernel* acc = array_sum_acc_best();
+    size_t k;
+
+    if (in == NULL || offsets == NULL || (sums == NULL && segments > 0))
+        return -1; /* wrong (null) array pointer */
+
+    for( k = 0; k < segments; k++ ) {
+        size_t n = offsets[k + 1] - offsets[k];
+
+        if (offsets[k + 1] < offsets[k])
+            return -1; /* offsets out of order */
+        if (n < SCAN_LONG_SEGMENT) {
+            sums[k] = segment_sum(in + offsets[k], n);
+        } else {
+            int sum = 0;
+
+            sums[k] = acc(in + offsets[k], n, &sum) ? sum : -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+/* 
+ * Prefix sums (scans) and segmented sums of int arrays, with
+ * the overflow contract of array_sum (array_sum.h): result is
+ * the total sum, or -1 when array is NULL or some prefix sum
+ * leaves the int range (then out contents are unspecified).
+ * out may be the same array as in (in place scan).
+ */
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stddef.h>
+/* for: size_t */
+
+/* out[i] = in[0] + ... + in[i] */
+int scan_inclusive(int const* in, int* out, size_t count);
+/* out[i] = in[0] + ... + in[i - 1], out[0] = 0 */
+int scan_exclusive(int const* in, int* out, size_t count);
+
+/* 
+ * Two pass (reduce then scan) versions for big arrays:
+ * threads (0 -> one per online CPU) summarize their chunks,
+ * chunk offsets are merged in order, then chunks are scanned
+ * in parallel starting from their offsets.
+ */
+int scan_inclusive_parallel(int const* in, int* out, size_t count, unsigned threads);
+int scan_exclusive_parallel(int const* in, int* out, size_t count, unsigned threads);
+
+/* 
+ * CSR style segments: segment k is in[offsets[k]] up to (not
+ * including) in[offsets[k + 1]], so offsets has segments + 1
+ * nondecreasing entries. sums[k] = array_sum of segment k
+ * (-1 on its overflow). Returns -1 for NULL arguments or
+ * offsets out of order, 0 otherwise.
+ */
+int scan_segments(
+    int const* in, size_t const* offsets, size_t segments, int* sums);
+
+#endif /* SCAN_H */
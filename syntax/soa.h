@@ -0,0 +1,158 @@
+/*
+ * Array of structs and struct of arrays from one field list.
+ *
+ * Fields are listed as in layout.h, F(S, type, name):
+ *
+ *   #define TICK_FIELDS(F, S) \
+ *       F(S, float, price) F(S, int, qty) F(S, int, id)
+ *   DEFINE_SOA(tick, TICK_FIELDS)
+ *
+ * gives:
+ *   struct tick                record (AoS element)
+ *   struct tick_soa            one column per field, size, capacity
+ *   tick_soa_init/free         columns in one block, each on its
+ *                              own cache line
+ *   tick_soa_from_aos/to_aos   bulk conversions
+ *   tick_soa_get/set/push      record i as a struct tick
+ *   tick_soa_for_each_column   visits name, pointer and element
+ *                              size of every column (generic I/O)
+ *
+ * Conversions go in blocks of SOA_BLOCK records, field by
+ * field, so the block stays in cache while every column is
+ * written, and each field loop is a strided copy which the
+ * compiler vectorizes (-O3) with shuffles.
+ *
+ * Scans over one field read only that column: a full cache
+ * line of useful values instead of sizeof(field) bytes of
+ * every sizeof(record).
+ */
+#ifndef SOA_H
+#define SOA_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include <stdint.h>
+/* for: SIZE_MAX */
+#include <stdlib.h>
+/* for: aligned_alloc, free */
+
+#define SOA_BLOCK 256
+#define SOA_ALIGN 64
+#define SOA_FIELDS_MAX 64
+#define SOA_ROUND(bytes) (((bytes) + SOA_ALIGN - 1) / SOA_ALIGN * SOA_ALIGN)
+
+#define soa(NAME) struct NAME##_soa
+
+/* column callback: name, first element, element size */
+typedef void (soa_column_visit)(void* ctx, char const* name, void* column, size_t size);
+
+/* pieces expanded once per field, S is unused */
+#define SOA_MEMBER(S, T, N) T N;
+#define SOA_COLUMN(S, T, N) T* N;
+#define SOA_FITS(S, T, N) && capacity <= SIZE_MAX / 2 / sizeof(T) / SOA_FIELDS_MAX
+#define SOA_BYTES(S, T, N) + SOA_ROUND(capacity * sizeof(T))
+#define SOA_CARVE(S, T, N) \
+    soa->N = (T*)(block + at); \
+    at += SOA_ROUND(capacity * sizeof(T));
+#define SOA_GATHER(S, T, N) \
+    for( i = 0; i < count; i++ ) \
+        soa->N[at + i] = aos[i].N;
+#define SOA_SCATTER(S, T, N) \
+    for( i = 0; i < count; i++ ) \
+        aos[i].N = soa->N[at + i];
+#define SOA_GET(S, T, N) record.N = soa->N[i];
+#define SOA_SET(S, T, N) soa->N[i] = record.N;
+#define SOA_VISIT(S, T, N) visit(ctx, #N, soa->N, sizeof(T));
+
+#define DEFINE_SOA(NAME, FIELDS) \
+    struct NAME { FIELDS(SOA_MEMBER, NAME) }; \
+    \
+    struct NAME##_soa { \
+        FIELDS(SOA_COLUMN, NAME) \
+        size_t size; \
+        size_t capacity; \
+        char* block; \
+    }; \
+    \
+    /* room for capacity records, false if out of memory */ \
+    static inline bool NAME##_soa_init(struct NAME##_soa* soa, size_t capacity) { \
+        size_t at = 0; \
+        char* block = NULL; \
+        \
+        soa->size = 0; \
+        soa->capacity = 0; \
+        if (true FIELDS(SOA_FITS, NAME)) \
+            /* one spare line, so size is never 0 */ \
+            block = aligned_alloc(SOA_ALIGN, SOA_ALIGN FIELDS(SOA_BYTES, NAME)); \
+        soa->block = block; \
+        if (block == NULL) \
+            return false; \
+        FIELDS(SOA_CARVE, NAME) \
+        (void)at; \
+        soa->capacity = capacity; \
+        return true; \
+    } \
+    \
+    static inline void NAME##_soa_free(struct NAME##_soa* soa) { \
+        free(soa->block); \
+        soa->block = NULL; \
+        soa->size = 0; \
+        soa->capacity = 0; \
+    } \
+    \
+    /* appends count records (at most capacity - size) */ \
+    static inline void NAME##_soa_from_aos( \
+        struct NAME##_soa* soa, struct NAME const* aos, size_t total \
+    ) { \
+        size_t done, i, count, at; \
+        \
+        for( done = 0; done < total; done += count, aos += count ) { \
+            count = total - done < SOA_BLOCK ? total - done : SOA_BLOCK; \
+            at = soa->size + done; \
+            FIELDS(SOA_GATHER, NAME) \
+        } \
+        soa->size += total; \
+    } \
+    \
+    /* all records to aos (room for soa->size of them) */ \
+    static inline void NAME##_soa_to_aos( \
+        struct NAME##_soa const* soa, struct NAME* aos \
+    ) { \
+        size_t i, count, at; \
+        \
+        for( at = 0; at < soa->size; at += count, aos += count ) { \
+            count = soa->size - at < SOA_BLOCK ? soa->size - at : SOA_BLOCK; \
+            FIELDS(SOA_SCATTER, NAME) \
+        } \
+    } \
+    \
+    static inline struct NAME NAME##_soa_get(struct NAME##_soa const* soa, size_t i) { \
+        struct NAME record; \
+        \
+        FIELDS(SOA_GET, NAME) \
+        return record; \
+    } \
+    \
+    static inline void NAME##_soa_set( \
+        struct NAME##_soa* soa, size_t i, struct NAME record \
+    ) { \
+        FIELDS(SOA_SET, NAME) \
+    } \
+    \
+    /* false when full */ \
+    static inline bool NAME##_soa_push(struct NAME##_soa* soa, struct NAME record) { \
+        if (soa->size == soa->capacity) \
+            return false; \
+        NAME##_soa_set(soa, soa->size++, record); \
+        return true; \
+    } \
+    \
+    static inline void NAME##_soa_for_each_column( \
+        struct NAME##_soa* soa, soa_column_visit* visit, void* ctx \
+    ) { \
+        FIELDS(SOA_VISIT, NAME) \
+    }
+
+#endif /* SOA_H */
@@ -0,0 +1,44 @@
+/*
+ * Growth of the string builder declared in strbuf.h,
+ * appends are inline there.
+ */
+
+#include "strbuf.h"
+#include <stdint.h>
+/* for: SIZE_MAX */
+
+void strbuf_init(struct strbuf* s, struct allocator alloc) {
+    s->heap = NULL;
+    s->size = 0;
+    s->capacity = STRBUF_SMALL - 1;
+    s->alloc = alloc;
+    s->small[0] = '\0';
+}
+
+void strbuf_free(struct strbuf* s) {
+    if (s->heap != NULL)
+        s->alloc.resize(s->alloc.ctx, s->heap, s->capacity + 1, 0, 1);
+    strbuf_init(s, s->alloc);
+}
+
+bool strbuf_reserve(struct strbuf* s, size_t size) {
+    size_t capacity = s->capacity * 2;
+    char* heap;
+
+    if (size <= s->capacity)
+        return true;
+    if (size == SIZE_MAX)
+        return false;
+    if (capacity < size)
+        capacity = size;
+    /* small text moves out once, later resizes may stay in place */
+    heap = s->alloc.resize(s->alloc.ctx, s->heap, s->heap != NULL ? s->capacity + 1 : 0,
+                           capacity + 1, 1);
+    if (heap == NULL)
+        return false;
+    if (s->heap == NULL)
+        memcpy(heap, s->small, s->size + 1);
+    s->heap = heap;
+    s->capacity = capacity;
+    return true;
+}
@@ -0,0 +1,130 @@
+/*
+ * String builder, runtime counterpart of literal concatenation
+ * in string_types (c_synt.c).
+ *
+ * Length is kept, so appends never look for the NUL and
+ * building a string is linear, not quadratic as strcat in a
+ * loop. Strings up to STRBUF_SMALL - 1 chars live inside the
+ * struct (no allocation, e.g. a log line built on stack);
+ * longer ones move to memory of a pluggable allocator
+ * (allocator.h) which grows geometrically (x2), so over an
+ * arena (arena_allocator) the string grows in place.
+ *
+ * Numbers are formatted by fmt.h, with no format string, into
+ * a stack buffer and appended, so a number needs room for its
+ * own length only.
+ *
+ * Text is always NUL-terminated. Functions returning bool
+ * give false when out of memory, string is then unchanged.
+ */
+#ifndef STRBUF_H
+#define STRBUF_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include <string.h>
+/* for: memcpy, strlen */
+#include "allocator.h"
+/* for: struct allocator */
+#include "fmt.h"
+/* for: fmt_int ... fmt_double, fmt_g, FMT_BUFFER_SIZE */
+
+/* inline storage, fits a typical log line, struct is then 192 bytes */
+#define STRBUF_SMALL 152
+
+struct strbuf {
+    char* heap;                 /* NULL while text is in small */
+    size_t size;                /* length, without NUL */
+    size_t capacity;            /* chars that fit, without NUL */
+    struct allocator alloc;
+    char small[STRBUF_SMALL];
+};
+
+/* Empty string, long text from alloc. */
+void strbuf_init(struct strbuf* s, struct allocator alloc);
+/* Gives memory back, string is empty (and usable) again. */
+void strbuf_free(struct strbuf* s);
+/* Room for size chars in total, false if out of memory. */
+bool strbuf_reserve(struct strbuf* s, size_t size);
+
+/* text, valid until next append */
+static inline char* strbuf_str(struct strbuf* s) {
+    return s->heap != NULL ? s->heap : s->small;
+}
+
+static inline size_t strbuf_length(struct strbuf const* s) {
+    return s->size;
+}
+
+/* Empty, keeps memory for next string. */
+static inline void strbuf_clear(struct strbuf* s) {
+    s->size = 0;
+    strbuf_str(s)[0] = '\0';
+}
+
+static inline bool strbuf_append(struct strbuf* s, char const* chars, size_t n) {
+    char* end;
+
+    if (s->capacity - s->size < n && !strbuf_reserve(s, s->size + n))
+        return false;
+    end = strbuf_str(s) + s->size;
+    memcpy(end, chars, n);
+    end[n] = '\0';
+    s->size += n;
+    return true;
+}
+
+static inline bool strbuf_append_char(struct strbuf* s, char c) {
+    return strbuf_append(s, &c, 1);
+}
+
+static inline bool strbuf_append_str(struct strbuf* s, char const* str) {
+    return strbuf_append(s, str, strlen(str));
+}
+
+/* literal, length known at compile time */
+#define strbuf_append_literal(s, literal) \
+    strbuf_append((s), "" literal, sizeof(literal) - 1)
+
+/* 
+ * Number x formatted by fmt.h into a local buffer, then
+ * appended: only its own length has to fit, so short text
+ * stays in small. One function per type, picked like fmt.
+ */
+#define STRBUF_DEFINE_PRINT(NAME, T) \
+static inline bool strbuf_print_##NAME(struct strbuf* s, T x) {\
+    char number[FMT_BUFFER_SIZE];\
+    return strbuf_append(s, number, fmt_##NAME(number, x));\
+}
+STRBUF_DEFINE_PRINT(int, int)
+STRBUF_DEFINE_PRINT(long, long)
+STRBUF_DEFINE_PRINT(llong, long long)
+STRBUF_DEFINE_PRINT(uint, unsigned)
+STRBUF_DEFINE_PRINT(ulong, unsigned long)
+STRBUF_DEFINE_PRINT(ullong, unsigned long long)
+STRBUF_DEFINE_PRINT(hex, unsigned long long)
+STRBUF_DEFINE_PRINT(double, double)
+#undef STRBUF_DEFINE_PRINT
+
+/* e.g. shortest double; s and x are evaluated once */
+#define strbuf_print(s, x) (_Generic( (x), \
+            int: strbuf_print_int, \
+            long: strbuf_print_long, \
+            long long: strbuf_print_llong, \
+            unsigned: strbuf_print_uint, \
+            unsigned long: strbuf_print_ulong, \
+            unsigned long long: strbuf_print_ullong, \
+            float: strbuf_print_double, \
+            double: strbuf_print_double, \
+            default: strbuf_print_hex)((s), (x)))
+
+/* Like "%.*g". */
+static inline bool strbuf_print_g(struct strbuf* s, double x, int precision) {
+    char number[FMT_BUFFER_SIZE];
+
+    return strbuf_append(s, number, fmt_g(number, x, precision));
+}
+
+#endif /* STRBUF_H */
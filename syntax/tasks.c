@@ -0,0 +1,571 @@
+/*
+ * Scheduler declared in tasks.h.
+ *
+ * Deque operations follow Le, Pop, Cohen, Zappa Nardelli,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (C11 atomics version of Chase-Lev). Indices only grow, slot
+ * of index i is ring->slot[i & mask]. A full ring is copied
+ * to one twice as big, old one stays allocated until
+ * tasks_free because a thief may still read from it.
+ *
+ * A sleeping worker and a spawning thread meet like in Dekker
+ * mutual exclusion: worker counts itself in sleepers, then
+ * looks for work; spawner publishes work, then looks at
+ * sleepers (both with sequentially consistent order), so at
+ * least one of them sees the other. Worker holds the lock
+ * from the look until it waits, so the signal is not lost.
+ * A thread sleeping in task_group_wait meets the last task
+ * of its group the same way, on waiters and pending.
+ */
+
+/* for sysconf */
+#define _POSIX_C_SOURCE 200809L
+
+#include "tasks.h"
+#include <stdlib.h>
+/* for: malloc, free, aligned_alloc */
+#include <time.h>
+/* for: timespec_get */
+#include <unistd.h>
+/* for: sysconf */
+
+/* idle rounds spinning, then yielding, before a thread sleeps */
+#define TASKS_SPINS 64
+#define TASKS_YIELDS 16
+/* sleep is cut this long, in case a wakeup is missed after all */
+#define TASKS_SLEEP_NS 10000000
+
+struct task {
+    void (*run)(struct task* task);
+    task_fn* fn;
+    void* arg;
+    struct task_group* group;
+    size_t begin, end;              /* range of parallel_for */
+    struct task* next;              /* free or submitted list */
+};
+
+struct task_ring {
+    int64_t mask;
+    struct task_ring* next;         /* retired list */
+    _Atomic(struct task*) slot[];
+};
+
+/* worker running on this thread, NULL for other threads */
+static _Thread_local struct task_worker* current;
+/* victim selection (xorshift), seeded per thread */
+static _Thread_local uint64_t random_state;
+
+static void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+static unsigned next_random(unsigned bound) {
+    uint64_t x = random_state;
+
+    if (x == 0)
+        x = (uint64_t)(uintptr_t)&random_state | 1;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    random_state = x;
+    return (unsigned)(x % bound);
+}
+
+
+static struct task_ring* ring_new(int64_t size) {
+    struct task_ring* ring = malloc(sizeof(*ring) + (size_t)size * sizeof(ring->slot[0]));
+
+    if (ring != NULL) {
+        ring->mask = size - 1;
+        ring->next = NULL;
+    }
+    return ring;
+}
+
+static struct task_ring* deque_grow(
+    struct task_deque* deque, struct task_ring* old, int64_t top, int64_t bottom
+) {
+    struct task_ring* ring = ring_new(2 * (old->mask + 1));
+    int64_t i;
+
+    if (ring == NULL)
+        return NULL;
+    for( i = top; i < bottom; i++ )
+        atomic_store_explicit(&ring->slot[i & ring->mask],
+            atomic_load_explicit(&old->slot[i & old->mask], memory_order_relaxed),
+            memory_order_relaxed);
+    old->next = deque->retired;
+    deque->retired = old;
+    atomic_store_explicit(&deque->ring, ring, memory_order_release);
+    return ring;
+}
+
+/*
+ * Owner only, 0 when ring could not grow, else number of
+ * tasks in deque including the new one (as seen by owner).
+ */
+static int64_t deque_push(struct task_deque* deque, struct task* task) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    struct task_ring* ring = atomic_load_explicit(&deque->ring, memory_order_relaxed);
+
+    if (bottom - top > ring->mask) {
+        ring = deque_grow(deque, ring, top, bottom);
+        if (ring == NULL)
+            return 0;
+    }
+    atomic_store_explicit(&ring->slot[bottom & ring->mask], task, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return bottom + 1 - top;
+}
+
+/* owner only, newest task or NULL */
+static struct task* deque_take(struct task_deque* deque) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    struct task_ring* ring = atomic_load_explicit(&deque->ring, memory_order_relaxed);
+    struct task* task = NULL;
+    int64_t top;
+
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (top <= bottom) {
+        task = atomic_load_explicit(&ring->slot[bottom & ring->mask], memory_order_relaxed);
+        if (top == bottom) {
+            /* last one, race thieves for it */
+            if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                    memory_order_seq_cst, memory_order_relaxed))
+                task = NULL;
+            atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        }
+    } else
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return task;
+}
+
+/* any thread, oldest task, or NULL when empty or race was lost */
+static struct task* deque_steal(struct task_deque* deque) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    int64_t bottom;
+    struct task_ring* ring;
+    struct task* task;
+
+    atomic_thread_fence(memory_order_seq_cst);
+    bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom)
+        return NULL;
+    ring = atomic_load_explicit(&deque->ring, memory_order_acquire);
+    task = atomic_load_explicit(&ring->slot[top & ring->mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+            memory_order_seq_cst, memory_order_relaxed))
+        return NULL;
+    return task;
+}
+
+static bool deque_empty(struct task_deque* deque) {
+    return atomic_load_explicit(&deque->top, memory_order_relaxed)
+        >= atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+}
+
+
+/* worker of tasks running this thread, if any */
+static struct task_worker* worker_of(struct tasks* tasks) {
+    return current != NULL && current->tasks == tasks ? current : NULL;
+}
+
+static struct task* task_new(void) {
+    struct task* task = current != NULL ? current->free : NULL;
+
+    if (task == NULL)
+        return malloc(sizeof(*task));
+    current->free = task->next;
+    return task;
+}
+
+/* any worker can reuse a task, whichever scheduler made it */
+static void task_release(struct task* task) {
+    if (current == NULL) {
+        free(task);
+        return;
+    }
+    task->next = current->free;
+    current->free = task;
+}
+
+static void task_run(struct task* task) {
+    struct task_group* group = task->group;
+    struct tasks* tasks = group->tasks;
+
+    task->run(task);
+    task_release(task);
+    /* group may be gone once pending is 0, only tasks is used after */
+    if (atomic_fetch_sub(&group->pending, 1) == 1
+            && atomic_load(&tasks->waiters) > 0) {
+        mtx_lock(&tasks->lock);
+        cnd_broadcast(&tasks->wake);
+        mtx_unlock(&tasks->lock);
+    }
+}
+
+static void wake_one(struct tasks* tasks) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&tasks->sleepers, memory_order_relaxed) == 0)
+        return;
+    mtx_lock(&tasks->lock);
+    cnd_signal(&tasks->wake);
+    mtx_unlock(&tasks->lock);
+}
+
+static void submit(struct tasks* tasks, struct task* task) {
+    task->next = NULL;
+    mtx_lock(&tasks->lock);
+    if (tasks->submitted_last != NULL)
+        tasks->submitted_last->next = task;
+    else
+        tasks->submitted = task;
+    tasks->submitted_last = task;
+    atomic_fetch_add(&tasks->submitted_count, 1);
+    if (atomic_load_explicit(&tasks->sleepers, memory_order_relaxed) > 0)
+        cnd_signal(&tasks->wake);
+    mtx_unlock(&tasks->lock);
+}
+
+static struct task* take_submitted(struct tasks* tasks) {
+    struct task* task;
+
+    if (atomic_load_explicit(&tasks->submitted_count, memory_order_relaxed) == 0)
+        return NULL;
+    mtx_lock(&tasks->lock);
+    task = tasks->submitted;
+    if (task != NULL) {
+        tasks->submitted = task->next;
+        if (tasks->submitted == NULL)
+            tasks->submitted_last = NULL;
+        atomic_fetch_sub(&tasks->submitted_count, 1);
+    }
+    mtx_unlock(&tasks->lock);
+    return task;
+}
+
+/* own newest task, else oldest submitted one, else a stolen one */
+static struct task* find_work(struct tasks* tasks, struct task_worker* self) {
+    struct task* task;
+    unsigned i, first;
+
+    if (self != NULL && (task = deque_take(&self->deque)) != NULL)
+        return task;
+    if ((task = take_submitted(tasks)) != NULL)
+        return task;
+    first = next_random(tasks->count);
+    for( i = 0; i < tasks->count; i++ ) {
+        struct task_worker* victim = &tasks->workers[(first + i) % tasks->count];
+
+        if (victim != self && (task = deque_steal(&victim->deque)) != NULL) {
+            /* more to steal there, let next sleeper help too */
+            if (!deque_empty(&victim->deque))
+                wake_one(tasks);
+            return task;
+        }
+    }
+    return NULL;
+}
+
+static bool has_work(struct tasks* tasks) {
+    unsigned i;
+
+    if (atomic_load(&tasks->submitted_count) > 0)
+        return true;
+    for( i = 0; i < tasks->count; i++ )
+        if (!deque_empty(&tasks->workers[i].deque))
+            return true;
+    return false;
+}
+
+/* waits on wake, called with lock held, cut after TASKS_SLEEP_NS */
+static void sleep_locked(struct tasks* tasks) {
+    struct timespec until;
+
+    timespec_get(&until, TIME_UTC);
+    until.tv_nsec += TASKS_SLEEP_NS;
+    if (until.tv_nsec >= 1000000000) {
+        until.tv_sec++;
+        until.tv_nsec -= 1000000000;
+    }
+    cnd_timedwait(&tasks->wake, &tasks->lock, &until);
+}
+
+static void sleep_until_work(struct tasks* tasks) {
+    mtx_lock(&tasks->lock);
+    atomic_fetch_add(&tasks->sleepers, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (!has_work(tasks) && !atomic_load(&tasks->stop))
+        sleep_locked(tasks);
+    atomic_fetch_sub(&tasks->sleepers, 1);
+    mtx_unlock(&tasks->lock);
+}
+
+/* also woken by the last task of group */
+static void sleep_until_done(struct tasks* tasks, struct task_group* group) {
+    mtx_lock(&tasks->lock);
+    atomic_fetch_add(&tasks->sleepers, 1);
+    atomic_fetch_add(&tasks->waiters, 1);
+    if (atomic_load(&group->pending) != 0 && !has_work(tasks))
+        sleep_locked(tasks);
+    atomic_fetch_sub(&tasks->waiters, 1);
+    atomic_fetch_sub(&tasks->sleepers, 1);
+    mtx_unlock(&tasks->lock);
+}
+
+static int worker_main(void* arg) {
+    struct task_worker* self = arg;
+    struct tasks* tasks = self->tasks;
+    unsigned idle = 0;
+
+    current = self;
+    random_state = (uint64_t)(self - tasks->workers) * 0x9e3779b97f4a7c15u + 1;
+    while (!atomic_load_explicit(&tasks->stop, memory_order_relaxed)) {
+        struct task* task = find_work(tasks, self);
+
+        if (task != NULL) {
+            task_run(task);
+            idle = 0;
+        } else if (++idle < TASKS_SPINS)
+            cpu_relax();
+        else if (idle < TASKS_SPINS + TASKS_YIELDS)
+            thrd_yield();
+        else {
+            sleep_until_work(tasks);
+            idle = 0;
+        }
+    }
+    return 0;
+}
+
+
+static void free_workers(struct tasks* tasks) {
+    unsigned i;
+
+    for( i = 0; i < tasks->count; i++ ) {
+        struct task_worker* worker = &tasks->workers[i];
+        struct task_ring* ring = atomic_load(&worker->deque.ring);
+
+        free(ring);
+        for( ring = worker->deque.retired; ring != NULL; ) {
+            struct task_ring* next = ring->next;
+
+            free(ring);
+            ring = next;
+        }
+        while (worker->free != NULL) {
+            struct task* next = worker->free->next;
+
+            free(worker->free);
+            worker->free = next;
+        }
+    }
+    free(tasks->workers);
+    mtx_destroy(&tasks->lock);
+    cnd_destroy(&tasks->wake);
+}
+
+int tasks_init(struct tasks* tasks, unsigned count) {
+    unsigned i, started = 0;
+
+    if (count == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        count = online > 0 ? (unsigned)online : 1;
+    }
+    tasks->workers = aligned_alloc(TASKS_CACHE_LINE, count * sizeof(*tasks->workers));
+    if (tasks->workers == NULL)
+        return -1;
+    if (mtx_init(&tasks->lock, mtx_plain) != thrd_success) {
+        free(tasks->workers);
+        return -1;
+    }
+    if (cnd_init(&tasks->wake) != thrd_success) {
+        mtx_destroy(&tasks->lock);
+        free(tasks->workers);
+        return -1;
+    }
+    tasks->count = count;
+    atomic_init(&tasks->stop, false);
+    tasks->submitted = NULL;
+    tasks->submitted_last = NULL;
+    atomic_init(&tasks->submitted_count, 0);
+    atomic_init(&tasks->sleepers, 0);
+    atomic_init(&tasks->waiters, 0);
+
+    for( i = 0; i < count; i++ ) {
+        struct task_worker* worker = &tasks->workers[i];
+        struct task_ring* ring = ring_new(TASKS_DEQUE_SIZE);
+
+        atomic_init(&worker->deque.top, 0);
+        atomic_init(&worker->deque.bottom, 0);
+        atomic_init(&worker->deque.ring, ring);
+        worker->deque.retired = NULL;
+        worker->tasks = tasks;
+        worker->free = NULL;
+        worker->started = false;
+        if (ring == NULL) {
+            tasks->count = i + 1;
+            free_workers(tasks);
+            return -1;
+        }
+    }
+    /* a worker which did not start only has an empty deque */
+    for( i = 0; i < count; i++ ) {
+        struct task_worker* worker = &tasks->workers[i];
+
+        worker->started = thrd_create(&worker->thread, worker_main, worker) == thrd_success;
+        started += worker->started;
+    }
+    if (started == 0) {
+        free_workers(tasks);
+        return -1;
+    }
+    return 0;
+}
+
+void tasks_free(struct tasks* tasks) {
+    unsigned i;
+
+    atomic_store(&tasks->stop, true);
+    mtx_lock(&tasks->lock);
+    cnd_broadcast(&tasks->wake);
+    mtx_unlock(&tasks->lock);
+    for( i = 0; i < tasks->count; i++ )
+        if (tasks->workers[i].started)
+            thrd_join(tasks->workers[i].thread, NULL);
+    free_workers(tasks);
+}
+
+
+static int spawn(
+    struct task_group* group, void (*run)(struct task*),
+    task_fn* fn, void* arg, size_t begin, size_t end
+) {
+    struct tasks* tasks = group->tasks;
+    struct task_worker* self = worker_of(tasks);
+    struct task* task = task_new();
+    int64_t queued;
+
+    if (task == NULL) {
+        struct task inline_task;
+
+        inline_task.fn = fn;
+        inline_task.arg = arg;
+        inline_task.begin = begin;
+        inline_task.end = end;
+        run(&inline_task);
+        return -1;
+    }
+    task->run = run;
+    task->fn = fn;
+    task->arg = arg;
+    task->group = group;
+    task->begin = begin;
+    task->end = end;
+    atomic_fetch_add_explicit(&group->pending, 1, memory_order_relaxed);
+    if (self == NULL) {
+        submit(tasks, task);
+        return 0;
+    }
+    queued = deque_push(&self->deque, task);
+    if (queued == 0) {
+        task_run(task);
+        return -1;
+    }
+    /*
+     * Only first task wakes a sleeper, woken thief wakes next
+     * one if there is more (a signal per spawn costs a syscall).
+     */
+    if (queued == 1)
+        wake_one(tasks);
+    return 0;
+}
+
+static void run_fn(struct task* task) {
+    task->fn(task->arg);
+}
+
+int task_spawn(struct task_group* group, task_fn* fn, void* arg) {
+    return spawn(group, run_fn, fn, arg, 0, 0);
+}
+
+void task_group_wait(struct task_group* group) {
+    struct tasks* tasks = group->tasks;
+    struct task_worker* self = worker_of(tasks);
+    unsigned idle = 0;
+
+    /* what is left runs on other threads, yield to them, then sleep */
+    while (atomic_load_explicit(&group->pending, memory_order_acquire) != 0) {
+        struct task* task = find_work(tasks, self);
+
+        if (task != NULL) {
+            task_run(task);
+            idle = 0;
+        } else if (++idle < TASKS_SPINS)
+            cpu_relax();
+        else if (idle < TASKS_SPINS + TASKS_YIELDS)
+            thrd_yield();
+        else {
+            sleep_until_done(tasks, group);
+            idle = 0;
+        }
+    }
+}
+
+
+struct range_job {
+    task_range_fn* body;
+    void* ctx;
+    size_t grain;
+    struct task_group* group;
+};
+
+/* gives away upper halves until range fits grain */
+static void run_range(struct task* task) {
+    struct range_job* job = task->arg;
+    size_t begin = task->begin, end = task->end;
+
+    while (end - begin > job->grain) {
+        size_t middle = begin + (end - begin) / 2;
+
+        spawn(job->group, run_range, NULL, job, middle, end);
+        end = middle;
+    }
+    job->body(job->ctx, begin, end);
+}
+
+void parallel_for(
+    struct tasks* tasks, size_t begin, size_t end, size_t grain,
+    task_range_fn* body, void* ctx
+) {
+    struct task_group group;
+    struct range_job job;
+    struct task root;
+
+    if (end <= begin)
+        return;
+    if (grain == 0)
+        grain = (end - begin) / ((size_t)tasks->count * TASKS_CHUNKS_PER_WORKER);
+    if (grain == 0)
+        grain = 1;
+    if (end - begin <= grain) {
+        body(ctx, begin, end);
+        return;
+    }
+    task_group_init(&group, tasks);
+    job.body = body;
+    job.ctx = ctx;
+    job.grain = grain;
+    job.group = &group;
+    root.arg = &job;
+    root.begin = begin;
+    root.end = end;
+    run_range(&root);
+    task_group_wait(&group);
+}
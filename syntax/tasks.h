@@ -0,0 +1,132 @@
+/*
+ * Work-stealing task scheduler on C11 <threads.h> and
+ * <stdatomic.h>.
+ *
+ * Every worker thread owns a Chase-Lev deque: it pushes and
+ * takes its own tasks at the bottom (no locks, newest first,
+ * so the working set stays in cache) and idle workers steal
+ * the oldest task from the top of a random victim with one
+ * compare-and-swap. Threads which are not workers (e.g. main)
+ * submit into a shared queue under lock.
+ *
+ * Fork/join: tasks are spawned into a struct task_group and
+ * task_group_wait returns when all of them finished. The
+ * waiting thread runs tasks meanwhile (own, submitted or
+ * stolen ones), so tasks can spawn and wait on nested groups
+ * without blocking workers.
+ *
+ * Idle workers spin a little, then yield, then sleep on a
+ * condition variable until new work is spawned, so an idle
+ * scheduler does not burn cores. A thread waiting on a group
+ * with nothing to run sleeps the same way, until work comes
+ * or the last task of the group finishes.
+ *
+ *   struct tasks tasks;
+ *   struct task_group group;
+ *
+ *   tasks_init(&tasks, 0);              one worker per CPU
+ *   task_group_init(&group, &tasks);
+ *   task_spawn(&group, work, arg);      work(arg) somewhere
+ *   task_group_wait(&group);
+ *   parallel_for(&tasks, 0, n, 0, body, ctx);
+ *   tasks_free(&tasks);
+ *
+ * Library: > make tasks   (bin/libtasks.a, link with -pthread)
+ */
+#ifndef TASKS_H
+#define TASKS_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include <stdint.h>
+/* for: int64_t */
+#include <stdatomic.h>
+/* for: atomic_size_t, _Atomic */
+#include <threads.h>
+/* for: thrd_t, mtx_t, cnd_t */
+
+#define TASKS_CACHE_LINE 64
+/* first capacity of a deque, doubled when full */
+#define TASKS_DEQUE_SIZE 256
+/* parallel_for with automatic grain makes this many chunks per worker */
+#define TASKS_CHUNKS_PER_WORKER 8
+
+typedef void (task_fn)(void* arg);
+/* body of parallel_for, runs indices [begin, end) */
+typedef void (task_range_fn)(void* ctx, size_t begin, size_t end);
+
+struct task;
+struct task_ring;
+
+/* Chase-Lev deque, top and bottom on own cache lines */
+struct task_deque {
+    _Alignas(TASKS_CACHE_LINE) _Atomic(int64_t) top;
+    _Alignas(TASKS_CACHE_LINE) _Atomic(int64_t) bottom;
+    _Atomic(struct task_ring*) ring;
+    struct task_ring* retired;      /* smaller rings thieves may read */
+};
+
+struct task_worker {
+    struct task_deque deque;
+    struct tasks* tasks;
+    struct task* free;              /* finished tasks, for reuse */
+    thrd_t thread;
+    bool started;
+};
+
+struct tasks {
+    struct task_worker* workers;
+    unsigned count;
+    atomic_bool stop;
+    /* submissions of other threads, FIFO */
+    mtx_t lock;
+    struct task* submitted;
+    struct task* submitted_last;
+    atomic_size_t submitted_count;
+    /* sleeping workers wait on wake, guarded by lock */
+    cnd_t wake;
+    atomic_uint sleepers;
+    /* those of sleepers waiting on a group, woken when it is done */
+    atomic_uint waiters;
+};
+
+struct task_group {
+    struct tasks* tasks;
+    atomic_size_t pending;
+};
+
+/*
+ * Starts count workers (0 -> one per online CPU). 0, or -1
+ * when out of memory or no thread could start.
+ */
+int tasks_init(struct tasks* tasks, unsigned count);
+/* Stops and joins workers, all groups must be waited for. */
+void tasks_free(struct tasks* tasks);
+
+static inline void task_group_init(struct task_group* group, struct tasks* tasks) {
+    group->tasks = tasks;
+    atomic_init(&group->pending, 0);
+}
+
+/*
+ * Runs fn(arg) on some thread before task_group_wait of group
+ * returns. 0, or -1 when out of memory (fn was run inline).
+ */
+int task_spawn(struct task_group* group, task_fn* fn, void* arg);
+/* Runs tasks until every task of group finished. */
+void task_group_wait(struct task_group* group);
+
+/*
+ * body(ctx, b, e) over ranges covering [begin, end), at most
+ * grain indices each (0 -> automatic: TASKS_CHUNKS_PER_WORKER
+ * ranges per worker). Ranges are split in halves on demand,
+ * so idle workers steal big halves first. Returns when all
+ * ranges are done.
+ */
+void parallel_for(
+    struct tasks* tasks, size_t begin, size_t end, size_t grain,
+    task_range_fn* body, void* ctx);
+
+#endif /* TASKS_H */
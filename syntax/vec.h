@@ -0,0 +1,121 @@
+/* 
+ * Growable typed arrays, generated like DEFINE_PAIR of
+ * polymorphisms.c:
+ * DEFINE_VEC(T) defines struct vec(T) and its functions
+ * vec_T_init, vec_T_free, vec_T_reserve, vec_T_push,
+ * vec_T_append, vec_T_shrink and vec_T_filter.
+ *
+ * T must be one identifier (use typedef for pointers etc.).
+ * Memory comes from a pluggable allocator (allocator.h), e.g.
+ * allocator_malloc or arena_allocator. Capacity grows
+ * geometrically (x2), through allocator resize, so realloc
+ * and arenas can extend block in place instead of copying.
+ * Functions are static inline, push fast path is one compare
+ * and one store, and a filter predicate known at compile time
+ * is inlined.
+ */
+#ifndef VEC_H
+#define VEC_H
+
+#include <stddef.h>
+/* for: size_t */
+#include <stdbool.h>
+/* for: bool */
+#include <string.h>
+/* for: memcpy */
+#include <stdalign.h>
+/* for: alignof */
+#include "allocator.h"
+/* for: struct allocator */
+
+/* first allocation holds at least this many bytes */
+#define VEC_MIN_BYTES 64
+
+#define vec(T) vec_##T
+/* e.g. T = int -> vec_int */
+#define DEFINE_VEC(T) struct vec(T) {\
+    T* data;\
+    size_t size;\
+    size_t capacity;\
+    struct allocator alloc;\
+};\
+static inline void vec_##T##_init(struct vec(T)* v, struct allocator alloc) {\
+    v->data = NULL;\
+    v->size = 0;\
+    v->capacity = 0;\
+    v->alloc = alloc;\
+}\
+static inline void vec_##T##_free(struct vec(T)* v) {\
+    if (v->data != NULL)\
+        v->alloc.resize(v->alloc.ctx, v->data, v->capacity * sizeof(T), 0,\
+                        alignof(T));\
+    v->data = NULL;\
+    v->size = v->capacity = 0;\
+}\
+/* sets capacity to exactly n (n >= size), false if out of memory */\
+static inline bool vec_##T##_resize_capacity(struct vec(T)* v, size_t n) {\
+    T* data;\
+    if (n > (size_t)-1 / sizeof(T))\
+        return false;\
+    data = v->alloc.resize(v->alloc.ctx, v->data, v->capacity * sizeof(T),\
+                           n * sizeof(T), alignof(T));\
+    if (data == NULL && n != 0)\
+        return false;\
+    v->data = data;\
+    v->capacity = n;\
+    return true;\
+}\
+/* capacity for at least n elements, grows geometrically */\
+static inline bool vec_##T##_reserve(struct vec(T)* v, size_t n) {\
+    size_t capacity = v->capacity * 2;\
+    if (n <= v->capacity)\
+        return true;\
+    if (capacity < VEC_MIN_BYTES / sizeof(T))\
+        capacity = VEC_MIN_BYTES / sizeof(T);\
+    if (capacity < n)\
+        capacity = n;\
+    return vec_##T##_resize_capacity(v, capacity);\
+}\
+static inline bool vec_##T##_push(struct vec(T)* v, T x) {\
+    if (v->size == v->capacity && !vec_##T##_reserve(v, v->size + 1))\
+        return false;\
+    v->data[v->size++] = x;\
+    return true;\
+}\
+/* bulk append, one reserve and one memcpy */\
+static inline bool vec_##T##_append(struct vec(T)* v, T const* xs, size_t n) {\
+    if (n > (size_t)-1 - v->size || !vec_##T##_reserve(v, v->size + n))\
+        return false;\
+    if (n != 0)\
+        memcpy(v->data + v->size, xs, n * sizeof(T));\
+    v->size += n;\
+    return true;\
+}\
+/* gives back unused capacity */\
+static inline bool vec_##T##_shrink(struct vec(T)* v) {\
+    return v->size == v->capacity || vec_##T##_resize_capacity(v, v->size);\
+}\
+/* keeps elements with keep(&x, ctx) true, in order; returns new size */\
+static inline size_t vec_##T##_filter(\
+    struct vec(T)* v, bool (*keep)(T const*, void*), void* ctx\
+) {\
+    size_t i, kept = 0;\
+    for( i = 0; i < v->size; i++ )\
+        if (keep(&v->data[i], ctx))\
+            v->data[kept++] = v->data[i];\
+    v->size = kept;\
+    return kept;\
+}
+/* 
+ * For T = int ->:
+ * struct vec_int {
+ *      int* data;
+ *      size_t size;
+ *      size_t capacity;
+ *      struct allocator alloc;
+ * };
+ * static inline bool vec_int_push(struct vec_int* v, int x) { ... }
+ * ...
+ */
+
+#endif /* VEC_H */